@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+
+// Every operator new in the process goes through here, so a workload's
+// allocation count is the difference of the counter around it.
+namespace
+{
+  size_t g_allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+  ++g_allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+  using Boron::byte;
+  using Vector = std::vector<byte>;
+
+  constexpr int kIterations = 1000;
+  constexpr byte kKey[] = {'k', 'e', 'y', '1'};
+  const std::string kRecord = "id,name,host,port,path,ua,ref,ts,ms,code,len,ip,tls,alpn,sni,user";
+  const std::string kDigest = "0123456789ABCDEF0123456789ABCDEF";
+
+  template <typename Func>
+  double allocationsPerIteration(Func func)
+  {
+    const auto before = g_allocations;
+    for (auto i = 0; i < kIterations; i++)
+      func();
+    return static_cast<double>(g_allocations - before) / kIterations;
+  }
+
+  template <typename VectorWorkload, typename ByteArrayWorkload>
+  void report(const char* name, VectorWorkload vector_workload, ByteArrayWorkload byte_array_workload)
+  {
+    const auto before = allocationsPerIteration(vector_workload);
+    const auto after = allocationsPerIteration(byte_array_workload);
+    std::printf("%-28s %14.2f %14.2f\n", name, before, after);
+  }
+} // namespace
+
+int main()
+{
+  std::printf("%-28s %14s %14s\n", "allocations per iteration", "vector<byte>", "ByteArray");
+
+  report("construct 4-byte key", []
+  {
+    const Vector v(kKey, kKey + sizeof(kKey));
+    (void)v;
+  }, []
+  {
+    const Boron::ByteArray ba(kKey, sizeof(kKey));
+    (void)ba;
+  });
+
+  report("copy 4-byte key", []
+  {
+    static const Vector source(kKey, kKey + sizeof(kKey));
+    const auto copy = source;
+    (void)copy;
+  }, []
+  {
+    static const Boron::ByteArray source(kKey, sizeof(kKey));
+    const auto copy = source;
+    (void)copy;
+  });
+
+  report("append 20 bytes", []
+  {
+    Vector v;
+    for (auto i = 0; i < 20; i++)
+      v.push_back(static_cast<byte>(i));
+  }, []
+  {
+    Boron::ByteArray ba;
+    for (auto i = 0; i < 20; i++)
+      ba.append(static_cast<byte>(i));
+  });
+
+  report("split 16-field record", []
+  {
+    static const Vector record(kRecord.begin(), kRecord.end());
+    std::vector<Vector> fields;
+    auto last = record.begin();
+    for (auto it = record.begin(); it != record.end(); ++it)
+    {
+      if (*it == ',')
+      {
+        fields.emplace_back(last, it);
+        last = it + 1;
+      }
+    }
+    fields.emplace_back(last, record.end());
+  }, []
+  {
+    static const auto record = Boron::ByteArray::fromStdString(kRecord);
+    const auto fields = record.split(',');
+    (void)fields;
+  });
+
+  report("fromHex 16-byte digest", []
+  {
+    Vector v;
+    v.reserve(kDigest.size() / 2);
+    for (size_t i = 0; i < kDigest.size(); i += 2)
+      v.push_back(static_cast<byte>(std::stoi(kDigest.substr(i, 2), nullptr, 16)));
+  }, []
+  {
+    const auto ba = Boron::ByteArray::fromHex(kDigest);
+    (void)ba;
+  });
+
+  return 0;
+}
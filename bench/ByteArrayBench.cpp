@@ -0,0 +1,627 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Compression.hpp"
+#include "Boron/String.hpp"
+#include "Boron/Unicode.hpp"
+#include "Boron/Varint.hpp"
+
+// Throughput of the ByteArray hot paths. Every benchmark reports the bytes it
+// scans or produces per iteration, so results read as bytes/second and stay
+// comparable across haystack sizes.
+//
+// Haystacks are random lowercase text with a fixed seed. Match density is
+// given in matches per 64 KiB and placed at evenly spaced offsets, so runs are
+// reproducible and do not depend on the random contents.
+namespace
+{
+  using Boron::byte;
+  using Boron::ByteArray;
+  using Boron::ByteArrayView;
+
+  constexpr int64_t kKiB = 1024;
+  constexpr int64_t kMiB = 1024 * kKiB;
+
+  ByteArray randomText(size_t size, uint32_t seed = 42)
+  {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    ByteArray result;
+    result.resize_and_overwrite(size, [&](uint8_t* out, size_t n) {
+      for (size_t i = 0; i < n; i++)
+        out[i] = static_cast<uint8_t>(letter(rng));
+      return n;
+    });
+    return result;
+  }
+
+  // A needle of the given size made of bytes that never occur in randomText().
+  ByteArray needleOf(size_t size)
+  {
+    ByteArray result;
+    for (size_t i = 0; i < size; i++)
+      result.append(static_cast<uint8_t>('A' + i % 26));
+    return result;
+  }
+
+  // Plants needle in haystack about density times per 64 KiB.
+  void plant(ByteArray& haystack, ByteArrayView needle, int64_t density)
+  {
+    if (density == 0 || needle.size() > haystack.size())
+      return;
+    const auto stride = std::max<size_t>(needle.size(), 64 * kKiB / density);
+    for (size_t pos = stride / 2; pos + needle.size() <= haystack.size(); pos += stride)
+      std::memcpy(haystack.data() + pos, needle.data(), needle.size());
+  }
+
+  void setBytes(benchmark::State& state, size_t bytes)
+  {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  }
+
+  // Args: haystack size, needle size, matches per 64 KiB.
+  void BM_IndexOf(benchmark::State& state)
+  {
+    auto haystack = randomText(state.range(0));
+    const auto needle = needleOf(state.range(1));
+    plant(haystack, needle, state.range(2));
+    for (auto _ : state)
+    {
+      size_t found = 0;
+      for (auto pos = haystack.indexOf(needle); pos != ByteArray::kNpos; pos = haystack.indexOf(needle, pos + 1))
+        ++found;
+      benchmark::DoNotOptimize(found);
+    }
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_IndexOf)->ArgsProduct({{4 * kKiB, kMiB}, {2, 8, 32, 128}, {0, 16, 1024}});
+
+  // Args: haystack size, matches per 64 KiB.
+  void BM_IndexOfByte(benchmark::State& state)
+  {
+    auto haystack = randomText(state.range(0));
+    plant(haystack, needleOf(1), state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(haystack.indexOf('A'));
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_IndexOfByte)->ArgsProduct({{64, 4 * kKiB, kMiB}, {0, 1024}});
+
+  // Args: haystack size, needle size. Folded, the upper case needle is made
+  // of letters the text is made of, so about one position in 676 passes the
+  // first and last byte filter and has its middle compared.
+  void BM_IndexOfCaseInsensitive(benchmark::State& state)
+  {
+    const auto haystack = randomText(state.range(0));
+    const auto needle = needleOf(state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(haystack.indexOf(needle, 0, Boron::CaseSensitivity::CaseInsensitive));
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_IndexOfCaseInsensitive)->ArgsProduct({{4 * kKiB, kMiB}, {8, 32}});
+
+  // Args: size. The rvalue converts in place once the first iteration has
+  // given the array a buffer of its own.
+  void BM_ToUpper(benchmark::State& state)
+  {
+    auto ba = randomText(state.range(0));
+    for (auto _ : state)
+    {
+      ba = std::move(ba).toUpper();
+      ba = std::move(ba).toLower();
+      benchmark::DoNotOptimize(ba.constData());
+    }
+    setBytes(state, 2 * ba.size());
+  }
+  BENCHMARK(BM_ToUpper)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Args: size, bytes per word. Words of random text separated by runs of
+  // two spaces, so every run shrinks.
+  void BM_Simplified(benchmark::State& state)
+  {
+    auto text = randomText(state.range(0));
+    const auto word = static_cast<size_t>(state.range(1));
+    for (size_t pos = word; pos + 2 <= text.size(); pos += word + 2)
+      text[pos] = text[pos + 1] = ' ';
+    for (auto _ : state)
+      benchmark::DoNotOptimize(text.simplified().constData());
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Simplified)->ArgsProduct({{4 * kKiB, kMiB}, {6, 64}});
+
+  // Args: haystack size, needle size, matches per 64 KiB.
+  void BM_Count(benchmark::State& state)
+  {
+    auto haystack = randomText(state.range(0));
+    const auto needle = needleOf(state.range(1));
+    plant(haystack, needle, state.range(2));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(haystack.count(needle));
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_Count)->ArgsProduct({{4 * kKiB, kMiB}, {1, 4, 16}, {16, 4096}});
+
+  // Args: haystack size, fields per 64 KiB.
+  void BM_Split(benchmark::State& state)
+  {
+    auto haystack = randomText(state.range(0));
+    plant(haystack, needleOf(1), state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(haystack.split('A'));
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_Split)->ArgsProduct({{4 * kKiB, kMiB}, {64, 4096}});
+
+  // Args: haystack size, fields per 64 KiB.
+  void BM_SplitView(benchmark::State& state)
+  {
+    auto haystack = randomText(state.range(0));
+    plant(haystack, needleOf(1), state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(haystack.splitView('A'));
+    setBytes(state, haystack.size());
+  }
+  BENCHMARK(BM_SplitView)->ArgsProduct({{4 * kKiB, kMiB}, {64, 4096}});
+
+  // Args: input size.
+  void BM_ToHex(benchmark::State& state)
+  {
+    const auto data = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(data.toHex());
+    setBytes(state, data.size());
+  }
+  BENCHMARK(BM_ToHex)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Args: decoded size.
+  void BM_FromHex(benchmark::State& state)
+  {
+    const auto hex = randomText(state.range(0)).toHex();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(ByteArray::fromHex(hex));
+    setBytes(state, hex.size());
+  }
+  BENCHMARK(BM_FromHex)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  void BM_ToBase64(benchmark::State& state)
+  {
+    const auto data = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(data.toBase64());
+    setBytes(state, data.size());
+  }
+  BENCHMARK(BM_ToBase64)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Args: decoded size.
+  void BM_FromBase64(benchmark::State& state)
+  {
+    const auto base64 = randomText(state.range(0)).toBase64();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(ByteArray::fromBase64(base64));
+    setBytes(state, base64.size());
+  }
+  BENCHMARK(BM_FromBase64)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Random text with a byte to escape every spacing bytes.
+  ByteArray urlText(size_t size, size_t spacing)
+  {
+    auto text = randomText(size);
+    for (size_t i = spacing - 1; i < size; i += spacing)
+      text[i] = ' ';
+    return text;
+  }
+
+  // Args: array size, distance between escaped bytes.
+  void BM_ToPercentEncoding(benchmark::State& state)
+  {
+    const auto data = urlText(state.range(0), state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(data.toPercentEncoding());
+    setBytes(state, data.size());
+  }
+  BENCHMARK(BM_ToPercentEncoding)->ArgsProduct({{64, 4 * kKiB, kMiB}, {8, 64}});
+
+  // Args: decoded size, distance between escaped bytes.
+  void BM_PercentDecoded(benchmark::State& state)
+  {
+    const auto encoded = ByteArray::fromStdString(urlText(state.range(0), state.range(1)).toPercentEncoding());
+    for (auto _ : state)
+      benchmark::DoNotOptimize(encoded.percentDecoded());
+    setBytes(state, encoded.size());
+  }
+  BENCHMARK(BM_PercentDecoded)->ArgsProduct({{64, 4 * kKiB, kMiB}, {8, 64}});
+
+  // Parses a batch of numbers per iteration, reported as text bytes.
+  std::vector<ByteArray> numberTexts(bool floating)
+  {
+    std::mt19937_64 rng(42);
+    std::vector<ByteArray> texts;
+    for (int i = 0; i < 1024; i++)
+    {
+      const auto value = rng() >> (rng() % 64);
+      const auto text = floating ? std::to_string(static_cast<double>(value) / 1e6) : std::to_string(value);
+      texts.push_back(ByteArray::fromStdString(text));
+    }
+    return texts;
+  }
+
+  void BM_ToULongLong(benchmark::State& state)
+  {
+    const auto texts = numberTexts(false);
+    size_t bytes = 0;
+    for (const auto& text : texts)
+      bytes += text.size();
+    for (auto _ : state)
+    {
+      for (const auto& text : texts)
+        benchmark::DoNotOptimize(text.toULongLong());
+    }
+    setBytes(state, bytes);
+  }
+  BENCHMARK(BM_ToULongLong);
+
+  void BM_ToDouble(benchmark::State& state)
+  {
+    const auto texts = numberTexts(true);
+    size_t bytes = 0;
+    for (const auto& text : texts)
+      bytes += text.size();
+    for (auto _ : state)
+    {
+      for (const auto& text : texts)
+        benchmark::DoNotOptimize(text.toDouble());
+    }
+    setBytes(state, bytes);
+  }
+  BENCHMARK(BM_ToDouble);
+
+  // Appends a batch of numbers to a reused buffer, reported as text bytes.
+  void BM_AppendInteger(benchmark::State& state)
+  {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> values(1024);
+    for (auto& value : values)
+      value = rng() >> (rng() % 64);
+    ByteArray buffer;
+    for (auto _ : state)
+    {
+      buffer.clear();
+      for (const auto value : values)
+        buffer.appendNumber(value);
+      benchmark::DoNotOptimize(buffer.constData());
+    }
+    setBytes(state, buffer.size());
+  }
+  BENCHMARK(BM_AppendInteger);
+
+  // Args: precision, negative for the shortest round trip form.
+  void BM_AppendDouble(benchmark::State& state)
+  {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> values(1024);
+    for (auto& value : values)
+      value = dist(rng);
+    const auto precision = static_cast<int>(state.range(0));
+    ByteArray buffer;
+    for (auto _ : state)
+    {
+      buffer.clear();
+      for (const auto value : values)
+        buffer.appendNumber(value, 'g', precision);
+      benchmark::DoNotOptimize(buffer.constData());
+    }
+    setBytes(state, buffer.size());
+  }
+  BENCHMARK(BM_AppendDouble)->Arg(-1)->Arg(6);
+
+  // Arg: largest value in bits, so 7 and 14 give only one and two byte
+  // varints. Reported as encoded bytes; items are decoded values.
+  void BM_DecodeVarints(benchmark::State& state)
+  {
+    std::mt19937_64 rng(42);
+    const auto bits = static_cast<uint64_t>(state.range(0));
+    std::vector<uint64_t> values(64 * kKiB);
+    ByteArray encoded;
+    for (auto& value : values)
+    {
+      value = bits == 64 ? rng() >> (rng() % 64) : rng() % (uint64_t{1} << bits);
+      encoded.appendVarint(value);
+    }
+    for (auto _ : state)
+    {
+      const auto result = Boron::decodeVarints(encoded, values);
+      benchmark::DoNotOptimize(result);
+      benchmark::DoNotOptimize(values.data());
+    }
+    setBytes(state, encoded.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+  }
+  BENCHMARK(BM_DecodeVarints)->Arg(7)->Arg(14)->Arg(64);
+
+  void BM_Hash(benchmark::State& state)
+  {
+    const auto text = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(Boron::hash(text));
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Hash)->Arg(8)->Arg(24)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  void BM_Crc32(benchmark::State& state)
+  {
+    const auto text = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(text.crc32());
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Crc32)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  void BM_Crc32c(benchmark::State& state)
+  {
+    const auto text = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(text.crc32c());
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Crc32c)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  void BM_Adler32(benchmark::State& state)
+  {
+    const auto text = randomText(state.range(0));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(text.adler32());
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Adler32)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Text made of a small vocabulary of words, which compresses like prose
+  // rather than like randomText(), whose only redundancy is its alphabet.
+  ByteArray wordyText(size_t size)
+  {
+    static const char* const kWords[] = {"the ", "of ", "cache ", "block ", "payload ", "and ",
+                                         "array ", "to ", "frame ", "in ", "compress ", ".\n"};
+    std::mt19937 rng(42);
+    std::string text;
+    while (text.size() < size)
+      text += kWords[rng() % std::size(kWords)];
+    text.resize(size);
+    return ByteArray::fromStdString(text);
+  }
+
+  ByteArray compressionInput(int64_t kind, int64_t size)
+  {
+    return kind == 0 ? wordyText(size) : randomText(size);
+  }
+
+  // Args: input size, 0 for wordyText() or 1 for randomText(). The ratio
+  // counter is the input size over the compressed size.
+  void BM_Compress(benchmark::State& state)
+  {
+    const auto input = compressionInput(state.range(1), state.range(0));
+    size_t compressed = 0;
+    for (auto _ : state)
+    {
+      const auto result = Boron::compress(input);
+      compressed = result.size();
+      benchmark::DoNotOptimize(result.constData());
+    }
+    setBytes(state, input.size());
+    state.counters["ratio"] = static_cast<double>(input.size()) / static_cast<double>(compressed);
+  }
+  BENCHMARK(BM_Compress)->ArgsProduct({{4 * kKiB, kMiB}, {0, 1}});
+
+  // Reported as uncompressed bytes, decoding into a reused buffer.
+  void BM_Uncompress(benchmark::State& state)
+  {
+    const auto input = compressionInput(state.range(1), state.range(0));
+    const auto compressed = Boron::compress(input);
+    ByteArray out;
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(Boron::uncompress(compressed, out));
+      benchmark::DoNotOptimize(out.constData());
+    }
+    setBytes(state, input.size());
+    state.counters["ratio"] = static_cast<double>(input.size()) / static_cast<double>(compressed.size());
+  }
+  BENCHMARK(BM_Uncompress)->ArgsProduct({{4 * kKiB, kMiB}, {0, 1}});
+
+  // UTF-8 text in which the given percentage of characters are ASCII, the
+  // rest evenly two, three and four bytes long.
+  ByteArray utf8Text(size_t size, int64_t ascii_percent)
+  {
+    static const char* const kWide[] = {"\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string text;
+    while (true)
+    {
+      std::string c(1, static_cast<char>(letter(rng)));
+      if (static_cast<int64_t>(rng() % 100) >= ascii_percent)
+        c = kWide[rng() % 3];
+      // Whole characters only, so that the text stays valid.
+      if (text.size() + c.size() > size)
+        break;
+      text += c;
+    }
+    return ByteArray::fromStdString(text);
+  }
+
+  // Args: text size, percentage of ASCII characters.
+  void BM_IsValidUtf8(benchmark::State& state)
+  {
+    const auto text = utf8Text(state.range(0), state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(text.isValidUtf8());
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_IsValidUtf8)->ArgsProduct({{64, 4 * kKiB, kMiB}, {100, 90, 0}});
+
+  // Reported as UTF-8 bytes read.
+  void BM_Utf8ToUtf16(benchmark::State& state)
+  {
+    const auto text = utf8Text(state.range(0), state.range(1));
+    std::u16string out(text.size(), u'\0');
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(Boron::utf8ToUtf16(text, out.data()));
+      benchmark::DoNotOptimize(out.data());
+    }
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Utf8ToUtf16)->ArgsProduct({{4 * kKiB, kMiB}, {100, 90, 0}});
+
+  // Reported as UTF-8 bytes written.
+  void BM_Utf16ToUtf8(benchmark::State& state)
+  {
+    const auto text = utf8Text(state.range(0), state.range(1));
+    const auto utf16 = text.toUtf16();
+    ByteArray out(text.size(), '\0');
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(Boron::utf16ToUtf8(utf16, out.data()));
+      benchmark::DoNotOptimize(out.data());
+    }
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Utf16ToUtf8)->ArgsProduct({{4 * kKiB, kMiB}, {100, 90, 0}});
+
+  // Reported as UTF-8 bytes written.
+  void BM_Utf32ToUtf8(benchmark::State& state)
+  {
+    const auto text = utf8Text(state.range(0), state.range(1));
+    std::u32string utf32(Boron::utf32LengthOfUtf8(text), U'\0');
+    Boron::utf8ToUtf32(text, utf32.data());
+    ByteArray out(text.size(), '\0');
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(Boron::utf32ToUtf8(utf32, out.data()));
+      benchmark::DoNotOptimize(out.data());
+    }
+    setBytes(state, text.size());
+  }
+  BENCHMARK(BM_Utf32ToUtf8)->ArgsProduct({{4 * kKiB, kMiB}, {100, 90, 0}});
+
+  // Args: text size, percentage of ASCII. Random code point positions, with
+  // the index built before timing.
+  void BM_StringAt(benchmark::State& state)
+  {
+    const auto text = utf8Text(state.range(0), state.range(1)).toString();
+    const auto length = text.length();
+    std::mt19937 rng(7);
+    std::vector<size_t> positions(1024);
+    for (auto& pos : positions)
+      pos = rng() % length;
+    for (auto _ : state)
+    {
+      char32_t sum = 0;
+      for (const auto pos : positions)
+        sum += text.at(pos);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(positions.size()));
+  }
+  BENCHMARK(BM_StringAt)->ArgsProduct({{4 * kKiB, kMiB}, {100, 90, 0}});
+
+  // Args: array size, replacement size. Splices in the middle of the array.
+  void BM_Replace(benchmark::State& state)
+  {
+    const auto original = randomText(state.range(0));
+    const auto after = needleOf(state.range(1));
+    for (auto _ : state)
+    {
+      auto ba = original;
+      ba.replace(ba.size() / 2, 8, after);
+      benchmark::DoNotOptimize(ba.constData());
+    }
+    setBytes(state, original.size());
+  }
+  BENCHMARK(BM_Replace)->ArgsProduct({{64, 4 * kKiB, kMiB}, {4, 64}});
+
+  // Args: array size, matches per 64 KiB, replacement size. Every
+  // occurrence of an 8-byte placeholder is substituted.
+  void BM_ReplaceAll(benchmark::State& state)
+  {
+    auto original = randomText(state.range(0));
+    const auto before = needleOf(8);
+    plant(original, before, state.range(1));
+    const auto after = randomText(state.range(2), 7);
+    for (auto _ : state)
+    {
+      auto ba = original;
+      ba.replace(before, after);
+      benchmark::DoNotOptimize(ba.constData());
+    }
+    setBytes(state, original.size());
+  }
+  BENCHMARK(BM_ReplaceAll)->ArgsProduct({{4 * kKiB, kMiB}, {16, 1024}, {4, 64}});
+
+  // Args: size. Maps through a full table in place.
+  void BM_Translate(benchmark::State& state)
+  {
+    auto ba = randomText(state.range(0));
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); i++)
+      table[i] = static_cast<uint8_t>(255 - i);
+    for (auto _ : state)
+    {
+      ba.translate(table);
+      benchmark::DoNotOptimize(ba.constData());
+    }
+    setBytes(state, ba.size());
+  }
+  BENCHMARK(BM_Translate)->Arg(64)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Args: total size, chunk size.
+  void BM_Append(benchmark::State& state)
+  {
+    const auto total = static_cast<size_t>(state.range(0));
+    const auto chunk = randomText(state.range(1));
+    for (auto _ : state)
+    {
+      ByteArray ba;
+      while (ba.size() < total)
+        ba.append(chunk);
+      benchmark::DoNotOptimize(ba.constData());
+    }
+    setBytes(state, total);
+  }
+  BENCHMARK(BM_Append)->ArgsProduct({{4 * kKiB, kMiB}, {1, 16, 1024}});
+
+  // Args: size. Compares two equal arrays that do not share a buffer, so the
+  // whole payload is read.
+  void BM_Equal(benchmark::State& state)
+  {
+    const auto a = randomText(state.range(0));
+    auto b = a;
+    b.detach();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(a == b);
+    setBytes(state, a.size());
+  }
+  BENCHMARK(BM_Equal)->Arg(16)->Arg(4 * kKiB)->Arg(kMiB);
+
+  // Args: size. Both views differ only in the last byte.
+  void BM_Compare(benchmark::State& state)
+  {
+    const auto a = randomText(state.range(0));
+    auto b = a;
+    b[b.size() - 1] = 'A';
+    for (auto _ : state)
+      benchmark::DoNotOptimize(ByteArrayView(a) <=> ByteArrayView(b));
+    setBytes(state, a.size());
+  }
+  BENCHMARK(BM_Compare)->Arg(16)->Arg(4 * kKiB)->Arg(kMiB);
+} // namespace
+
+BENCHMARK_MAIN();
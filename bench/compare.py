@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Compares two BoronBench JSON reports.
+
+Record a baseline before a change and a second report after it:
+
+    BoronBench --benchmark_out=baseline.json --benchmark_out_format=json
+    BoronBench --benchmark_out=current.json --benchmark_out_format=json
+    bench/compare.py baseline.json current.json
+
+Benchmarks are matched by name and compared on bytes_per_second, falling back
+to real_time for benchmarks that do not report throughput. When repetitions
+were requested, the median aggregate is used. The exit status is 1 if any
+benchmark regressed by more than the threshold, so the script can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    results = {}
+    for bench in report["benchmarks"]:
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+            name = bench["run_name"]
+        elif "run_name" in bench and bench.get("repetitions", 1) > 1:
+            # Individual repetitions, the median aggregate stands for them.
+            continue
+        else:
+            name = bench["name"]
+        results[name] = bench
+    return results
+
+
+def speedup(base, current):
+    """Returns current performance relative to base, above 1 is faster."""
+    if "bytes_per_second" in base and "bytes_per_second" in current:
+        return current["bytes_per_second"] / base["bytes_per_second"]
+    return base["real_time"] / current["real_time"]
+
+
+def throughput(bench):
+    if "bytes_per_second" in bench:
+        return "%10.1f MiB/s" % (bench["bytes_per_second"] / (1 << 20))
+    return "%10.1f %-5s" % (bench["real_time"], bench.get("time_unit", "ns"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="regression tolerance in percent (default: 5)")
+    parser.add_argument("--filter", default="",
+                        help="only compare benchmarks whose name contains this")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    current = load(args.current)
+    names = [n for n in base if n in current and args.filter in n]
+    if not names:
+        print("no common benchmarks", file=sys.stderr)
+        return 2
+
+    width = max(len(n) for n in names)
+    regressions = 0
+    for name in names:
+        ratio = speedup(base[name], current[name])
+        change = (ratio - 1) * 100
+        mark = ""
+        if change < -args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        elif change > args.threshold:
+            mark = "  improved"
+        print("%-*s %s -> %s %+7.1f%%%s" % (width, name, throughput(base[name]),
+                                             throughput(current[name]), change, mark))
+
+    for name in sorted(n for n in set(base) ^ set(current) if args.filter in n):
+        where = "baseline" if name in base else "current"
+        print("%-*s only in %s" % (width, name, where))
+
+    if regressions:
+        print("%d benchmark(s) regressed by more than %.1f%%" % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
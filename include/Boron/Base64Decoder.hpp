@@ -0,0 +1,75 @@
+#ifndef BORON_INCLUDE_BORON_BASE64DECODER_HPP_
+#define BORON_INCLUDE_BORON_BASE64DECODER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Boron
+{
+  // Incremental Base64 decoder writing into caller-provided buffers. Input
+  // may be split anywhere, groups that straddle two chunks are carried over,
+  // so decoding a stream chunk by chunk gives the same bytes and the same
+  // status as decoding it at once.
+  //
+  //   Base64Decoder decoder(Base64Options::Base64UrlEncoding);
+  //   for (auto chunk : chunks)
+  //     out += decoder.feed(chunk, out);
+  //   out += decoder.finish(out);
+  //   if (decoder.status() != Base64DecodingStatus::Ok)
+  //     ...
+  //
+  // Whole blocks of alphabet characters go through the vectorized kernel;
+  // separators, padding and errors are handled one character at a time.
+  class BORON_EXPORT Base64Decoder
+  {
+  public:
+    explicit Base64Decoder(Base64Options options = Base64Options::Base64Encoding) : options_(options) {}
+
+    // Upper bound of the bytes feed() writes for a chunk of size characters.
+    BORON_NODISCARD static constexpr size_t maxDecodedSize(size_t size) { return (size + 3) / 4 * 3; }
+
+    // Decodes chunk into out, which needs room for maxDecodedSize(chunk.size())
+    // bytes, and returns the number of bytes written. Once an error has been
+    // detected further input is ignored.
+    size_t feed(ByteArrayView chunk, uint8_t* out);
+
+    // Ends the stream: writes the bytes of a final group without padding, at
+    // most two, and checks that the input did not stop in the middle of a
+    // group. Returns the number of bytes written.
+    size_t finish(uint8_t* out);
+
+    void reset();
+
+    BORON_NODISCARD Base64DecodingStatus status() const { return status_; }
+    // Offset of the first offending character in the stream, ByteArray::kNpos
+    // while decoding succeeds.
+    BORON_NODISCARD size_t errorPosition() const { return error_position_; }
+    // Characters fed so far.
+    BORON_NODISCARD size_t position() const { return consumed_; }
+
+  private:
+    BORON_NODISCARD bool strict() const { return options_ & Base64Options::AbortOnBase64DecodingErrors; }
+    BORON_NODISCARD bool url() const { return options_ & Base64Options::Base64UrlEncoding; }
+
+    void fail(Base64DecodingStatus status, size_t position);
+    // Writes the complete bytes of a group of pending_ sextets and clears it.
+    size_t flush(uint8_t* out);
+
+    Base64Options options_;
+    uint32_t bits_ = 0;
+    // Sextets accumulated in bits_, and '=' seen after them.
+    uint8_t pending_ = 0;
+    uint8_t padding_ = 0;
+    // Lenient decoding ignores everything after the padding.
+    bool finished_ = false;
+    Base64DecodingStatus status_ = Base64DecodingStatus::Ok;
+    size_t consumed_ = 0;
+    size_t error_position_ = ByteArray::kNpos;
+  };
+} // namespace Boron
+
+#endif
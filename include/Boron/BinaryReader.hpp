@@ -0,0 +1,113 @@
+#ifndef BORON_INCLUDE_BORON_BINARYREADER_HPP_
+#define BORON_INCLUDE_BORON_BINARYREADER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Endian.hpp"
+#include "Boron/Global.hpp"
+#include "Boron/Varint.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace Boron
+{
+  // Reads fixed-width values from a ByteArrayView in a byte order chosen at
+  // compile time, network order (big endian) unless given; the counterpart of
+  // BinaryWriter.
+  //
+  //   BinaryReader reader(frame);
+  //   const auto kind = reader.get<uint16_t>();
+  //   uint32_t id, length, checksum;
+  //   if (!reader.read<std::endian::little>(id, length, checksum))
+  //     ...
+  //
+  // read() checks the bounds once for all its values and get() once per
+  // value. Reading past the end fails the reader for good, like QDataStream:
+  // the failed and all later reads return zero or false and leave the
+  // position unchanged, so a sequence of reads can be checked once at the end.
+  class BORON_EXPORT BinaryReader
+  {
+  public:
+    explicit BinaryReader(ByteArrayView data) : data_(data) {}
+
+    template <BinaryScalar T, std::endian Endian = std::endian::big>
+    T get()
+    {
+      if (!require(sizeof(T)))
+        return T{};
+      const auto value = loadEndian<T, Endian>(data_.data() + position_);
+      position_ += sizeof(T);
+      return value;
+    }
+
+    // Reads all values, in order, with one bounds check. On failure none of
+    // them is assigned.
+    template <std::endian Endian = std::endian::big, BinaryScalar... Ts>
+    bool read(Ts&... values)
+    {
+      static_assert(sizeof...(Ts) > 0);
+      constexpr auto size = (sizeof(Ts) + ... + 0);
+      if (!require(size))
+        return false;
+      auto in = data_.data() + position_;
+      ((values = loadEndian<Ts, Endian>(in), in += sizeof(Ts)), ...);
+      position_ += size;
+      return true;
+    }
+
+    // A malformed or truncated varint fails the reader.
+    uint64_t getVarint()
+    {
+      uint64_t value = 0;
+      const auto size = ok_ ? decodeVarint(data_.data() + position_, remaining(), value) : 0;
+      if (!size)
+      {
+        ok_ = false;
+        return 0;
+      }
+      position_ += size;
+      return value;
+    }
+    int64_t getZigZagVarint() { return zigZagDecode(getVarint()); }
+
+    // The next n bytes, as a view into the data.
+    ByteArrayView getBytes(size_t n)
+    {
+      if (!require(n))
+        return {};
+      const auto bytes = data_.sliced(position_, n);
+      position_ += n;
+      return bytes;
+    }
+
+    bool skip(size_t n)
+    {
+      if (!require(n))
+        return false;
+      position_ += n;
+      return true;
+    }
+
+    BORON_NODISCARD bool ok() const { return ok_; }
+    BORON_NODISCARD size_t position() const { return position_; }
+    BORON_NODISCARD size_t remaining() const { return data_.size() - position_; }
+    BORON_NODISCARD bool atEnd() const { return position_ == data_.size(); }
+
+  private:
+    bool require(size_t n)
+    {
+      if (ok_ && n <= remaining())
+        return true;
+      ok_ = false;
+      return false;
+    }
+
+    ByteArrayView data_;
+    size_t position_ = 0;
+    bool ok_ = true;
+  };
+} // namespace Boron
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef BORON_INCLUDE_BORON_BINARYWRITER_HPP_
+#define BORON_INCLUDE_BORON_BINARYWRITER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Endian.hpp"
+#include "Boron/Global.hpp"
+#include "Boron/Varint.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace Boron
+{
+  // Appends fixed-width values to a ByteArray in a byte order chosen at
+  // compile time, network order (big endian) unless given.
+  //
+  //   ByteArray frame;
+  //   {
+  //     BinaryWriter writer(frame);
+  //     writer.put<uint16_t>(kind);
+  //     writer.write<std::endian::little>(id, length, checksum);
+  //   } // frame now ends with the encoded fields
+  //
+  // The writer grows the target geometrically and stores into its spare room,
+  // so a put() is a capacity check, a store and, if the order is not the
+  // native one, a bswap. write() checks once for all its values. The target
+  // may hold extra bytes past the written ones until flush() or destruction,
+  // and must not be touched otherwise while the writer is alive.
+  class BORON_EXPORT BinaryWriter
+  {
+  public:
+    explicit BinaryWriter(ByteArray& target) : target_(target), written_(target.size()), reserved_(written_) {}
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+    ~BinaryWriter() { flush(); }
+
+    template <BinaryScalar T, std::endian Endian = std::endian::big>
+    BinaryWriter& put(T value)
+    {
+      storeEndian<Endian>(value, reserve(sizeof(T)));
+      return *this;
+    }
+
+    // Writes all values, in order, with one capacity check.
+    template <std::endian Endian = std::endian::big, BinaryScalar... Ts>
+    BinaryWriter& write(Ts... values)
+    {
+      static_assert(sizeof...(Ts) > 0);
+      auto out = reserve((sizeof(Ts) + ... + 0));
+      ((storeEndian<Endian>(values, out), out += sizeof(Ts)), ...);
+      return *this;
+    }
+
+    BinaryWriter& putVarint(uint64_t value)
+    {
+      const auto out = reserve(kMaxVarintSize);
+      written_ -= kMaxVarintSize - encodeVarint(value, out);
+      return *this;
+    }
+    BinaryWriter& putZigZagVarint(int64_t value) { return putVarint(zigZagEncode(value)); }
+
+    BinaryWriter& putBytes(ByteArrayView bytes);
+
+    // Bytes written so far, including what the target held before.
+    BORON_NODISCARD size_t size() const { return written_; }
+
+    // Trims the target to the bytes written.
+    void flush();
+
+  private:
+    // Makes room for n more bytes and returns where they go.
+    byte* reserve(size_t n)
+    {
+      if (reserved_ - written_ < n)
+        grow(n);
+      const auto out = data_ + written_;
+      written_ += n;
+      return out;
+    }
+
+    void grow(size_t n);
+
+    ByteArray& target_;
+    byte* data_ = nullptr;
+    size_t written_;
+    // Size of the target; bytes in [written_, reserved_) are scratch.
+    size_t reserved_;
+  };
+} // namespace Boron
+
+#endif
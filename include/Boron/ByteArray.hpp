@@ -1,10 +1,13 @@
 #ifndef BORON_INCLUDE_BORON_BYTEARRAY_HPP_
 #define BORON_INCLUDE_BORON_BYTEARRAY_HPP_
 
+#include "Boron/ByteArrayData.hpp"
 #include "Boron/Common.hpp"
+#include "Boron/Endian.hpp"
 #include "Boron/Global.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <compare>
 #include <concepts>
@@ -12,8 +15,13 @@
 #include <cstdint>
 #include <cstring>
 #include <iterator>
+#include <memory_resource>
+#include <ranges>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <bit>
 
@@ -22,6 +30,60 @@ namespace Boron
   class String;
   class ByteArray;
   class ByteArrayView;
+  class ByteArraySplitRange;
+
+  enum class SplitBehavior
+  {
+    KeepEmptyParts,
+    SkipEmptyParts,
+  };
+
+  // Case-insensitive comparisons and searches fold A-Z to a-z and leave every
+  // other byte as it is, whatever the C locale says.
+  enum class CaseSensitivity
+  {
+    CaseSensitive,
+    CaseInsensitive,
+  };
+
+  enum class HexDecodingStatus
+  {
+    Ok,
+    IllegalLength,
+    IllegalCharacter,
+  };
+
+  // Flags, combine them with |. Decoding is lenient by default: characters
+  // outside the alphabet are skipped and decoding stops at the first '='.
+  // AbortOnBase64DecodingErrors rejects anything but the alphabet and correct
+  // padding, which may only be left out together with OmitTrailingEquals.
+  enum class Base64Options : uint32_t
+  {
+    Base64Encoding = 0,
+    Base64UrlEncoding = 1,
+    KeepTrailingEquals = 0,
+    OmitTrailingEquals = 2,
+    IgnoreBase64DecodingErrors = 0,
+    AbortOnBase64DecodingErrors = 4,
+  };
+
+  constexpr Base64Options operator|(Base64Options lhs, Base64Options rhs)
+  {
+    return static_cast<Base64Options>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+  }
+
+  constexpr bool operator&(Base64Options options, Base64Options flag)
+  {
+    return (static_cast<uint32_t>(options) & static_cast<uint32_t>(flag)) != 0;
+  }
+
+  enum class Base64DecodingStatus
+  {
+    Ok,
+    IllegalInputLength,
+    IllegalCharacter,
+    IllegalPadding,
+  };
 
   template <typename T>
   concept VectorOfByteLike = requires(T t)
@@ -121,6 +183,57 @@ namespace Boron
     // toByteArray(const ByteArrayView &view); // TODO: Implement
     BORON_NODISCARD ByteArray toByteArray() const;
 
+    BORON_NODISCARD ByteArray toBase64(Base64Options options = Base64Options::Base64Encoding) const;
+    // Length of toBase64(options).
+    BORON_NODISCARD size_t base64Size(Base64Options options = Base64Options::Base64Encoding) const noexcept;
+    // Writes base64Size(options) characters to out without allocating and
+    // returns their number.
+    size_t writeBase64(char* out, Base64Options options = Base64Options::Base64Encoding) const;
+
+    // Locale-free parsing of the whole view; surrounding whitespace is allowed
+    // and nothing allocates. Integers take an optional sign and base 2 to 36,
+    // or 0 to pick the base from a 0x, 0b or 0 prefix; bases 16 and 2 accept
+    // their prefix as well. Floating point takes decimal or exponent notation,
+    // inf and nan. Malformed input and values out of range give 0 and set *ok,
+    // if given, to false.
+    BORON_NODISCARD short toShort(bool* ok = nullptr, int base = 10) const { return toIntegral<short>(ok, base); }
+    BORON_NODISCARD unsigned short toUShort(bool* ok = nullptr, int base = 10) const
+    {
+      return toIntegral<unsigned short>(ok, base);
+    }
+    BORON_NODISCARD int toInt(bool* ok = nullptr, int base = 10) const { return toIntegral<int>(ok, base); }
+    BORON_NODISCARD unsigned int toUInt(bool* ok = nullptr, int base = 10) const
+    {
+      return toIntegral<unsigned int>(ok, base);
+    }
+    BORON_NODISCARD long toLong(bool* ok = nullptr, int base = 10) const { return toIntegral<long>(ok, base); }
+    BORON_NODISCARD unsigned long toULong(bool* ok = nullptr, int base = 10) const
+    {
+      return toIntegral<unsigned long>(ok, base);
+    }
+    BORON_NODISCARD long long toLongLong(bool* ok = nullptr, int base = 10) const;
+    BORON_NODISCARD unsigned long long toULongLong(bool* ok = nullptr, int base = 10) const;
+    BORON_NODISCARD float toFloat(bool* ok = nullptr) const;
+    BORON_NODISCARD double toDouble(bool* ok = nullptr) const;
+
+    // Reads the varint at the start of the view, see Boron/Varint.hpp, and
+    // sets *consumed, if given, to its size. A malformed or truncated varint
+    // gives 0 and sets *consumed to 0.
+    BORON_NODISCARD uint64_t toVarint(size_t* consumed = nullptr) const;
+    BORON_NODISCARD int64_t toZigZagVarint(size_t* consumed = nullptr) const;
+
+    // Checksums of the whole view, see Boron/Checksum.hpp for incremental
+    // ones: CRC-32 as in zlib, CRC-32C (Castagnoli) and Adler-32.
+    BORON_NODISCARD uint32_t crc32() const;
+    BORON_NODISCARD uint32_t crc32c() const;
+    BORON_NODISCARD uint32_t adler32() const;
+
+    // Whether the view is well-formed UTF-8, see Boron/Unicode.hpp.
+    BORON_NODISCARD bool isValidUtf8() const noexcept;
+    // Decodes UTF-8 as Qt does, with every maximal malformed subpart replaced
+    // by U+FFFD.
+    BORON_NODISCARD std::u16string toUtf16() const;
+
     ByteArrayView(const ByteArrayView& other) = default;
     ByteArrayView(ByteArrayView&& other) noexcept = default;
     ~ByteArrayView() = default;
@@ -172,10 +285,35 @@ namespace Boron
       return {data_ + pos, n};
     }
 
+    // A copy, with malformed UTF-8 replaced by U+FFFD.
     BORON_NODISCARD String toString() const;
 
     BORON_NODISCARD constexpr bool isNull() const { return data_ == nullptr; }
 
+    BORON_NODISCARD size_t indexOf(uint8_t c, size_t from = 0) const;
+    BORON_NODISCARD size_t indexOf(ByteArrayView bv, size_t from = 0) const;
+    BORON_NODISCARD size_t indexOf(ByteArrayView bv, size_t from, CaseSensitivity cs) const;
+
+    // Without the whitespace ByteArray::trimmed() strips, as a view into
+    // this one.
+    BORON_NODISCARD ByteArrayView trimmed() const;
+
+    BORON_NODISCARD bool startsWith(ByteArrayView bv, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const;
+    BORON_NODISCARD bool endsWith(ByteArrayView bv, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const;
+    // -1, 0 or 1, like ByteArray::compare().
+    BORON_NODISCARD int compare(ByteArrayView bv, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const noexcept;
+
+    // Fields between separators, as views into this view. The separator view
+    // has to outlive the returned range.
+    BORON_NODISCARD ByteArraySplitRange splitRange(uint8_t sep,
+                                                   SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const;
+    BORON_NODISCARD ByteArraySplitRange splitRange(ByteArrayView sep,
+                                                   SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const;
+    BORON_NODISCARD std::vector<ByteArrayView> splitView(
+      uint8_t sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const;
+    BORON_NODISCARD std::vector<ByteArrayView> splitView(
+      ByteArrayView sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const;
+
     BORON_NODISCARD friend inline constexpr auto operator<=>
     (const ByteArrayView& lhs, const ByteArrayView& rhs)
     {
@@ -198,15 +336,162 @@ namespace Boron
     }
 
   private:
+    template <std::integral T>
+    T toIntegral(bool* ok, int base) const
+    {
+      bool parsed = false;
+      T result = 0;
+      if constexpr (std::is_signed_v<T>)
+      {
+        const auto value = toLongLong(&parsed, base);
+        parsed = parsed && std::in_range<T>(value);
+        result = parsed ? static_cast<T>(value) : 0;
+      }
+      else
+      {
+        const auto value = toULongLong(&parsed, base);
+        parsed = parsed && std::in_range<T>(value);
+        result = parsed ? static_cast<T>(value) : 0;
+      }
+      if (ok)
+        *ok = parsed;
+      return result;
+    }
+
     size_type size_;
     const storage_type* data_;
   };
 
-  // TODO: add range-based api
+  // Lazy split of a ByteArrayView: each field is found only when the iterator
+  // reaches it and is returned as a view into the source, so walking the
+  // fields never allocates. A single byte separator and a multi-byte one both
+  // use the vectorized search kernels. An empty separator yields the whole
+  // source as one field.
+  class BORON_EXPORT ByteArraySplitRange : public std::ranges::view_interface<ByteArraySplitRange>
+  {
+    // What to split and how: two views and a few scalars, which iterators
+    // copy so that they stay valid after the range is moved or destroyed.
+    struct Pattern
+    {
+      ByteArrayView source;
+      ByteArrayView sep;
+      uint8_t sep_byte = 0;
+      bool single_byte = true;
+      SplitBehavior behavior = SplitBehavior::SkipEmptyParts;
+
+      BORON_NODISCARD bool skipsEmpty() const { return behavior == SplitBehavior::SkipEmptyParts; }
+      BORON_NODISCARD size_t separatorSize() const { return single_byte ? 1 : sep.size(); }
+
+      // Position of the next separator at or after from, or the size of the
+      // source when there is none.
+      BORON_NODISCARD size_t findSeparator(size_t from) const
+      {
+        size_t pos = static_cast<size_t>(-1);
+        if (single_byte)
+          pos = source.indexOf(sep_byte, from);
+        else if (!sep.empty())
+          pos = source.indexOf(sep, from);
+        return pos == static_cast<size_t>(-1) ? source.size() : pos;
+      }
+    };
+
+  public:
+    class Iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using iterator_concept = std::forward_iterator_tag;
+      using value_type = ByteArrayView;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+
+      BORON_NODISCARD ByteArrayView operator*() const { return pattern_.source.sliced(begin_, end_ - begin_); }
+
+      Iterator& operator++()
+      {
+        do
+        {
+          advance();
+        } while (!done_ && pattern_.skipsEmpty() && begin_ == end_);
+        return *this;
+      }
+
+      Iterator operator++(int)
+      {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      }
+
+      // Iterators of the same range compare by position.
+      friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+      {
+        return lhs.begin_ == rhs.begin_ && lhs.end_ == rhs.end_ && lhs.done_ == rhs.done_;
+      }
+      friend bool operator==(const Iterator& it, std::default_sentinel_t) { return it.done_; }
+
+    private:
+      friend class ByteArraySplitRange;
+
+      explicit Iterator(const Pattern& pattern) : pattern_(pattern)
+      {
+        end_ = pattern_.findSeparator(0);
+        if (pattern_.skipsEmpty() && begin_ == end_)
+          ++*this;
+      }
+
+      void advance()
+      {
+        if (end_ == pattern_.source.size())
+        {
+          done_ = true;
+          begin_ = end_;
+          return;
+        }
+        begin_ = end_ + pattern_.separatorSize();
+        end_ = pattern_.findSeparator(begin_);
+      }
+
+      Pattern pattern_;
+      size_t begin_ = 0;
+      size_t end_ = 0;
+      bool done_ = false;
+    };
+
+    ByteArraySplitRange() = default;
+
+    ByteArraySplitRange(ByteArrayView source, uint8_t sep, SplitBehavior behavior) :
+      pattern_{source, {}, sep, true, behavior}
+    {
+    }
+
+    ByteArraySplitRange(ByteArrayView source, ByteArrayView sep, SplitBehavior behavior) :
+      pattern_{source, sep, 0, false, behavior}
+    {
+    }
+
+    BORON_NODISCARD Iterator begin() const { return Iterator(pattern_); }
+    BORON_NODISCARD std::default_sentinel_t end() const { return {}; }
+
+  private:
+    Pattern pattern_;
+  };
+
+  inline ByteArraySplitRange ByteArrayView::splitRange(uint8_t sep, SplitBehavior behavior) const
+  {
+    return {*this, sep, behavior};
+  }
+
+  inline ByteArraySplitRange ByteArrayView::splitRange(ByteArrayView sep, SplitBehavior behavior) const
+  {
+    return {*this, sep, behavior};
+  }
+
   class BORON_EXPORT ByteArray
   {
   private:
-    using Container = std::vector<byte>;
+    using Container = Detail::ByteArrayData;
     Container data_;
 
     static constexpr uint8_t kEmpty = 0;
@@ -224,43 +509,93 @@ namespace Boron
     using const_iterator = const_pointer;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = std::pmr::polymorphic_allocator<storage_type>;
 
     static constexpr const size_t kNpos = -1;
     static constexpr const size_t kDetectLength = -1;
+    // Payloads up to this size are stored inline, without a heap allocation.
+    static constexpr const size_t kInlineCapacity = Container::kInlineCapacity;
 
     inline ByteArray() noexcept;
 
-    inline ByteArray(const_iterator begin, const_iterator end): data_(begin, end)
+    inline ByteArray(const_iterator begin, const_iterator end): data_(begin, end - begin)
     {
     }
 
     ByteArray(const uint8_t*, size_t size = -1);
     ByteArray(size_t size, uint8_t c);
-    inline ByteArray(const ByteArray&) noexcept = default;
+
+    // Arrays bound to a memory resource allocate every buffer from it,
+    // including those of slices and of the arrays returned by split(),
+    // repeated() and similar functions; these must not outlive the resource.
+    // Binding an empty array allocates nothing. As with std::pmr containers,
+    // the resource is not propagated: a copy of a bound array is made on the
+    // global heap, and assigning to an array keeps its resource, copying the
+    // bytes unless both arrays use the same one. Use ByteArray(other, resource)
+    // to copy into a given resource.
+    explicit ByteArray(std::pmr::memory_resource* resource) : data_(resource) {}
+    ByteArray(ByteArrayView data, std::pmr::memory_resource* resource);
+    ByteArray(size_t size, uint8_t c, std::pmr::memory_resource* resource) : data_(size, c, resource) {}
+    inline ByteArray(const ByteArray&) = default;
     inline ~ByteArray();
 
-    ByteArray& operator=(const ByteArray&) noexcept;
+    ByteArray& operator=(const ByteArray&) = default;
     // TODO: implement operator= for uint8_t *
     ByteArray& operator=(const uint8_t* str);
     // FIXME: move constructor seems to be wrong
     inline ByteArray(ByteArray&& other) noexcept = default;
     // TODO: check why Qt use pure swap
-    ByteArray& operator=(ByteArray&& other) noexcept = default;
+    ByteArray& operator=(ByteArray&& other) = default;
 
     inline void swap(ByteArray& other) noexcept
     {
-      std::swap(this->data_, other.data_);
+      this->data_.swap(other.data_);
     }
 
     BORON_NODISCARD bool isEmpty() const noexcept { return size() == 0; }
     void resize(size_t size);
     void resize(size_t size, uint8_t c);
 
+    // Resizes without zero-filling: bytes past the old size are indeterminate
+    // until written. Use it when the caller overwrites them anyway.
+    void resizeForOverwrite(size_t size) { this->data_.resizeForOverwrite(size); }
+
+    // Like std::string::resize_and_overwrite(): makes room for n bytes, calls
+    // op(data(), n) to fill them and truncates to the size op returns, which
+    // must not exceed n.
+    template <typename Operation>
+    void resize_and_overwrite(size_t n, Operation op)
+    {
+      resizeForOverwrite(n);
+      const auto size = static_cast<size_t>(std::move(op)(this->data(), n));
+      assert(size <= n);
+      this->data_.resize(size);
+    }
+
     ByteArray& fill(uint8_t c, size_t size = -1);
 
+    // The resource buffers are allocated from, new_delete_resource() unless the
+    // array was bound to another one.
+    BORON_NODISCARD std::pmr::memory_resource* resource() const noexcept
+    {
+      const auto resource = this->data_.resource();
+      return resource ? resource : std::pmr::new_delete_resource();
+    }
+
+    BORON_NODISCARD allocator_type get_allocator() const noexcept { return resource(); }
+
     BORON_NODISCARD inline size_t capacity() const { return this->data_.capacity(); }
     inline void reserve(size_t size) { return this->data_.reserve(size); }
-    inline void squeeze() { this->data_.shrink_to_fit(); }
+    inline void squeeze() { this->data_.shrinkToFit(); }
+
+    // Copies share the payload until one of them is written to. Mutable access
+    // (data(), operator[], iterators) detaches first.
+    void detach() { this->data_.detach(); }
+    BORON_NODISCARD bool isDetached() const noexcept { return !this->data_.isShared(); }
+    BORON_NODISCARD bool isSharedWith(const ByteArray& other) const noexcept
+    {
+      return this->data_.isSharedWith(other.data_);
+    }
 
     inline uint8_t* data();
     BORON_NODISCARD inline const uint8_t* data() const noexcept;
@@ -277,8 +612,9 @@ namespace Boron
 
     BORON_NODISCARD size_t indexOf(uint8_t c, size_t from = 0) const;
     BORON_NODISCARD size_t indexOf(ByteArrayView bv, size_t from = 0) const;
+    BORON_NODISCARD size_t indexOf(ByteArrayView bv, size_t from, CaseSensitivity cs) const;
 
-    // TODO: implement Detail::findLastByte and Detail::findLastByteArray
+    // Backward searches for the last match starting at or before from.
     BORON_NODISCARD size_t lastIndexOf(uint8_t c, size_t from = -1) const;
     BORON_NODISCARD size_t lastIndexOf(ByteArrayView bv) const;
     BORON_NODISCARD size_t lastIndexOf(ByteArrayView bv, size_t from) const;
@@ -289,7 +625,7 @@ namespace Boron
     BORON_NODISCARD size_t count(uint8_t c) const;
     BORON_NODISCARD size_t count(ByteArrayView bv) const;
 
-    BORON_NODISCARD inline int compare(ByteArrayView a) const noexcept;
+    BORON_NODISCARD int compare(ByteArrayView a, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const noexcept;
 
     BORON_NODISCARD ByteArray left(size_t n) const &
     {
@@ -319,9 +655,9 @@ namespace Boron
       return std::move(*this).last(std::max(n, 0_sz));
     }
 
-    // TODO: mid
-    BORON_NODISCARD ByteArray mid(size_t index, size_t len = -1) const &;
-    BORON_NODISCARD ByteArray mid(size_t index, size_t len = -1) &&;
+    // Like sliced(), but clamps index and len to the array instead of asserting.
+    BORON_NODISCARD ByteArray mid(size_t index, size_t len = kNpos) const &;
+    BORON_NODISCARD ByteArray mid(size_t index, size_t len = kNpos) &&;
 
     BORON_NODISCARD ByteArray first(size_t n) const &
     {
@@ -341,10 +677,11 @@ namespace Boron
       return sliced(pos, size() - pos);
     }
 
+    // Slices longer than kInlineCapacity share the buffer of this array.
     BORON_NODISCARD ByteArray sliced(size_t pos, size_t n) const &
     {
       verify(pos, n);
-      return {data_.data() + pos, n};
+      return ByteArray(data_.sliced(pos, n));
     }
 
     BORON_NODISCARD ByteArray chopped(size_t len) const &
@@ -356,7 +693,7 @@ namespace Boron
     BORON_NODISCARD ByteArray first(size_t n) &&
     {
       verify(0, n);
-      resize(n); // may detach and allocate memory
+      resize(n); // never detaches when shrinking
       return std::move(*this);
     }
 
@@ -384,20 +721,26 @@ namespace Boron
       return std::move(*this).first(size() - len);
     }
 
-    // TODO: implement Detail::startsWith and Detail::endsWith
-    BORON_NODISCARD bool startsWith(ByteArrayView bv) const;
+    BORON_NODISCARD bool startsWith(ByteArrayView bv, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const
+    {
+      return ByteArrayView(*this).startsWith(bv, cs);
+    }
     BORON_NODISCARD bool startsWith(uint8_t c) const { return size() > 0 && front() == c; }
 
     BORON_NODISCARD bool endsWith(uint8_t c) const { return size() > 0 && back() == c; }
-    BORON_NODISCARD bool endsWith(ByteArrayView bv) const;
+    BORON_NODISCARD bool endsWith(ByteArrayView bv, CaseSensitivity cs = CaseSensitivity::CaseSensitive) const
+    {
+      return ByteArrayView(*this).endsWith(bv, cs);
+    }
 
-    // TODO: implement isUpper and isLower
-    // bool isUpper() const;
-    // bool isLower() const;
+    // Whether toUpper() or toLower() respectively would leave the array
+    // unchanged: there is no ASCII lower or upper case letter in it.
+    BORON_NODISCARD bool isUpper() const;
+    BORON_NODISCARD bool isLower() const;
 
-    // BORON_NODISCARD bool isValidUtf8() const noexcept {
-    //   return QtPrivate::isValidUtf8(qToByteArrayViewIgnoringNull(*this));
-    // }
+    // See Boron/Unicode.hpp.
+    BORON_NODISCARD bool isValidUtf8() const noexcept { return ByteArrayView(*this).isValidUtf8(); }
+    BORON_NODISCARD std::u16string toUtf16() const { return ByteArrayView(*this).toUtf16(); }
 
     // TODO: implement truncate
     void truncate(size_t pos)
@@ -412,23 +755,27 @@ namespace Boron
       this->data_.resize(size() - n);
     }
 
-    // BORON_NODISCARD ByteArray toLower() const & { return toLower_helper(*this); }
-    // BORON_NODISCARD ByteArray toLower() && { return toLower_helper(*this); }
-    // BORON_NODISCARD ByteArray toUpper() const & { return toUpper_helper(*this); }
-    // BORON_NODISCARD ByteArray toUpper() && { return toUpper_helper(*this); }
+    // ASCII letters only. An array without letters to convert is returned
+    // as it is, sharing the buffer; an rvalue whose buffer is not shared is
+    // converted in place.
+    BORON_NODISCARD ByteArray toLower() const & { return toLower_helper(*this); }
+    BORON_NODISCARD ByteArray toLower() && { return toLower_helper(*this); }
+    BORON_NODISCARD ByteArray toUpper() const & { return toUpper_helper(*this); }
+    BORON_NODISCARD ByteArray toUpper() && { return toUpper_helper(*this); }
+    // Whitespace is '\t', '\n', '\v', '\f', '\r', ' ' and NUL, independent of
+    // the C locale. trimmed() shares the buffer, or for an rvalue narrows it
+    // in place. simplified() also replaces every inner run of whitespace with
+    // a single ' '; an rvalue whose buffer is not shared is rewritten in
+    // place.
     BORON_NODISCARD ByteArray trimmed() const & { return trimmed_helper(*this); }
     BORON_NODISCARD ByteArray trimmed() && { return trimmed_helper(*this); }
+    BORON_NODISCARD ByteArray simplified() const & { return simplified_helper(*this); }
+    BORON_NODISCARD ByteArray simplified() && { return simplified_helper(*this); }
 
-    // TODO: check if these simplify functions are necessary
-    // BORON_NODISCARD ByteArray simplified() const & {
-    //   return simplified_helper(*this);
-    // }
-    // BORON_NODISCARD ByteArray simplified() && { return simplified_helper(*this);
-    // }
-    // BORON_NODISCARD ByteArray leftJustified(size_t width, uint8_t fill = ' ',
-    // bool truncate = false) const;
-    // BORON_NODISCARD ByteArray rightJustified(size_t width, uint8_t fill = ' ',
-    // bool truncate = false) const;
+    // Pads with fill up to width, after or before the contents respectively.
+    // A longer array is returned as it is, or cut to width if truncate is set.
+    BORON_NODISCARD ByteArray leftJustified(size_t width, uint8_t fill = ' ', bool truncate = false) const;
+    BORON_NODISCARD ByteArray rightJustified(size_t width, uint8_t fill = ' ', bool truncate = false) const;
 
     ByteArray& prepend(uint8_t c) { return insert(0, ByteArrayView(&c, 1)); }
     inline ByteArray& prepend(size_t n, uint8_t c);
@@ -473,7 +820,7 @@ namespace Boron
 
     ByteArray& assign(ByteArrayView v)
     {
-      this->data_.assign(v.begin(), v.end());
+      this->data_.assign(v.data(), v.size());
       return *this;
     }
 
@@ -486,14 +833,22 @@ namespace Boron
     template <InputIterator Iter>
     ByteArray& assign(Iter first, Iter last)
     {
-      this->data_.assign(first, last);
+      if constexpr (std::contiguous_iterator<Iter> && ByteLike<std::iter_value_t<Iter>>)
+      {
+        this->data_.assign(reinterpret_cast<const byte*>(std::to_address(first)), last - first);
+      }
+      else
+      {
+        this->data_.clear();
+        for (; first != last; ++first)
+          this->data_.push_back(static_cast<byte>(*first));
+      }
       return *this;
     }
 
     ByteArray& insert(size_t i, ByteArrayView data)
     {
-      const auto ib = this->data_.begin();
-      this->data_.insert(ib + i, data.begin(), data.end());
+      this->data_.insert(i, data.data(), data.size());
       return *this;
     }
 
@@ -509,8 +864,7 @@ namespace Boron
 
     ByteArray& insert(size_t i, size_t count, uint8_t c)
     {
-      auto ib = this->data_.begin();
-      this->data_.insert(ib + i, count, c);
+      this->data_.insert(i, count, c);
       return *this;
     }
 
@@ -529,8 +883,7 @@ namespace Boron
       if (len == 0)
         return *this;
       verify(index, len);
-      this->data_.erase(this->data_.begin() + index,
-                        this->data_.begin() + index + len);
+      this->data_.erase(index, len);
       return *this;
     }
 
@@ -560,21 +913,20 @@ namespace Boron
       verify(index, len);
       if (len == 0 && s.empty())
         return *this;
-      auto it = this->data_.begin() + index;
-      if (s.size() == len)
+      const auto it = this->data_.data() + index;
+      if (s.size() <= len)
       {
-        // TODO: memcpy or range::copy or std::copy
-        std::copy(s.begin(), s.end(), it);
-      }
-      else if (s.size() < len)
-      {
-        std::copy(s.begin(), s.end(), it);
-        this->data_.erase(it + s.size(), it + len);
+        memmove(it, s.data(), s.size());
+        this->data_.erase(index + s.size(), len - s.size());
       }
       else
       {
-        std::copy(s.begin(), s.begin() + len, it);
-        this->data_.insert(it + len, s.begin() + len, s.end());
+        // Replace from a copy when s is a part of this array, the insert may
+        // move it.
+        const ByteArray copy = s.data() >= data() && s.data() < data() + size() ? s.toByteArray() : ByteArray();
+        const auto source = copy.isEmpty() ? s : ByteArrayView(copy);
+        memmove(it, source.data(), len);
+        this->data_.insert(index + len, source.data() + len, source.size() - len);
       }
       return *this;
     }
@@ -590,15 +942,55 @@ namespace Boron
       return replace(ByteArrayView(before, bsize), ByteArrayView(after, asize));
     }
 
+    // Replaces every occurrence of before, left to right and without
+    // overlaps; an empty before matches nothing. The matches are counted
+    // first, then the result is built in one allocation, or rewritten in
+    // place when after is not longer than before and the buffer is not
+    // shared. before and after may be parts of this array.
     ByteArray& replace(ByteArrayView before, ByteArrayView after);
     ByteArray& replace(uint8_t before, uint8_t after);
+    // Maps every byte b to table[b].
+    ByteArray& translate(const std::array<uint8_t, 256>& table);
 
     ByteArray& operator+=(uint8_t c) { return append(c); }
     ByteArray& operator+=(const uint8_t* s) { return append(s); }
     ByteArray& operator+=(const ByteArray& a) { return append(a); }
     ByteArray& operator+=(ByteArrayView a) { return append(a); }
 
+    // Empty fields are dropped; splitView() and splitRange() avoid copying the
+    // fields and can keep them.
     BORON_NODISCARD std::vector<ByteArray> split(uint8_t sep) const;
+    BORON_NODISCARD std::vector<ByteArray> split(ByteArrayView sep) const;
+
+    BORON_NODISCARD std::vector<ByteArrayView> splitView(
+      uint8_t sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const &
+    {
+      return ByteArrayView(*this).splitView(sep, behavior);
+    }
+
+    BORON_NODISCARD std::vector<ByteArrayView> splitView(
+      ByteArrayView sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const &
+    {
+      return ByteArrayView(*this).splitView(sep, behavior);
+    }
+
+    BORON_NODISCARD ByteArraySplitRange splitRange(
+      uint8_t sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const &
+    {
+      return ByteArrayView(*this).splitRange(sep, behavior);
+    }
+
+    BORON_NODISCARD ByteArraySplitRange splitRange(
+      ByteArrayView sep, SplitBehavior behavior = SplitBehavior::SkipEmptyParts) const &
+    {
+      return ByteArrayView(*this).splitRange(sep, behavior);
+    }
+
+    // Views into a temporary would dangle.
+    void splitView(uint8_t, SplitBehavior = SplitBehavior::SkipEmptyParts) && = delete;
+    void splitView(ByteArrayView, SplitBehavior = SplitBehavior::SkipEmptyParts) && = delete;
+    void splitRange(uint8_t, SplitBehavior = SplitBehavior::SkipEmptyParts) && = delete;
+    void splitRange(ByteArrayView, SplitBehavior = SplitBehavior::SkipEmptyParts) && = delete;
 
     BORON_NODISCARD ByteArray repeated(size_t times) const;
 
@@ -626,85 +1018,192 @@ namespace Boron
     }
 
 
-    // short toShort(bool* ok = nullptr, int base = 10) const;
-    // unsigned short toUShort(bool* ok = nullptr, int base = 10) const;
-    // int toInt(bool* ok = nullptr, int base = 10) const;
-    // unsigned int toUInt(bool* ok = nullptr, int base = 10) const;
-    // long toLong(bool* ok = nullptr, int base = 10) const;
-    // unsigned long toULong(bool* ok = nullptr, int base = 10) const;
-    // long long toLongLong(bool* ok = nullptr, int base = 10) const;
-    // unsigned long long toULongLong(bool* ok = nullptr, int base = 10) const;
-    // float toFloat(bool* ok = nullptr) const;
-    // double toDouble(bool* ok = nullptr) const;
-    // ByteArray toBase64(Base64Options options = Base64Encoding) const;
-    // TODO: implement Boron::String
+    // See ByteArrayView::toInt().
+    BORON_NODISCARD short toShort(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toShort(ok, base);
+    }
+    BORON_NODISCARD unsigned short toUShort(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toUShort(ok, base);
+    }
+    BORON_NODISCARD int toInt(bool* ok = nullptr, int base = 10) const { return ByteArrayView(*this).toInt(ok, base); }
+    BORON_NODISCARD unsigned int toUInt(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toUInt(ok, base);
+    }
+    BORON_NODISCARD long toLong(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toLong(ok, base);
+    }
+    BORON_NODISCARD unsigned long toULong(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toULong(ok, base);
+    }
+    BORON_NODISCARD long long toLongLong(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toLongLong(ok, base);
+    }
+    BORON_NODISCARD unsigned long long toULongLong(bool* ok = nullptr, int base = 10) const
+    {
+      return ByteArrayView(*this).toULongLong(ok, base);
+    }
+    BORON_NODISCARD float toFloat(bool* ok = nullptr) const { return ByteArrayView(*this).toFloat(ok); }
+    BORON_NODISCARD double toDouble(bool* ok = nullptr) const { return ByteArrayView(*this).toDouble(ok); }
+    BORON_NODISCARD uint64_t toVarint(size_t* consumed = nullptr) const
+    {
+      return ByteArrayView(*this).toVarint(consumed);
+    }
+    BORON_NODISCARD int64_t toZigZagVarint(size_t* consumed = nullptr) const
+    {
+      return ByteArrayView(*this).toZigZagVarint(consumed);
+    }
+    BORON_NODISCARD uint32_t crc32() const { return ByteArrayView(*this).crc32(); }
+    BORON_NODISCARD uint32_t crc32c() const { return ByteArrayView(*this).crc32c(); }
+    BORON_NODISCARD uint32_t adler32() const { return ByteArrayView(*this).adler32(); }
+    BORON_NODISCARD ByteArray toBase64(Base64Options options = Base64Options::Base64Encoding) const
+    {
+      return ByteArrayView(*this).toBase64(options);
+    }
+    BORON_NODISCARD size_t base64Size(Base64Options options = Base64Options::Base64Encoding) const noexcept
+    {
+      return ByteArrayView(*this).base64Size(options);
+    }
+    size_t writeBase64(char* out, Base64Options options = Base64Options::Base64Encoding) const
+    {
+      return ByteArrayView(*this).writeBase64(out, options);
+    }
+    // Shares the buffer if it holds well-formed UTF-8, see Boron/String.hpp.
+    BORON_NODISCARD String toString() const &;
+    BORON_NODISCARD String toString() &&;
+    // Upper case hex digits; a non-zero separator goes between every two bytes.
     BORON_NODISCARD std::string toHex(char separator = '\0') const;
-    std::string toPercentEncoding(const ByteArray& exclude = ByteArray(),
-                                  const ByteArray& include = ByteArray(),
-                                  uint8_t percent = '%') const;
+    // Length of toHex(separator).
+    BORON_NODISCARD size_t hexSize(char separator = '\0') const noexcept;
+    // Writes hexSize(separator) characters to out without allocating and
+    // returns their number.
+    size_t writeHex(char* out, char separator = '\0') const;
+    // Escapes everything but the RFC 3986 unreserved characters and the bytes
+    // in exclude; bytes in include and percent itself are always escaped. Use
+    // PercentEncoder to encode many strings with the same sets.
+    BORON_NODISCARD std::string toPercentEncoding(const ByteArray& exclude = ByteArray(),
+                                                  const ByteArray& include = ByteArray(),
+                                                  uint8_t percent = '%') const;
+    // Decodes percent followed by two hex digits of either case; a percent
+    // without them is kept as is.
     BORON_NODISCARD ByteArray percentDecoded(uint8_t percent = '%') const;
 
-    // inline ByteArray& setNum(short, std::endian endian);
-    // inline ByteArray& setNum(unsigned short, std::endian endian);
-    // inline ByteArray& setNum(int, std::endian endian);
-    // inline ByteArray& setNum(unsigned int, std::endian endian);
-    // inline ByteArray& setNum(long, std::endian endian);
-    // inline ByteArray& setNum(unsigned long, std::endian endian);
-    // TODO: the design of setNum in Qt makes no sense. It should return a ByteArray with the number in it in proper endianness
+    // Replaces the contents with the sizeof(T) bytes of number in the given
+    // byte order. BinaryWriter appends many values with the order fixed at
+    // compile time.
     template <std::integral T>
-    inline ByteArray& setNum(T number, std::endian endian)
-    {
-      if constexpr (std::is_signed_v<T>)
-      {
-        setNum_helper(static_cast<unsigned long long>(number), endian, sizeof(T));
-      }
-      else
-      {
-        setNum_helper(static_cast<long long>(number), endian, sizeof(T));
-      }
+      requires(!std::same_as<T, bool>)
+    ByteArray& setNum(T number, std::endian endian)
+    {
+      resize_and_overwrite(sizeof(T), [&](uint8_t* out, size_t n) {
+        if (endian == std::endian::big)
+          storeEndian<std::endian::big>(number, out);
+        else
+          storeEndian<std::endian::little>(number, out);
+        return n;
+      });
       return *this;
     }
 
-    // ByteArray& setNum(long long, std::endian endian);
-    // ByteArray& setNum(unsigned long long, std::endian endian);
 #if BORON_ENABLE_GMP
     // TODO: implement setNum for mpz_class
 #endif
-    // TODO: setNum for float and double
-    ByteArray& setNum(float, uint8_t format = 'g', int precision = 6);
-    ByteArray& setNum(double, uint8_t format = 'g', int precision = 6);
+    // Text forms of numbers. Integers use base 2 to 36 with lower case digits
+    // and a minus sign for negative numbers in every base; any other base
+    // formats nothing, so number() and setNum() give an empty array and
+    // appendNumber() leaves it as it was. Floating point follows printf() for
+    // the formats 'e', 'E', 'f', 'g' and 'G'; kFloatingPointShortest, or any
+    // negative precision, gives the shortest text that reads back as the same
+    // value. Infinities print as "inf" or "-inf", and NaN as "nan" without a
+    // sign, in upper case for 'E' and 'G'. Nothing depends on the locale.
+    static constexpr int kFloatingPointShortest = -128;
+
+    template <std::integral T>
+      requires(!std::same_as<T, bool>)
+    ByteArray& setNum(T n, int base = 10)
+    {
+      clear();
+      return appendNumber(n, base);
+    }
+    ByteArray& setNum(float n, uint8_t format = 'g', int precision = 6);
+    ByteArray& setNum(double n, uint8_t format = 'g', int precision = 6);
+
+    // Like append(number(...)) but formats straight into the spare capacity,
+    // so appending many numbers to one buffer does not allocate per number.
+    template <std::integral T>
+      requires(!std::same_as<T, bool>)
+    ByteArray& appendNumber(T n, int base = 10)
+    {
+      const auto magnitude = static_cast<unsigned long long>(n);
+      if constexpr (std::is_signed_v<T>)
+      {
+        if (n < 0)
+          return appendNumber_helper(0 - magnitude, true, base);
+      }
+      return appendNumber_helper(magnitude, false, base);
+    }
+    ByteArray& appendNumber(float n, uint8_t format = 'g', int precision = 6);
+    ByteArray& appendNumber(double n, uint8_t format = 'g', int precision = 6);
+
+    template <std::integral T>
+      requires(!std::same_as<T, bool>)
+    BORON_NODISCARD static ByteArray number(T n, int base = 10)
+    {
+      ByteArray result;
+      result.appendNumber(n, base);
+      return result;
+    }
+    BORON_NODISCARD static ByteArray number(double n, uint8_t format = 'g', int precision = 6);
+    template <std::integral T>
+      requires(!std::same_as<T, bool>)
+    BORON_NODISCARD static ByteArray number(T n, std::endian endian)
+    {
+      ByteArray result;
+      result.setNum(n, endian);
+      return result;
+    }
+
+    // Appends value as a varint, and a signed value zigzag encoded first so
+    // that small negative numbers stay short. See Boron/Varint.hpp.
+    ByteArray& appendVarint(uint64_t value);
+    ByteArray& appendZigZagVarint(int64_t value);
+
     // To re-use existed ByteArray to save memory re-allocations.
     ByteArray& setRawData(const uint8_t* a, size_t n);
 
-    // BORON_NODISCARD static ByteArray number(int, int base = 10);
-    // BORON_NODISCARD static ByteArray number(unsigned int, int base = 10);
-    // BORON_NODISCARD static ByteArray number(long, int base = 10);
-    // BORON_NODISCARD static ByteArray number(unsigned long, int base = 10);
-    // BORON_NODISCARD static ByteArray number(long long, int base = 10);
-    // BORON_NODISCARD static ByteArray number(unsigned long long, int base = 10);
-    // BORON_NODISCARD static ByteArray number(double, uint8_t format = 'g',
-    //                                       int precision = 6);
-
     BORON_NODISCARD static ByteArray fromRawData(const uint8_t* data, size_t size)
     {
       return {const_cast<uint8_t*>(data), size};
     }
 
-    // TODO: redesign Base64
-    // TODO: implement fromHex
-    // TODO: String
+    class FromHexResult;
+    class FromBase64Result;
+
+    // Decodes in one call, see Base64Decoder for chunked input and decoding
+    // into a caller-provided buffer. decoded is empty unless decoding
+    // succeeds; errors only occur with AbortOnBase64DecodingErrors.
+    BORON_NODISCARD static FromBase64Result fromBase64Encoding(
+      ByteArrayView base64, Base64Options options = Base64Options::Base64Encoding);
+    BORON_NODISCARD static ByteArray fromBase64(ByteArrayView base64,
+                                                Base64Options options = Base64Options::Base64Encoding);
+
+    // Accepts digits of either case. Returns an empty array when the input is
+    // not valid hex, use fromHexEncoding() to find out why.
     BORON_NODISCARD static ByteArray fromHex(const std::string& hexEncoded);
-    // TODO: implement fromPercentEncoding
-    BORON_NODISCARD static ByteArray
-    fromPercentEncoding(const ByteArray& pctEncoded, uint8_t percent = '%');
+    BORON_NODISCARD static FromHexResult fromHexEncoding(ByteArrayView hexEncoded);
+    // Decodes into out, which must have room for hexEncoded.size() / 2 bytes,
+    // without allocating. On failure errorPosition, if given, receives the
+    // offset of the first offending character and out is partially written.
+    static HexDecodingStatus decodeHex(ByteArrayView hexEncoded, uint8_t* out, size_t* errorPosition = nullptr);
+    BORON_NODISCARD static ByteArray fromPercentEncoding(const ByteArray& pctEncoded, uint8_t percent = '%');
 
-    // TODO: typedef iterator
-    typedef uint8_t* iterator;
-    typedef const uint8_t* const_iterator;
     typedef iterator Iterator;
     typedef const_iterator ConstIterator;
-    typedef std::reverse_iterator<iterator> reverse_iterator;
-    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
     iterator begin() { return data(); }
     BORON_NODISCARD const_iterator begin() const noexcept { return data(); }
     BORON_NODISCARD const_iterator cbegin() const noexcept { return begin(); }
@@ -744,6 +1243,8 @@ namespace Boron
     BORON_NODISCARD inline bool empty() const { return data_.empty(); }
 
     static ByteArray fromStdString(const std::string& s);
+    // Encodes as UTF-8, with unpaired surrogates replaced by U+FFFD.
+    BORON_NODISCARD static ByteArray fromUtf16(std::u16string_view s);
     BORON_NODISCARD std::string toStdString() const;
 
     BORON_NODISCARD inline size_t size() const noexcept { return data_.size(); }
@@ -751,8 +1252,9 @@ namespace Boron
     BORON_NODISCARD inline bool isNull() const noexcept { return data_.empty(); }
 
   private:
-    static ByteArray setNum_helper(unsigned long long, std::endian, size_t);
-    static ByteArray setNum_helper(long long, std::endian, size_t);
+    explicit ByteArray(Container data) noexcept : data_(std::move(data)) {}
+
+    ByteArray& appendNumber_helper(unsigned long long magnitude, bool negative, int base);
 
     void expand(size_t i);
 
@@ -766,12 +1268,29 @@ namespace Boron
     }
 
     static ByteArray sliced_helper(ByteArray& a, size_t pos, size_t n);
+    static ByteArray toLower_helper(const ByteArray& a);
+    static ByteArray toLower_helper(ByteArray& a);
+    static ByteArray toUpper_helper(const ByteArray& a);
+    static ByteArray toUpper_helper(ByteArray& a);
     static ByteArray trimmed_helper(const ByteArray& a);
     static ByteArray trimmed_helper(ByteArray& a);
+    static ByteArray simplified_helper(const ByteArray& a);
+    static ByteArray simplified_helper(ByteArray& a);
 
     friend class String;
   };
 
+  class ByteArray::FromHexResult
+  {
+  public:
+    ByteArray decoded;
+    HexDecodingStatus decodingStatus = HexDecodingStatus::Ok;
+    // Offset of the first offending character, the input size for an odd
+    // length and kNpos on success.
+    size_t errorPosition = kNpos;
+
+    explicit operator bool() const noexcept { return decodingStatus == HexDecodingStatus::Ok; }
+  };
 
   // TODO: constexpr ByteArray::ByteArray() noexcept {}
   inline ByteArray::ByteArray() noexcept = default;
@@ -781,13 +1300,13 @@ namespace Boron
   inline uint8_t ByteArray::at(size_t i) const
   {
     verify(i, 1);
-    return data_[i];
+    return data_.data()[i];
   }
 
   inline uint8_t ByteArray::operator[](size_t i) const
   {
     verify(i, 1);
-    return data_[i];
+    return data_.data()[i];
   }
 
   inline uint8_t* ByteArray::data()
@@ -800,24 +1319,6 @@ namespace Boron
     return data_.data();
   }
 
-  // inline void ByteArray::detach() {
-  //   if (d->needsDetach())
-  //     reallocData(size(), QArrayData::KeepSize);
-  // }
-  // inline bool ByteArray::isDetached() const { return !d->isShared(); }
-  // inline ByteArray::ByteArray(const ByteArray &a) noexcept : d(a.d) {}
-
-  // inline size_t ByteArray::capacity() const {
-  //   return size_t(d->constAllocatedCapacity());
-  // }
-
-  // inline void ByteArray::reserve(size_t asize) {
-  //   if (d->needsDetach() || asize > capacity() - d->freeSpaceAtBegin())
-  //     reallocData(std::max(size(), asize), QArrayData::KeepSize);
-  //   if (d->constAllocatedCapacity())
-  //     d->setFlag(Data::CapacityReserved);
-  // }
-
   inline uint8_t& ByteArray::operator[](size_t i)
   {
     verify(i, 1);
@@ -854,58 +1355,68 @@ namespace Boron
     return indexOf(bv) != static_cast<size_t>(-1);
   }
 
-  inline int ByteArray::compare(ByteArrayView a) const noexcept
-  {
-    return orderToInt(ByteArrayView(*this) <=> a);
-  }
-
-  // TODO: qCompress
+  // compress() and uncompress() are in Boron/Compression.hpp.
 
   // TODO: swap
   // Q_DECLARE_SHARED(ByteArray)
 
-  // class ByteArray::FromBase64Result {
-  // public:
-  //   ByteArray decoded;
-  //   ByteArray::Base64DecodingStatus decodingStatus;
+  class ByteArray::FromBase64Result
+  {
+  public:
+    ByteArray decoded;
+    Base64DecodingStatus decodingStatus = Base64DecodingStatus::Ok;
 
-  //   void swap(ByteArray::FromBase64Result &other) noexcept {
-  //     decoded.swap(other.decoded);
-  //     std::swap(decodingStatus, other.decodingStatus);
-  //   }
+    void swap(FromBase64Result& other) noexcept
+    {
+      decoded.swap(other.decoded);
+      std::swap(decodingStatus, other.decodingStatus);
+    }
 
-  //   explicit operator bool() const noexcept {
-  //     return decodingStatus == ByteArray::Base64DecodingStatus::Ok;
-  //   }
+    explicit operator bool() const noexcept { return decodingStatus == Base64DecodingStatus::Ok; }
 
-  //   ByteArray &operator*() noexcept { return decoded; }
-  //   const ByteArray &operator*() const noexcept { return decoded; }
+    ByteArray& operator*() noexcept { return decoded; }
+    const ByteArray& operator*() const noexcept { return decoded; }
 
-  //   friend inline bool
-  //   operator==(const ByteArray::FromBase64Result &lhs,
-  //              const ByteArray::FromBase64Result &rhs) noexcept {
-  //     if (lhs.decodingStatus != rhs.decodingStatus)
-  //       return false;
+    friend inline bool operator==(const FromBase64Result& lhs, const FromBase64Result& rhs) noexcept
+    {
+      if (lhs.decodingStatus != rhs.decodingStatus)
+        return false;
+      return lhs.decodingStatus != Base64DecodingStatus::Ok || lhs.decoded == rhs.decoded;
+    }
+  };
 
-  //     if (lhs.decodingStatus == ByteArray::Base64DecodingStatus::Ok &&
-  //         lhs.decoded != rhs.decoded)
-  //       return false;
+  // Fast 64-bit hash of the bytes (wyhash), the same for a ByteArray and a
+  // view of equal contents. Not a cryptographic hash and, with a fixed seed,
+  // not resistant to inputs crafted to collide; pass a secret seed for keys
+  // that come from untrusted sources.
+  BORON_NODISCARD BORON_EXPORT size_t hash(ByteArrayView key, size_t seed = 0) noexcept;
 
-  //     return true;
-  //   }
+  BORON_NODISCARD inline size_t hash(const ByteArray::FromBase64Result& key, size_t seed = 0) noexcept
+  {
+    // Failed results compare equal by status alone.
+    if (!key)
+      return hash(ByteArrayView(), seed ^ static_cast<size_t>(key.decodingStatus));
+    return hash(key.decoded, seed);
+  }
+
+  // Transparent functors for hashed containers keyed by ByteArray, so that
+  // lookups can take a ByteArrayView without building a temporary ByteArray:
+  //
+  //   std::unordered_map<ByteArray, int, ByteArrayHash, ByteArrayEqual> map;
+  //   map.find(ByteArrayView(buffer, length));
+  struct ByteArrayHash
+  {
+    using is_transparent = void;
 
-  //   friend inline bool
-  //   operator!=(const ByteArray::FromBase64Result &lhs,
-  //              const ByteArray::FromBase64Result &rhs) noexcept {
-  //     return !(lhs == rhs);
-  //   }
-  // };
+    size_t operator()(ByteArrayView key) const noexcept { return hash(key); }
+  };
 
-  // TODO: swap
-  // Q_DECLARE_SHARED(ByteArray::FromBase64Result)
+  struct ByteArrayEqual
+  {
+    using is_transparent = void;
 
-  // Q_CORE_EXPORT Q_DECL_PURE_FUNCTION size_t
-  // qHash(const ByteArray::FromBase64Result &key, size_t seed = 0) noexcept;
+    bool operator()(ByteArrayView lhs, ByteArrayView rhs) const noexcept { return lhs == rhs; }
+  };
 
   // template <typename T> size_t erase(ByteArray &ba, const T &t) {
   //   return ba.removeIf_helper([&t](const auto &e) { return t == e; });
@@ -925,4 +1436,16 @@ namespace Boron
   }
 } // namespace Boron
 
+template <>
+struct std::hash<Boron::ByteArrayView>
+{
+  size_t operator()(Boron::ByteArrayView key) const noexcept { return Boron::hash(key); }
+};
+
+template <>
+struct std::hash<Boron::ByteArray>
+{
+  size_t operator()(const Boron::ByteArray& key) const noexcept { return Boron::hash(key); }
+};
+
 #endif
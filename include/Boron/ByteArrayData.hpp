@@ -0,0 +1,285 @@
+#ifndef BORON_INCLUDE_BORON_BYTEARRAYDATA_HPP_
+#define BORON_INCLUDE_BORON_BYTEARRAYDATA_HPP_
+
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <utility>
+
+namespace Boron::Detail
+{
+  // Storage behind ByteArray. Payloads of up to kInlineCapacity bytes are kept
+  // inside the object itself, so short keys never touch the allocator. Longer
+  // ones live in a reference-counted heap block that is shared between copies
+  // and slices: each object only records where its bytes start in the block
+  // and how many there are. Writing through a shared block detaches first
+  // (copy-on-write); shrinking or dropping a prefix never writes, so those stay
+  // O(1) even while shared.
+  //
+  // Heap blocks can come from a std::pmr::memory_resource. The resource is
+  // recorded in the block, so it follows the payload through slices and
+  // reallocations without widening the object. An empty array bound to a
+  // resource has no block yet and keeps the resource where the inline bytes
+  // would go; otherwise bound arrays never use the inline representation,
+  // which would lose the binding.
+  //
+  // As with std::pmr containers, the resource belongs to the object rather
+  // than to its value: a copy is made on the global heap, and assignment
+  // keeps the resource of the array assigned to, sharing the block only when
+  // both use the same resource. Moves take the block along and leave the
+  // source empty but still bound.
+  //
+  // Both representations are three words. The last byte of the object is the
+  // size tag of the inline representation and overlaps the size word of the
+  // heap one, where a flag bit marks the heap case. Which bit that is depends
+  // on the byte order, the layout does not.
+  class BORON_EXPORT ByteArrayData
+  {
+  public:
+    static constexpr size_t kInlineCapacity = 3 * sizeof(void*) - 1;
+
+    ByteArrayData() noexcept { setInlineSize(0); }
+    explicit ByteArrayData(std::pmr::memory_resource* resource);
+    ByteArrayData(const byte* data, size_t size, std::pmr::memory_resource* resource = nullptr);
+    ByteArrayData(size_t size, byte c, std::pmr::memory_resource* resource = nullptr);
+
+    ByteArrayData(const ByteArrayData& other)
+    {
+      setInlineSize(0);
+      if (other.resource())
+        assign(other.data(), other.size());
+      else
+        share(other);
+    }
+
+    ByteArrayData(ByteArrayData&& other) noexcept : rep_(other.rep_) { other.setEmpty(resource()); }
+
+    ~ByteArrayData() { release(); }
+
+    ByteArrayData& operator=(const ByteArrayData& other)
+    {
+      if (resource() != other.resource())
+        assign(other.data(), other.size());
+      else if (this != &other)
+      {
+        ByteArrayData copy(resource());
+        copy.share(other);
+        swap(copy);
+      }
+      return *this;
+    }
+
+    ByteArrayData& operator=(ByteArrayData&& other)
+    {
+      if (resource() != other.resource())
+        assign(other.data(), other.size());
+      else if (this != &other)
+      {
+        release();
+        rep_ = other.rep_;
+        other.setEmpty(resource());
+      }
+      return *this;
+    }
+
+    void swap(ByteArrayData& other) noexcept { std::swap(rep_, other.rep_); }
+
+    BORON_NODISCARD bool isInline() const noexcept { return (tag() & kHeapFlag) == 0; }
+
+    BORON_NODISCARD bool isShared() const noexcept
+    {
+      return !isInline() && rep_.heap.block->refs.load(std::memory_order_acquire) != 1;
+    }
+
+    BORON_NODISCARD bool isSharedWith(const ByteArrayData& other) const noexcept
+    {
+      return !isInline() && !other.isInline() && rep_.heap.block == other.rep_.heap.block;
+    }
+
+    BORON_NODISCARD size_t size() const noexcept
+    {
+      // The mask clears kBoundFlag, leaving 0 for an unallocated array.
+      if (isInline())
+        return (kLittleEndian ? tag() : tag() >> 1) & kInlineSizeMask;
+      return kLittleEndian ? rep_.heap.size_word & ~kHeapSizeFlag : rep_.heap.size_word >> 1;
+    }
+
+    BORON_NODISCARD bool empty() const noexcept { return size() == 0; }
+
+    // The resource the payload is allocated from, nullptr for the global heap.
+    BORON_NODISCARD std::pmr::memory_resource* resource() const noexcept
+    {
+      if (!isInline())
+        return rep_.heap.block->resource;
+      std::pmr::memory_resource* resource = nullptr;
+      if (isUnallocated())
+        memcpy(&resource, rep_.small.data, sizeof(resource));
+      return resource;
+    }
+
+    // Bytes available from the start of this array to the end of its buffer.
+    BORON_NODISCARD size_t capacity() const noexcept
+    {
+      if (isInline())
+        return isUnallocated() ? 0 : kInlineCapacity;
+      return rep_.heap.block->capacity - (rep_.heap.data - rep_.heap.block->payload());
+    }
+
+    BORON_NODISCARD const byte* data() const noexcept { return isInline() ? rep_.small.data : rep_.heap.data; }
+    BORON_NODISCARD const byte* constData() const noexcept { return data(); }
+
+    // Mutable access detaches from other owners of the buffer.
+    BORON_NODISCARD byte* data()
+    {
+      detach();
+      return mutableData();
+    }
+
+    void detach()
+    {
+      if (isShared())
+        reallocate(size());
+    }
+
+    // A view of [pos, pos + n) that shares the buffer unless it fits inline and
+    // no resource is bound.
+    BORON_NODISCARD ByteArrayData sliced(size_t pos, size_t n) const;
+    // Narrows this array to [pos, pos + n) without copying heap payloads.
+    void sliceInPlace(size_t pos, size_t n);
+
+    void reserve(size_t capacity);
+    void shrinkToFit();
+    void clear() noexcept;
+    void resize(size_t size);
+    void resize(size_t size, byte c);
+    // Like resize(), but leaves the new bytes uninitialized.
+    void resizeForOverwrite(size_t size);
+    void assign(const byte* data, size_t size);
+    void assign(size_t size, byte c);
+    // The inserted bytes may alias the current contents.
+    void insert(size_t pos, const byte* data, size_t size);
+    void insert(size_t pos, size_t count, byte c);
+    void erase(size_t pos, size_t count);
+
+    void push_back(byte c)
+    {
+      const auto old_size = size();
+      if (old_size == capacity() || !isWritable())
+        reallocate(growCapacity(old_size + 1));
+      mutableData()[old_size] = c;
+      setSize(old_size + 1);
+    }
+
+  private:
+    static constexpr bool kLittleEndian = std::endian::native == std::endian::little;
+    static constexpr byte kHeapFlag = kLittleEndian ? 0x80 : 0x01;
+    static constexpr size_t kHeapSizeFlag = size_t(1) << (8 * sizeof(size_t) - 1);
+    // Tags an empty array bound to a resource but without a block. Inline
+    // sizes never reach it in either byte order.
+    static constexpr byte kBoundFlag = 0x40;
+    static constexpr byte kInlineSizeMask = 0x1F;
+
+    struct Block
+    {
+      std::atomic<size_t> refs;
+      size_t capacity;
+      std::pmr::memory_resource* resource;
+
+      byte* payload() noexcept { return reinterpret_cast<byte*>(this + 1); }
+    };
+
+    struct Heap
+    {
+      byte* data;
+      Block* block;
+      size_t size_word;
+    };
+
+    struct Inline
+    {
+      byte data[kInlineCapacity];
+      byte tag;
+    };
+
+    union Rep
+    {
+      Heap heap;
+      Inline small;
+    };
+
+    static_assert(sizeof(Heap) == sizeof(Inline));
+
+    // Read through the object representation, valid whichever member is active.
+    BORON_NODISCARD byte tag() const noexcept { return reinterpret_cast<const byte*>(&rep_)[sizeof(Rep) - 1]; }
+
+    BORON_NODISCARD bool isUnallocated() const noexcept { return tag() == kBoundFlag; }
+
+    BORON_NODISCARD byte* mutableData() noexcept { return isInline() ? rep_.small.data : rep_.heap.data; }
+
+    BORON_NODISCARD bool isWritable() const noexcept { return !isShared(); }
+
+    void setInlineSize(size_t size) noexcept
+    {
+      rep_.small.tag = static_cast<byte>(kLittleEndian ? size : size << 1);
+    }
+
+    // Empty, bound to resource if not nullptr, without allocating.
+    void setEmpty(std::pmr::memory_resource* resource) noexcept
+    {
+      setInlineSize(0);
+      if (resource)
+      {
+        memcpy(rep_.small.data, &resource, sizeof(resource));
+        rep_.small.tag = kBoundFlag;
+      }
+    }
+
+    // Overwrites this array with a shallow copy of other, sharing its block.
+    // The previous payload is not released.
+    void share(const ByteArrayData& other) noexcept
+    {
+      rep_ = other.rep_;
+      if (!isInline())
+        rep_.heap.block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void setHeap(byte* data, Block* block, size_t size) noexcept
+    {
+      rep_.heap.data = data;
+      rep_.heap.block = block;
+      rep_.heap.size_word = kLittleEndian ? size | kHeapSizeFlag : size << 1 | 1;
+    }
+
+    void setSize(size_t size) noexcept
+    {
+      if (!isInline())
+        setHeap(rep_.heap.data, rep_.heap.block, size);
+      else if (!isUnallocated())
+        setInlineSize(size);
+    }
+
+    BORON_NODISCARD size_t growCapacity(size_t required) const noexcept
+    {
+      return std::max(required, size() * 2);
+    }
+
+    // An empty, unshared array able to hold capacity bytes, allocated from
+    // resource when one is given. Nothing is allocated for no capacity.
+    static ByteArrayData withCapacity(size_t capacity, std::pmr::memory_resource* resource);
+    // Moves the contents into a new unshared buffer of the given capacity,
+    // inline when it fits.
+    void reallocate(size_t capacity);
+    void release() noexcept;
+
+    Rep rep_;
+  };
+} // namespace Boron::Detail
+
+#endif
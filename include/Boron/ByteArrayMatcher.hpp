@@ -0,0 +1,95 @@
+#ifndef BORON_INCLUDE_BORON_BYTEARRAYMATCHER_HPP_
+#define BORON_INCLUDE_BORON_BYTEARRAYMATCHER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Boron
+{
+  // Searches for one pattern in many haystacks. The pattern is preprocessed once
+  // in the constructor, so repeated searches for the same needle do not pay any
+  // setup cost per call.
+  //
+  // The strategy is picked from the length and the alphabet of the pattern:
+  //  - Simd: the runtime-dispatched first+last byte kernel, best for the common
+  //    short needles;
+  //  - TwoWay: Crochemore-Perrin, linear in the worst case, used for needles
+  //    built from very few distinct bytes where other filters degenerate;
+  //  - Horspool: bad-character skips, used for long needles over a large
+  //    alphabet where the average skip beats a vector stride.
+  class BORON_EXPORT ByteArrayMatcher
+  {
+  public:
+    enum class Strategy
+    {
+      Simd,
+      TwoWay,
+      Horspool,
+    };
+
+    ByteArrayMatcher() = default;
+    explicit ByteArrayMatcher(ByteArrayView pattern);
+    ByteArrayMatcher(ByteArrayView pattern, Strategy strategy);
+
+    void setPattern(ByteArrayView pattern);
+    void setPattern(ByteArrayView pattern, Strategy strategy);
+
+    BORON_NODISCARD ByteArrayView pattern() const { return pattern_; }
+    BORON_NODISCARD Strategy strategy() const { return strategy_; }
+
+    // Returns the position of the first match at or after from, or
+    // ByteArray::kNpos when there is none.
+    BORON_NODISCARD size_t indexIn(ByteArrayView haystack, size_t from = 0) const;
+
+    // Counts non-overlapping matches, the same way as ByteArray::count().
+    BORON_NODISCARD size_t countIn(ByteArrayView haystack) const;
+
+    // Calls func(pos) for every non-overlapping match, in order. If func
+    // returns something convertible to bool, returning false stops the scan.
+    template <typename Func>
+    void forEachMatch(ByteArrayView haystack, Func&& func) const
+    {
+      const auto step = pattern_.isEmpty() ? 1 : pattern_.size();
+      size_t pos = 0;
+      while ((pos = indexIn(haystack, pos)) != ByteArray::kNpos)
+      {
+        if constexpr (std::is_convertible_v<std::invoke_result_t<Func&, size_t>, bool>)
+        {
+          if (!func(pos))
+            return;
+        }
+        else
+        {
+          func(pos);
+        }
+        pos += step;
+        if (pos > haystack.size())
+          return;
+      }
+    }
+
+    BORON_NODISCARD static Strategy defaultStrategy(ByteArrayView pattern);
+
+  private:
+    size_t searchTwoWay(const byte* haystack, size_t size) const;
+    size_t searchHorspool(const byte* haystack, size_t size) const;
+
+    ByteArray pattern_;
+    Strategy strategy_ = Strategy::Simd;
+    // Two-Way: critical factorization of the pattern.
+    size_t suffix_ = 0;
+    size_t period_ = 1;
+    bool periodic_ = false;
+    // Horspool: bad-character shifts, only filled for that strategy.
+    std::array<size_t, 256> shift_{};
+  };
+} // namespace Boron
+
+#endif
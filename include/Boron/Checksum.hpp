@@ -0,0 +1,68 @@
+#ifndef BORON_INCLUDE_BORON_CHECKSUM_HPP_
+#define BORON_INCLUDE_BORON_CHECKSUM_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <cstdint>
+
+namespace Boron
+{
+  // Incremental checksums for data that arrives in pieces. Updating with the
+  // pieces of a buffer in order gives the same value as ByteArrayView::crc32(),
+  // crc32c() or adler32() of the whole buffer:
+  //
+  //   Crc32c crc;
+  //   for (auto chunk : chunks)
+  //     crc.update(chunk);
+  //   header.checksum = crc.value();
+  //
+  // A previous value may be passed to continue from it, as with zlib's
+  // crc32() and adler32().
+
+  // CRC-32 as in zlib, gzip, PNG and Ethernet (polynomial 0x04C11DB7).
+  class BORON_EXPORT Crc32
+  {
+  public:
+    explicit Crc32(uint32_t value = 0) : state_(~value) {}
+
+    Crc32& update(ByteArrayView data);
+    BORON_NODISCARD uint32_t value() const { return ~state_; }
+    void reset() { state_ = ~uint32_t{0}; }
+
+  private:
+    uint32_t state_;
+  };
+
+  // CRC-32C (Castagnoli, polynomial 0x1EDC6F41) as in iSCSI, ext4 and
+  // RocksDB, which SSE4.2 computes in hardware.
+  class BORON_EXPORT Crc32c
+  {
+  public:
+    explicit Crc32c(uint32_t value = 0) : state_(~value) {}
+
+    Crc32c& update(ByteArrayView data);
+    BORON_NODISCARD uint32_t value() const { return ~state_; }
+    void reset() { state_ = ~uint32_t{0}; }
+
+  private:
+    uint32_t state_;
+  };
+
+  // Adler-32 as in zlib streams.
+  class BORON_EXPORT Adler32
+  {
+  public:
+    explicit Adler32(uint32_t value = 1) : state_(value) {}
+
+    Adler32& update(ByteArrayView data);
+    BORON_NODISCARD uint32_t value() const { return state_; }
+    void reset() { state_ = 1; }
+
+  private:
+    uint32_t state_;
+  };
+} // namespace Boron
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef BORON_INCLUDE_BORON_COMPRESSION_HPP_
+#define BORON_INCLUDE_BORON_COMPRESSION_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Boron
+{
+  // Fast in-memory compression in the spirit of qCompress(), without zlib.
+  //
+  // Compressed data is a sequence of frames, one per block of up to
+  // kCompressionBlockSize input bytes. A frame is the varint size of its
+  // block, the varint size of its payload and the payload, which is an LZ4
+  // block or, with a payload size of 0, the block stored as is when it does
+  // not compress. Blocks are compressed independently, so matches reach at
+  // most 64 KiB back and never cross into the previous block.
+  //
+  // Empty input compresses to nothing.
+  constexpr size_t kCompressionBlockSize = 256 * 1024;
+
+  enum class UncompressStatus
+  {
+    Ok,
+    // A frame header or payload is malformed.
+    CorruptData,
+    // The data stops in the middle of a frame.
+    TruncatedData,
+  };
+
+  BORON_NODISCARD BORON_EXPORT ByteArray compress(ByteArrayView data);
+
+  // Returns an empty array if data is not the output of compress().
+  BORON_NODISCARD BORON_EXPORT ByteArray uncompress(ByteArrayView data);
+
+  // Replaces the contents of out with the uncompressed data. The size is
+  // read from the frame headers first, so out is resized once, and its
+  // buffer is reused when it is unshared and large enough. out is empty on
+  // failure.
+  BORON_EXPORT UncompressStatus uncompress(ByteArrayView data, ByteArray& out);
+
+  // The size uncompress() would produce, from the frame headers alone.
+  // Returns ByteArray::kNpos if the headers are malformed or truncated.
+  BORON_NODISCARD BORON_EXPORT size_t uncompressedSize(ByteArrayView data);
+
+  // Compresses a stream that arrives in chunks. The output is the same as
+  // compress() of the concatenated chunks:
+  //
+  //   Compressor compressor;
+  //   for (auto chunk : chunks)
+  //     compressor.feed(chunk, out);
+  //   compressor.finish(out);
+  //
+  // Input is collected until a block is complete; whole blocks of a chunk
+  // are compressed in place without being copied.
+  class BORON_EXPORT Compressor
+  {
+  public:
+    // Appends the frames completed by chunk to out.
+    void feed(ByteArrayView chunk, ByteArray& out);
+    // Appends the frame of the last, partial block to out and starts over.
+    void finish(ByteArray& out);
+    void reset() { pending_.clear(); }
+
+    // Bytes fed since the last frame was written.
+    BORON_NODISCARD size_t pendingSize() const { return pending_.size(); }
+
+  private:
+    ByteArray pending_;
+  };
+
+  // Uncompresses a stream that arrives in chunks, split anywhere:
+  //
+  //   Decompressor decompressor;
+  //   for (auto chunk : chunks)
+  //     decompressor.feed(chunk, out);
+  //   if (decompressor.finish() != UncompressStatus::Ok)
+  //     ...
+  //
+  // Frames that lie within a chunk are decoded straight from it; only a
+  // frame split between chunks is collected first.
+  class BORON_EXPORT Decompressor
+  {
+  public:
+    // Appends the blocks of the frames completed by chunk to out. Once an
+    // error has been detected further input is ignored.
+    UncompressStatus feed(ByteArrayView chunk, ByteArray& out);
+    // Checks that the stream did not stop in the middle of a frame.
+    UncompressStatus finish();
+    void reset();
+
+    BORON_NODISCARD UncompressStatus status() const { return status_; }
+
+  private:
+    // Decodes the complete frames at the start of data and returns the number
+    // of bytes they take.
+    size_t decodeFrames(ByteArrayView data, ByteArray& out);
+
+    ByteArray pending_;
+    UncompressStatus status_ = UncompressStatus::Ok;
+  };
+} // namespace Boron
+
+#endif
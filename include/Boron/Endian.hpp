@@ -0,0 +1,92 @@
+#ifndef BORON_INCLUDE_BORON_ENDIAN_HPP_
+#define BORON_INCLUDE_BORON_ENDIAN_HPP_
+
+#include "Boron/Common.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <cstdlib>
+#endif
+
+namespace Boron
+{
+  // Fixed-width values that can be stored as their object representation.
+  template <typename T>
+  concept BinaryScalar =
+    (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, float> || std::same_as<T, double>;
+
+  template <std::unsigned_integral T>
+  constexpr T byteSwap(T value) noexcept
+  {
+    if constexpr (sizeof(T) == 1)
+    {
+      return value;
+    }
+    else
+    {
+      if (!std::is_constant_evaluated())
+      {
+#if defined(__GNUC__) || defined(__clang__)
+        if constexpr (sizeof(T) == 2)
+          return __builtin_bswap16(value);
+        if constexpr (sizeof(T) == 4)
+          return __builtin_bswap32(value);
+        if constexpr (sizeof(T) == 8)
+          return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+        if constexpr (sizeof(T) == 2)
+          return _byteswap_ushort(value);
+        if constexpr (sizeof(T) == 4)
+          return _byteswap_ulong(value);
+        if constexpr (sizeof(T) == 8)
+          return _byteswap_uint64(value);
+#endif
+      }
+      T result = 0;
+      for (size_t i = 0; i < sizeof(T); i++)
+      {
+        result = static_cast<T>(result << 8 | (value & 0xFF));
+        value = static_cast<T>(value >> 8);
+      }
+      return result;
+    }
+  }
+
+  namespace Detail
+  {
+    template <typename T>
+    using UnsignedOfSize = std::conditional_t<
+      sizeof(T) == 1, uint8_t,
+      std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+  } // namespace Detail
+
+  // Writes value to out as sizeof(T) bytes in the given byte order. With the
+  // order fixed at compile time this is one store, plus a bswap when the
+  // order differs from the native one.
+  template <std::endian Endian, BinaryScalar T>
+  inline void storeEndian(T value, byte* out) noexcept
+  {
+    auto bits = std::bit_cast<Detail::UnsignedOfSize<T>>(value);
+    if constexpr (Endian != std::endian::native)
+      bits = byteSwap(bits);
+    std::memcpy(out, &bits, sizeof(bits));
+  }
+
+  template <BinaryScalar T, std::endian Endian>
+  inline T loadEndian(const byte* in) noexcept
+  {
+    Detail::UnsignedOfSize<T> bits;
+    std::memcpy(&bits, in, sizeof(bits));
+    if constexpr (Endian != std::endian::native)
+      bits = byteSwap(bits);
+    return std::bit_cast<T>(bits);
+  }
+} // namespace Boron
+
+#endif
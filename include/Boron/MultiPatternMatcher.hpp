@@ -0,0 +1,157 @@
+#ifndef BORON_INCLUDE_BORON_MULTIPATTERNMATCHER_HPP_
+#define BORON_INCLUDE_BORON_MULTIPATTERNMATCHER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Boron
+{
+  // Aho-Corasick automaton reporting every occurrence of every pattern in a
+  // single pass over the haystack.
+  //
+  // Bytes that occur in no pattern are folded into one equivalence class, so
+  // the transition rows only span the alphabet actually used by the patterns.
+  // States are numbered breadth-first and the shallowest ones - where a scan
+  // spends nearly all of its time - get complete transition rows in one dense
+  // table sized to stay cache resident. Deeper states keep sorted sparse edges
+  // and fall back through their failure links.
+  //
+  // Empty patterns are accepted, receive an id and are never reported.
+  class BORON_EXPORT MultiPatternMatcher
+  {
+  public:
+    struct Match
+    {
+      size_t pattern;
+      // Offset of the first byte of the occurrence.
+      size_t offset;
+
+      friend bool operator==(const Match&, const Match&) = default;
+    };
+
+    // Carries the automaton state across chunk boundaries, so occurrences that
+    // straddle two chunks are reported with offsets relative to the start of
+    // the stream.
+    class Stream
+    {
+    public:
+      explicit Stream(const MultiPatternMatcher& matcher) : matcher_(&matcher) {}
+
+      template <typename Func>
+      void feed(ByteArrayView chunk, Func&& func)
+      {
+        state_ = matcher_->scan(chunk, state_, consumed_, func);
+        consumed_ += chunk.size();
+      }
+
+      void reset()
+      {
+        state_ = 0;
+        consumed_ = 0;
+      }
+
+      BORON_NODISCARD size_t position() const { return consumed_; }
+
+    private:
+      const MultiPatternMatcher* matcher_;
+      uint32_t state_ = 0;
+      size_t consumed_ = 0;
+    };
+
+    MultiPatternMatcher() = default;
+
+    template <typename Range>
+    explicit MultiPatternMatcher(const Range& patterns)
+    {
+      for (const auto& pattern : patterns)
+        addPattern(pattern);
+      build();
+    }
+
+    // Returns the id of the pattern. The automaton has to be rebuilt before the
+    // next search.
+    size_t addPattern(ByteArrayView pattern);
+    void build();
+
+    BORON_NODISCARD size_t patternCount() const { return pattern_sizes_.size(); }
+    BORON_NODISCARD size_t stateCount() const { return fail_.size(); }
+    BORON_NODISCARD bool isBuilt() const { return built_; }
+
+    // Calls func(Match) for every occurrence, ordered by end position; matches
+    // ending at the same byte are reported longest first.
+    template <typename Func>
+    void forEachMatch(ByteArrayView haystack, Func&& func) const
+    {
+      scan(haystack, 0, 0, func);
+    }
+
+    BORON_NODISCARD std::vector<Match> findAll(ByteArrayView haystack) const;
+    BORON_NODISCARD bool containsAny(ByteArrayView haystack) const;
+
+  private:
+    static constexpr uint32_t kNoState = static_cast<uint32_t>(-1);
+    // Upper bound of dense table cells, 256 KiB of transitions.
+    static constexpr size_t kDenseCells = 64 * 1024;
+
+    uint32_t next(uint32_t state, uint16_t cls) const
+    {
+      while (state >= dense_states_)
+      {
+        const auto begin = edge_classes_.begin() + edge_start_[state];
+        const auto end = edge_classes_.begin() + edge_start_[state + 1];
+        const auto it = std::lower_bound(begin, end, cls);
+        if (it != end && *it == cls)
+          return edge_targets_[it - edge_classes_.begin()];
+        state = fail_[state];
+      }
+      return dense_[state * class_count_ + cls];
+    }
+
+    template <typename Func>
+    uint32_t scan(ByteArrayView haystack, uint32_t state, size_t base, Func& func) const
+    {
+      assert(built_);
+      const auto data = haystack.data();
+      for (size_t i = 0; i < haystack.size(); i++)
+      {
+        state = next(state, classes_[data[i]]);
+        for (auto s = has_output_[state] ? state : dict_link_[state]; s != kNoState; s = dict_link_[s])
+        {
+          for (auto o = output_start_[s]; o < output_start_[s + 1]; o++)
+          {
+            const auto id = outputs_[o];
+            func(Match{id, base + i + 1 - pattern_sizes_[id]});
+          }
+        }
+      }
+      return state;
+    }
+
+    std::vector<ByteArray> pending_;
+    std::vector<size_t> pattern_sizes_;
+    bool built_ = false;
+
+    std::array<uint16_t, 256> classes_{};
+    size_t class_count_ = 1;
+    uint32_t dense_states_ = 0;
+    std::vector<uint32_t> dense_;
+    std::vector<uint32_t> fail_;
+    std::vector<uint32_t> edge_start_;
+    std::vector<uint16_t> edge_classes_;
+    std::vector<uint32_t> edge_targets_;
+    std::vector<uint8_t> has_output_;
+    std::vector<uint32_t> dict_link_;
+    std::vector<uint32_t> output_start_;
+    std::vector<uint32_t> outputs_;
+  };
+} // namespace Boron
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef BORON_INCLUDE_BORON_PERCENTENCODER_HPP_
+#define BORON_INCLUDE_BORON_PERCENTENCODER_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Boron
+{
+  // Percent-encodes with a fixed set of bytes to escape, built once in the
+  // constructor, so encoding many strings the same way pays no setup per call.
+  //
+  // As with ByteArray::toPercentEncoding(), the RFC 3986 unreserved characters
+  // (ALPHA, DIGIT, '-', '.', '_' and '~') are kept, bytes in exclude are kept
+  // as well, bytes in include are escaped even if unreserved, and the percent
+  // character itself is always escaped. Escapes use upper case hex digits.
+  //
+  // Runs of bytes that are kept are found with a vector kernel and copied as a
+  // block; encode() sizes its output with one counting pass.
+  class BORON_EXPORT PercentEncoder
+  {
+  public:
+    explicit PercentEncoder(ByteArrayView exclude = {}, ByteArrayView include = {}, uint8_t percent = '%');
+
+    BORON_NODISCARD bool escapes(uint8_t c) const { return rows_[(c >> 7) * 16 + (c & 0x0F)] >> (c >> 4 & 7) & 1; }
+    BORON_NODISCARD uint8_t percent() const { return percent_; }
+
+    BORON_NODISCARD std::string encode(ByteArrayView input) const;
+    // Length of encode(input).
+    BORON_NODISCARD size_t encodedSize(ByteArrayView input) const;
+    // Writes encodedSize(input) characters to out without allocating and
+    // returns their number.
+    size_t encodeTo(ByteArrayView input, char* out) const;
+
+  private:
+    void setEscaped(uint8_t c, bool escaped);
+
+    // The 256-bit escape set, laid out for nibble lookups: bit (c >> 4) & 7 of
+    // rows_[(c >> 7) * 16 + (c & 0x0F)] is set when c is escaped.
+    std::array<byte, 32> rows_{};
+    uint8_t percent_;
+  };
+} // namespace Boron
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef BORON_INCLUDE_BORON_STRING_HPP_
+#define BORON_INCLUDE_BORON_STRING_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Boron
+{
+  namespace Detail
+  {
+    struct Utf8Index;
+  } // namespace Detail
+
+  // Unicode text, kept as well-formed UTF-8 in a ByteArray. Copies and
+  // slices longer than ByteArray::kInlineCapacity share the buffer as
+  // ByteArray does, and a String and a ByteArray move into one another
+  // without copying:
+  //
+  //   String text(std::move(bytes)); // validates, keeps the buffer
+  //   ByteArray back = std::move(text).utf8();
+  //
+  // Positions and lengths count code points. The first call that needs them
+  // builds an index of the byte offset of every kIndexStride-th code point,
+  // which copies share; at() and mid() then start from the nearest entry and
+  // skip fewer than kIndexStride code points, and length() is O(1). Text
+  // that is all ASCII needs no entries. Modifying a String drops its index.
+  // Building it is safe from concurrent const calls.
+  class BORON_EXPORT String
+  {
+  public:
+    static constexpr size_t kNpos = ByteArray::kNpos;
+    static constexpr size_t kIndexStride = 64;
+
+    String() noexcept = default;
+    // Takes over the buffer of utf8 if it is well-formed. Otherwise the text
+    // is a copy with every maximal malformed subpart replaced by U+FFFD.
+    explicit String(ByteArray utf8);
+    String(const String& other) noexcept;
+    String(String&& other) noexcept;
+    String& operator=(const String& other) noexcept;
+    String& operator=(String&& other) noexcept;
+    ~String();
+
+    BORON_NODISCARD static String fromStdString(const std::string& s);
+    // Unpaired surrogates become U+FFFD.
+    BORON_NODISCARD static String fromUtf16(std::u16string_view s);
+
+    BORON_NODISCARD const ByteArray& utf8() const & noexcept { return utf8_; }
+    // Moves the buffer out and leaves this string empty.
+    BORON_NODISCARD ByteArray utf8() &&;
+    BORON_NODISCARD std::string toStdString() const { return utf8_.toStdString(); }
+    BORON_NODISCARD std::u16string toUtf16() const { return utf8_.toUtf16(); }
+
+    BORON_NODISCARD bool isEmpty() const noexcept { return utf8_.isEmpty(); }
+    // Code points.
+    BORON_NODISCARD size_t length() const;
+    BORON_NODISCARD char32_t at(size_t i) const;
+    BORON_NODISCARD char32_t operator[](size_t i) const { return at(i); }
+    // Byte offset of code point i in utf8(), for i up to length().
+    BORON_NODISCARD size_t utf8Offset(size_t i) const;
+
+    // Clamps index and len to the string, like ByteArray::mid(). The result
+    // shares the buffer of this string.
+    BORON_NODISCARD String mid(size_t index, size_t len = kNpos) const &;
+    BORON_NODISCARD String mid(size_t index, size_t len = kNpos) &&;
+
+    String& append(const String& s);
+    String& operator+=(const String& s) { return append(s); }
+
+    BORON_NODISCARD friend bool operator==(const String& lhs, const String& rhs) noexcept
+    {
+      return lhs.utf8_ == rhs.utf8_;
+    }
+
+    // Byte order of UTF-8 is code point order.
+    BORON_NODISCARD friend auto operator<=>(const String& lhs, const String& rhs) noexcept
+    {
+      return lhs.utf8_ <=> rhs.utf8_;
+    }
+
+  private:
+    // For text known to be well-formed, with its index if there is one.
+    String(ByteArray utf8, const Detail::Utf8Index* index) noexcept;
+
+    const Detail::Utf8Index& index() const;
+    void dropIndex() noexcept;
+
+    ByteArray utf8_;
+    mutable std::atomic<const Detail::Utf8Index*> index_{nullptr};
+  };
+
+  BORON_NODISCARD inline size_t hash(const String& key, size_t seed = 0) noexcept
+  {
+    return hash(key.utf8(), seed);
+  }
+} // namespace Boron
+
+template <>
+struct std::hash<Boron::String>
+{
+  size_t operator()(const Boron::String& key) const noexcept { return Boron::hash(key); }
+};
+
+#endif
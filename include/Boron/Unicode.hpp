@@ -0,0 +1,55 @@
+#ifndef BORON_INCLUDE_BORON_UNICODE_HPP_
+#define BORON_INCLUDE_BORON_UNICODE_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace Boron
+{
+  // Validation of UTF-8 and strict conversion between UTF-8, UTF-16 and
+  // UTF-32 into caller-provided buffers. Well-formed means what the Unicode
+  // standard says: no overlong forms, no surrogates, nothing above U+10FFFF,
+  // and in UTF-16 no unpaired surrogates. See ByteArrayView::toUtf16() and
+  // ByteArray::fromUtf16() for conversions that replace malformed input with
+  // U+FFFD instead of failing.
+
+  // With AVX2, 64 bytes are checked per step with the lookup tables of
+  // Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per
+  // Byte"; blocks of ASCII skip the tables.
+  BORON_NODISCARD BORON_EXPORT bool isValidUtf8(ByteArrayView data) noexcept;
+
+  struct TranscodeResult
+  {
+    // Code units written, up to the first malformed sequence.
+    size_t written = 0;
+    // Offset in code units of the first malformed sequence of the input,
+    // ByteArray::kNpos if there is none.
+    size_t errorPosition = ByteArray::kNpos;
+
+    explicit operator bool() const noexcept { return errorPosition == ByteArray::kNpos; }
+  };
+
+  // Code units the conversion of well-formed input produces. Counting does not
+  // validate; for malformed input the result is only an estimate.
+  BORON_NODISCARD BORON_EXPORT size_t utf16LengthOfUtf8(ByteArrayView utf8) noexcept;
+  BORON_NODISCARD BORON_EXPORT size_t utf32LengthOfUtf8(ByteArrayView utf8) noexcept;
+  BORON_NODISCARD BORON_EXPORT size_t utf8LengthOfUtf16(std::u16string_view utf16) noexcept;
+  BORON_NODISCARD BORON_EXPORT size_t utf8LengthOfUtf32(std::u32string_view utf32) noexcept;
+
+  // Each conversion stops at the first malformed sequence. out needs room for
+  // the length given by the functions above, or for the worst case: one unit
+  // per byte from UTF-8, three bytes per UTF-16 unit and four per code point.
+  // With SSE4.1, well-formed UTF-8 is converted several characters at a time
+  // by table-driven shuffles, and UTF-16 and UTF-32 eight and four units at a
+  // time; otherwise runs of ASCII are converted in blocks.
+  BORON_EXPORT TranscodeResult utf8ToUtf16(ByteArrayView utf8, char16_t* out) noexcept;
+  BORON_EXPORT TranscodeResult utf8ToUtf32(ByteArrayView utf8, char32_t* out) noexcept;
+  BORON_EXPORT TranscodeResult utf16ToUtf8(std::u16string_view utf16, byte* out) noexcept;
+  BORON_EXPORT TranscodeResult utf32ToUtf8(std::u32string_view utf32, byte* out) noexcept;
+} // namespace Boron
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef BORON_INCLUDE_BORON_VARINT_HPP_
+#define BORON_INCLUDE_BORON_VARINT_HPP_
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/Global.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Boron
+{
+  // Variable-length integers as in LEB128 and protobuf: seven bits per byte,
+  // least significant group first, the top bit set on every byte but the last.
+  // A 64-bit value takes 1 to 10 bytes.
+  constexpr size_t kMaxVarintSize = 10;
+
+  BORON_NODISCARD constexpr size_t varintSize(uint64_t value) noexcept
+  {
+    return (static_cast<size_t>(std::bit_width(value | 1)) + 6) / 7;
+  }
+
+  // Maps signed values to unsigned ones so that small magnitudes of either
+  // sign get short varints: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+  BORON_NODISCARD constexpr uint64_t zigZagEncode(int64_t value) noexcept
+  {
+    return static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  BORON_NODISCARD constexpr int64_t zigZagDecode(uint64_t value) noexcept
+  {
+    return static_cast<int64_t>(value >> 1 ^ (0 - (value & 1)));
+  }
+
+  // Writes varintSize(value) bytes to out and returns their number.
+  inline size_t encodeVarint(uint64_t value, byte* out) noexcept
+  {
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+      out[size++] = static_cast<byte>(value | 0x80);
+      value >>= 7;
+    }
+    out[size++] = static_cast<byte>(value);
+    return size;
+  }
+
+  // Reads the varint at the start of in and returns its size, or 0 if it is
+  // truncated or does not fit in 64 bits. Padded forms such as 80 00 are
+  // accepted, as protobuf does.
+  inline size_t decodeVarint(const byte* in, size_t size, uint64_t& value) noexcept
+  {
+    uint64_t result = 0;
+    const auto n = std::min(size, kMaxVarintSize);
+    for (size_t i = 0; i < n; i++)
+    {
+      const uint64_t b = in[i];
+      result |= (b & 0x7F) << 7 * i;
+      if (b < 0x80)
+      {
+        // The tenth byte holds bit 63 only.
+        if (i == kMaxVarintSize - 1 && b > 1)
+          return 0;
+        value = result;
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+
+  struct DecodeVarintsResult
+  {
+    // Number of values written.
+    size_t count = 0;
+    // Number of input bytes they took.
+    size_t consumed = 0;
+  };
+
+  // Decodes consecutive varints from input into out until either is used up
+  // or a varint is malformed or truncated; consumed < input.size() with room
+  // left in out means the latter. Varints of one or two bytes are decoded
+  // eight at a time with one table lookup and shuffle where SSSE3 is
+  // available, longer ones with a branch per value rather than per byte.
+  BORON_EXPORT DecodeVarintsResult decodeVarints(ByteArrayView input, std::span<uint64_t> out);
+} // namespace Boron
+
+#endif
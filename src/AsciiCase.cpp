@@ -0,0 +1,357 @@
+#include "AsciiCase.hpp"
+#include "Boron/Endian.hpp"
+#include "ByteArrayAlgorithms.hpp"
+#include "CpuFeatures.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    // Upper and lower case letters differ in this bit alone. Each kernel takes
+    // the first letter of the range it works on: with 'A' it flips upper case
+    // to lower, with 'a' lower case to upper.
+    constexpr byte kCaseBit = 0x20;
+    constexpr uint64_t kHighBits = 0x8080808080808080;
+    constexpr uint64_t kLowBits = 0x0101010101010101;
+
+    using FlipFn = void (*)(const byte* in, size_t size, byte* out, byte first);
+    using ContainsFn = bool (*)(const byte* data, size_t size, byte first);
+    // Offset of the first byte that differs after folding, size if none does.
+    using MismatchFn = size_t (*)(const byte* a, const byte* b, size_t size);
+    // Same contract as the kernels of findByteArray(), with needle_size of at
+    // least 1.
+    using FindFn = size_t (*)(const byte* haystack, size_t size, const byte* needle, size_t needle_size);
+
+    constexpr bool isInRange(byte b, byte first) { return static_cast<byte>(b - first) < 26; }
+    constexpr byte foldByte(byte b) { return isInRange(b, 'A') ? b | kCaseBit : b; }
+
+    uint64_t load64(const byte* p)
+    {
+      return loadEndian<uint64_t, std::endian::little>(p);
+    }
+
+    // The high bit of every byte of word in first..first + 25. Only ASCII
+    // bytes are added to, so no sum carries into the next byte.
+    uint64_t letterBits(uint64_t word, byte first)
+    {
+      const auto heptets = word & ~kHighBits;
+      const auto at_least_first = heptets + kLowBits * (0x80 - first);
+      const auto past_last = heptets + kLowBits * (0x80 - first - 26);
+      return at_least_first & ~past_last & ~word & kHighBits;
+    }
+
+    uint64_t foldWord(uint64_t word)
+    {
+      return word | letterBits(word, 'A') >> 2;
+    }
+
+    void flipCaseScalar(const byte* in, size_t size, byte* out, byte first)
+    {
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8)
+      {
+        const auto word = load64(in + i);
+        storeEndian<std::endian::little>(word ^ letterBits(word, first) >> 2, out + i);
+      }
+      for (; i < size; i++)
+        out[i] = isInRange(in[i], first) ? in[i] ^ kCaseBit : in[i];
+    }
+
+    bool containsCaseScalar(const byte* data, size_t size, byte first)
+    {
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8)
+      {
+        if (letterBits(load64(data + i), first))
+          return true;
+      }
+      return std::any_of(data + i, data + size, [first](byte b) { return isInRange(b, first); });
+    }
+
+    size_t mismatchScalar(const byte* a, const byte* b, size_t size)
+    {
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8)
+      {
+        const auto diff = foldWord(load64(a + i)) ^ foldWord(load64(b + i));
+        if (diff)
+          return i + std::countr_zero(diff) / 8;
+      }
+      for (; i < size; i++)
+      {
+        if (foldByte(a[i]) != foldByte(b[i]))
+          return i;
+      }
+      return size;
+    }
+
+    // The middle of the needle, between the first and the last byte the
+    // filters compare.
+    bool middleMatches(const byte* candidate, const byte* needle, size_t needle_size, MismatchFn mismatch)
+    {
+      return needle_size <= 2 || mismatch(candidate + 1, needle + 1, needle_size - 2) == needle_size - 2;
+    }
+
+    size_t findScalar(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = foldByte(needle[0]);
+      const auto last = foldByte(needle[needle_size - 1]);
+      for (size_t pos = 0; pos + needle_size <= size; pos++)
+      {
+        if (foldByte(haystack[pos]) == first && foldByte(haystack[pos + needle_size - 1]) == last &&
+            middleMatches(haystack + pos, needle, needle_size, mismatchScalar))
+          return pos;
+      }
+      return kNotFound;
+    }
+
+#if BORON_ARCH_X86
+    // Letters move to the bottom of the signed range, where one compare
+    // finds them.
+    BORON_TARGET("sse2")
+    __m128i letterMaskSse2(__m128i v, byte first)
+    {
+      const auto shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+      return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+    }
+
+    BORON_TARGET("sse2")
+    __m128i foldSse2(__m128i v)
+    {
+      return _mm_or_si128(v, _mm_and_si128(letterMaskSse2(v, 'A'), _mm_set1_epi8(kCaseBit)));
+    }
+
+    BORON_TARGET("sse2")
+    void flipCaseSse2(const byte* in, size_t size, byte* out, byte first)
+    {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const auto flip = _mm_and_si128(letterMaskSse2(v, first), _mm_set1_epi8(kCaseBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(v, flip));
+      }
+      flipCaseScalar(in + i, size - i, out + i, first);
+    }
+
+    BORON_TARGET("sse2")
+    bool containsCaseSse2(const byte* data, size_t size, byte first)
+    {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(letterMaskSse2(v, first)))
+          return true;
+      }
+      return containsCaseScalar(data + i, size - i, first);
+    }
+
+    BORON_TARGET("sse2")
+    size_t mismatchSse2(const byte* a, const byte* b, size_t size)
+    {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto va = foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const auto vb = foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const auto diff = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xFFFF;
+        if (diff)
+          return i + std::countr_zero(diff);
+      }
+      return i + mismatchScalar(a + i, b + i, size - i);
+    }
+
+    BORON_TARGET("sse2")
+    size_t findSse2(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = _mm_set1_epi8(static_cast<char>(foldByte(needle[0])));
+      const auto last = _mm_set1_epi8(static_cast<char>(foldByte(needle[needle_size - 1])));
+      const auto candidates = size - needle_size + 1;
+      size_t i = 0;
+      for (; i + 16 <= candidates; i += 16)
+      {
+        const auto block_first = foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i)));
+        const auto block_last =
+          foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needle_size - 1)));
+        auto mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+          const auto pos = i + std::countr_zero(mask);
+          if (middleMatches(haystack + pos, needle, needle_size, mismatchSse2))
+            return pos;
+          mask &= mask - 1;
+        }
+      }
+      const auto pos = findScalar(haystack + i, size - i, needle, needle_size);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx2")
+    __m256i letterMaskAvx2(__m256i v, byte first)
+    {
+      const auto shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - first)));
+      return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)), shifted);
+    }
+
+    BORON_TARGET("avx2")
+    __m256i foldAvx2(__m256i v)
+    {
+      return _mm256_or_si256(v, _mm256_and_si256(letterMaskAvx2(v, 'A'), _mm256_set1_epi8(kCaseBit)));
+    }
+
+    BORON_TARGET("avx2")
+    void flipCaseAvx2(const byte* in, size_t size, byte* out, byte first)
+    {
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const auto flip = _mm256_and_si256(letterMaskAvx2(v, first), _mm256_set1_epi8(kCaseBit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(v, flip));
+      }
+      _mm256_zeroupper();
+      flipCaseSse2(in + i, size - i, out + i, first);
+    }
+
+    BORON_TARGET("avx2")
+    bool containsCaseAvx2(const byte* data, size_t size, byte first)
+    {
+      size_t i = 0;
+      bool found = false;
+      for (; i + 32 <= size && !found; i += 32)
+      {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        found = _mm256_movemask_epi8(letterMaskAvx2(v, first)) != 0;
+      }
+      _mm256_zeroupper();
+      return found || containsCaseSse2(data + i, size - i, first);
+    }
+
+    BORON_TARGET("avx2")
+    size_t mismatchAvx2(const byte* a, const byte* b, size_t size)
+    {
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto va = foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        const auto vb = foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const auto diff = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+        if (diff)
+        {
+          _mm256_zeroupper();
+          return i + std::countr_zero(diff);
+        }
+      }
+      _mm256_zeroupper();
+      return i + mismatchSse2(a + i, b + i, size - i);
+    }
+
+    BORON_TARGET("avx2")
+    size_t findAvx2(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = _mm256_set1_epi8(static_cast<char>(foldByte(needle[0])));
+      const auto last = _mm256_set1_epi8(static_cast<char>(foldByte(needle[needle_size - 1])));
+      const auto candidates = size - needle_size + 1;
+      size_t i = 0;
+      for (; i + 32 <= candidates; i += 32)
+      {
+        const auto block_first = foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i)));
+        const auto block_last =
+          foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needle_size - 1)));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+          const auto pos = i + std::countr_zero(mask);
+          if (middleMatches(haystack + pos, needle, needle_size, mismatchAvx2))
+            return pos;
+          mask &= mask - 1;
+        }
+      }
+      _mm256_zeroupper();
+      const auto pos = findSse2(haystack + i, size - i, needle, needle_size);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+#endif
+
+    struct CaseKernels
+    {
+      FlipFn flip;
+      ContainsFn contains;
+      MismatchFn mismatch;
+      FindFn find;
+    };
+
+    CaseKernels selectCaseKernels()
+    {
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx2)
+        return {flipCaseAvx2, containsCaseAvx2, mismatchAvx2, findAvx2};
+      if (features.sse2)
+        return {flipCaseSse2, containsCaseSse2, mismatchSse2, findSse2};
+#endif
+      return {flipCaseScalar, containsCaseScalar, mismatchScalar, findScalar};
+    }
+  } // namespace
+
+  void asciiToLower(const byte* in, size_t size, byte* out)
+  {
+    dispatched<selectCaseKernels>().flip(in, size, out, 'A');
+  }
+
+  void asciiToUpper(const byte* in, size_t size, byte* out)
+  {
+    dispatched<selectCaseKernels>().flip(in, size, out, 'a');
+  }
+
+  bool containsAsciiUpper(ByteArrayView data)
+  {
+    return dispatched<selectCaseKernels>().contains(data.data(), data.size(), 'A');
+  }
+
+  bool containsAsciiLower(ByteArrayView data)
+  {
+    return dispatched<selectCaseKernels>().contains(data.data(), data.size(), 'a');
+  }
+
+  int compareCaseInsensitive(ByteArrayView lhs, ByteArrayView rhs)
+  {
+    const auto size = std::min(lhs.size(), rhs.size());
+    const auto pos = dispatched<selectCaseKernels>().mismatch(lhs.data(), rhs.data(), size);
+    if (pos < size)
+      return foldByte(lhs[pos]) < foldByte(rhs[pos]) ? -1 : 1;
+    if (lhs.size() == rhs.size())
+      return 0;
+    return lhs.size() < rhs.size() ? -1 : 1;
+  }
+
+  bool equalsCaseInsensitive(ByteArrayView lhs, ByteArrayView rhs)
+  {
+    return lhs.size() == rhs.size() &&
+           dispatched<selectCaseKernels>().mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+  }
+
+  size_t findCaseInsensitive(ByteArrayView haystack, size_t from, ByteArrayView needle)
+  {
+    const auto l = haystack.size();
+    if (needle.empty())
+      return from > l ? kNotFound : from;
+    if (from > l || needle.size() > l - from)
+      return kNotFound;
+    const auto pos =
+      dispatched<selectCaseKernels>().find(haystack.data() + from, l - from, needle.data(), needle.size());
+    return pos == kNotFound ? kNotFound : pos + from;
+  }
+} // namespace Boron::Detail
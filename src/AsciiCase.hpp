@@ -0,0 +1,27 @@
+#ifndef BORON_SRC_ASCIICASE_HPP_
+#define BORON_SRC_ASCIICASE_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // ASCII case handling without the C locale: only A-Z and a-z have a case,
+  // every other byte, including those above 0x7F, is left alone.
+
+  // Convert size bytes from in to out, which may be the same buffer.
+  void asciiToLower(const byte* in, size_t size, byte* out);
+  void asciiToUpper(const byte* in, size_t size, byte* out);
+
+  bool containsAsciiUpper(ByteArrayView data);
+  bool containsAsciiLower(ByteArrayView data);
+
+  // Ordered like memcmp of both folded to lower case: -1, 0 or 1.
+  int compareCaseInsensitive(ByteArrayView lhs, ByteArrayView rhs);
+  bool equalsCaseInsensitive(ByteArrayView lhs, ByteArrayView rhs);
+
+  // findByteArray() ignoring case. Blocks of candidate positions are folded
+  // in registers, the haystack is never copied.
+  size_t findCaseInsensitive(ByteArrayView haystack, size_t from, ByteArrayView needle);
+} // namespace Boron::Detail
+
+#endif
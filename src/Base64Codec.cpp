@@ -0,0 +1,218 @@
+#include "Base64Codec.hpp"
+#include "CpuFeatures.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr char kStandardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    constexpr char kUrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    constexpr std::array<byte, 256> sextetTable(const char* alphabet)
+    {
+      std::array<byte, 256> table{};
+      table.fill(kInvalidSextet);
+      for (byte i = 0; i < 64; i++)
+        table[static_cast<byte>(alphabet[i])] = i;
+      return table;
+    }
+
+    constexpr auto kStandardSextets = sextetTable(kStandardAlphabet);
+    constexpr auto kUrlSextets = sextetTable(kUrlAlphabet);
+
+    // Block kernels: encoders take whole 3-byte groups and return how many
+    // input bytes they consumed, decoders follow decodeBase64Blocks().
+    using EncodeFn = size_t (*)(const byte* data, size_t size, char* out, bool url);
+    using DecodeFn = size_t (*)(const byte* in, size_t size, byte* out, bool url);
+
+    size_t encodeBase64Scalar(const byte* data, size_t size, char* out, bool url)
+    {
+      const auto alphabet = url ? kUrlAlphabet : kStandardAlphabet;
+      size_t i = 0;
+      for (; i + 3 <= size; i += 3)
+      {
+        const uint32_t group = data[i] << 16 | data[i + 1] << 8 | data[i + 2];
+        *out++ = alphabet[group >> 18];
+        *out++ = alphabet[group >> 12 & 0x3F];
+        *out++ = alphabet[group >> 6 & 0x3F];
+        *out++ = alphabet[group & 0x3F];
+      }
+      return i;
+    }
+
+    size_t decodeBase64Scalar(const byte* in, size_t size, byte* out, bool url)
+    {
+      const auto& sextets = url ? kUrlSextets : kStandardSextets;
+      size_t i = 0;
+      for (; i + 4 <= size; i += 4)
+      {
+        const auto a = sextets[in[i]], b = sextets[in[i + 1]], c = sextets[in[i + 2]], d = sextets[in[i + 3]];
+        if ((a | b | c | d) == kInvalidSextet)
+          break;
+        const uint32_t group = a << 18 | b << 12 | c << 6 | d;
+        *out++ = static_cast<byte>(group >> 16);
+        *out++ = static_cast<byte>(group >> 8);
+        *out++ = static_cast<byte>(group);
+      }
+      return i;
+    }
+
+#if BORON_ARCH_X86
+    // Encoding follows Muła and Lemire: every 3-byte group is spread over a
+    // 32-bit lane with pshufb, the four sextets are moved into separate bytes
+    // with two multiplies, and a second pshufb maps each sextet range to the
+    // offset that turns it into its character.
+    BORON_TARGET("avx2")
+    size_t encodeBase64Avx2(const byte* data, size_t size, char* out, bool url)
+    {
+      const auto spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, //
+                                           1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+      const char c62 = url ? '-' : '+';
+      const char c63 = url ? '_' : '/';
+      const auto offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0,
+                                            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, c62 - 62, c63 - 63, 'A', 0, 0);
+      size_t i = 0;
+      // Each lane loads 16 bytes and uses 12 of them.
+      for (; i + 28 <= size; i += 24)
+      {
+        const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+        const auto input = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), spread);
+        const auto ac = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)),
+                                           _mm256_set1_epi32(0x04000040));
+        const auto bd = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)),
+                                           _mm256_set1_epi32(0x01000010));
+        const auto sextets = _mm256_or_si256(ac, bd);
+        // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+        auto range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        const auto upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+        range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        const auto chars = _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 3 * 4), chars);
+      }
+      _mm256_zeroupper();
+      return i + encodeBase64Scalar(data + i, size - i, out + i / 3 * 4, url);
+    }
+
+    // Sextet values of 32 characters, checked by ranges so that both
+    // alphabets share the kernel. valid gets 0xFF for alphabet characters.
+    BORON_TARGET("avx2")
+    __m256i sextetsAvx2(__m256i chars, __m256i c62, __m256i c63, __m256i& valid)
+    {
+      const auto upper = _mm256_sub_epi8(chars, _mm256_set1_epi8('A'));
+      const auto lower = _mm256_sub_epi8(chars, _mm256_set1_epi8('a'));
+      const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+      const auto is_upper = _mm256_cmpeq_epi8(_mm256_min_epu8(upper, _mm256_set1_epi8(25)), upper);
+      const auto is_lower = _mm256_cmpeq_epi8(_mm256_min_epu8(lower, _mm256_set1_epi8(25)), lower);
+      const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+      const auto is_62 = _mm256_cmpeq_epi8(chars, c62);
+      const auto is_63 = _mm256_cmpeq_epi8(chars, c63);
+      valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(is_upper, is_lower), _mm256_or_si256(is_digit, is_62)),
+                              is_63);
+      auto value = _mm256_and_si256(is_upper, upper);
+      value = _mm256_or_si256(value, _mm256_and_si256(is_lower, _mm256_add_epi8(lower, _mm256_set1_epi8(26))));
+      value = _mm256_or_si256(value, _mm256_and_si256(is_digit, _mm256_add_epi8(digit, _mm256_set1_epi8(52))));
+      value = _mm256_or_si256(value, _mm256_and_si256(is_62, _mm256_set1_epi8(62)));
+      return _mm256_or_si256(value, _mm256_and_si256(is_63, _mm256_set1_epi8(63)));
+    }
+
+    BORON_TARGET("avx2")
+    size_t decodeBase64Avx2(const byte* in, size_t size, byte* out, bool url)
+    {
+      const auto c62 = _mm256_set1_epi8(url ? '-' : '+');
+      const auto c63 = _mm256_set1_epi8(url ? '_' : '/');
+      // Packs the 3 bytes of every 32-bit lane to the front of its 128-bit
+      // lane, then the two 12-byte halves next to each other.
+      const auto gather = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, //
+                                           2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+      const auto compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        __m256i valid;
+        const auto sextets = sextetsAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), c62, c63, valid);
+        if (_mm256_movemask_epi8(valid) != -1)
+          break;
+        // (a << 6 | b) and (c << 6 | d) in 16 bits, then both in 24 bits.
+        const auto pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        const auto groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const auto bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(groups, gather), compact);
+        // Exactly 24 bytes, the caller sized out for the decoded data only.
+        const auto dst = out + i / 4 * 3;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(bytes, 1));
+      }
+      _mm256_zeroupper();
+      return i + decodeBase64Scalar(in + i, size - i, out + i / 4 * 3, url);
+    }
+#endif
+
+    struct Base64Kernels
+    {
+      EncodeFn encode;
+      DecodeFn decode;
+    };
+
+    Base64Kernels selectBase64Kernels()
+    {
+#if BORON_ARCH_X86
+      if (cpuFeatures().avx2)
+        return {encodeBase64Avx2, decodeBase64Avx2};
+#endif
+      return {encodeBase64Scalar, decodeBase64Scalar};
+    }
+  } // namespace
+
+  size_t base64EncodedSize(size_t size, bool pad)
+  {
+    return pad ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+  }
+
+  void encodeBase64(const byte* data, size_t size, char* out, bool url, bool pad)
+  {
+    const auto done = dispatched<selectBase64Kernels>().encode(data, size, out, url);
+    const auto alphabet = url ? kUrlAlphabet : kStandardAlphabet;
+    out += done / 3 * 4;
+    switch (size - done)
+    {
+    case 1:
+      *out++ = alphabet[data[done] >> 2];
+      *out++ = alphabet[(data[done] & 0x03) << 4];
+      if (pad)
+      {
+        *out++ = '=';
+        *out++ = '=';
+      }
+      break;
+    case 2:
+      *out++ = alphabet[data[done] >> 2];
+      *out++ = alphabet[(data[done] & 0x03) << 4 | data[done + 1] >> 4];
+      *out++ = alphabet[(data[done + 1] & 0x0F) << 2];
+      if (pad)
+        *out++ = '=';
+      break;
+    default:
+      break;
+    }
+  }
+
+  byte base64Sextet(byte c, bool url)
+  {
+    return (url ? kUrlSextets : kStandardSextets)[c];
+  }
+
+  size_t decodeBase64Blocks(const byte* in, size_t size, byte* out, bool url)
+  {
+    return dispatched<selectBase64Kernels>().decode(in, size, out, url);
+  }
+} // namespace Boron::Detail
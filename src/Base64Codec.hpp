@@ -0,0 +1,25 @@
+#ifndef BORON_SRC_BASE64CODEC_HPP_
+#define BORON_SRC_BASE64CODEC_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  constexpr byte kInvalidSextet = 0xFF;
+
+  size_t base64EncodedSize(size_t size, bool pad);
+  // Writes base64EncodedSize(size, pad) characters of the standard or the URL
+  // alphabet.
+  void encodeBase64(const byte* data, size_t size, char* out, bool url, bool pad);
+
+  // Value of c in the alphabet, kInvalidSextet for anything else.
+  byte base64Sextet(byte c, bool url);
+
+  // Decodes the longest prefix of input made of whole blocks containing only
+  // alphabet characters. Returns the number of characters consumed, a multiple
+  // of four, and writes three bytes per four of them. Whatever follows,
+  // padding, separators, errors or a short tail, is left to the caller.
+  size_t decodeBase64Blocks(const byte* in, size_t size, byte* out, bool url);
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,113 @@
+#include "Boron/Base64Decoder.hpp"
+
+#include "Base64Codec.hpp"
+
+namespace Boron
+{
+  size_t Base64Decoder::feed(ByteArrayView chunk, uint8_t* out)
+  {
+    const auto begin = out;
+    const auto in = chunk.data();
+    const auto size = chunk.size();
+    size_t i = 0;
+    while (i < size && !finished_ && status_ == Base64DecodingStatus::Ok)
+    {
+      if (pending_ == 0 && padding_ == 0)
+      {
+        // On a group boundary: take as many whole blocks as possible at once.
+        const auto n = Detail::decodeBase64Blocks(in + i, size - i, out, url());
+        i += n;
+        out += n / 4 * 3;
+        if (i == size)
+          break;
+      }
+
+      const auto c = in[i];
+      const auto sextet = Detail::base64Sextet(c, url());
+      if (sextet != Detail::kInvalidSextet)
+      {
+        // Only strict decoding gets past padding.
+        if (padding_)
+        {
+          fail(Base64DecodingStatus::IllegalPadding, consumed_ + i);
+          break;
+        }
+        bits_ = bits_ << 6 | sextet;
+        if (++pending_ == 4)
+          out += flush(out);
+      }
+      else if (c == '=')
+      {
+        if (!strict())
+        {
+          out += flush(out);
+          finished_ = true;
+          break;
+        }
+        if (pending_ < 2 || pending_ + padding_ >= 4)
+        {
+          fail(Base64DecodingStatus::IllegalPadding, consumed_ + i);
+          break;
+        }
+        if (pending_ + ++padding_ == 4)
+          out += flush(out);
+      }
+      else if (strict())
+      {
+        fail(Base64DecodingStatus::IllegalCharacter, consumed_ + i);
+        break;
+      }
+      ++i;
+    }
+    consumed_ += size;
+    return out - begin;
+  }
+
+  size_t Base64Decoder::finish(uint8_t* out)
+  {
+    if (status_ != Base64DecodingStatus::Ok || finished_)
+      return 0;
+    finished_ = true;
+    if (padding_)
+    {
+      // Strict decoding flushed the group when its padding was complete.
+      if (pending_)
+        fail(Base64DecodingStatus::IllegalPadding, consumed_);
+      return 0;
+    }
+    if (strict() && pending_ == 1)
+    {
+      fail(Base64DecodingStatus::IllegalInputLength, consumed_);
+      return 0;
+    }
+    if (strict() && pending_ && !(options_ & Base64Options::OmitTrailingEquals))
+    {
+      fail(Base64DecodingStatus::IllegalPadding, consumed_);
+      return 0;
+    }
+    return flush(out);
+  }
+
+  void Base64Decoder::reset()
+  {
+    *this = Base64Decoder(options_);
+  }
+
+  void Base64Decoder::fail(Base64DecodingStatus status, size_t position)
+  {
+    status_ = status;
+    error_position_ = position;
+  }
+
+  size_t Base64Decoder::flush(uint8_t* out)
+  {
+    // A lone sextet has no complete byte and is dropped.
+    const size_t n = pending_ * 6 / 8;
+    const auto bits = bits_ << (24 - 6 * pending_);
+    for (size_t k = 0; k < n; k++)
+      out[k] = static_cast<uint8_t>(bits >> (16 - 8 * k));
+    bits_ = 0;
+    pending_ = 0;
+    return n;
+  }
+} // namespace Boron
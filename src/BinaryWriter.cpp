@@ -0,0 +1,32 @@
+#include "Boron/BinaryWriter.hpp"
+
+#include <cstring>
+
+namespace Boron
+{
+  BinaryWriter& BinaryWriter::putBytes(ByteArrayView bytes)
+  {
+    if (!bytes.empty())
+      std::memcpy(reserve(bytes.size()), bytes.data(), bytes.size());
+    return *this;
+  }
+
+  void BinaryWriter::flush()
+  {
+    if (reserved_ == written_)
+      return;
+    target_.resize(written_);
+    reserved_ = written_;
+    data_ = nullptr;
+  }
+
+  void BinaryWriter::grow(size_t n)
+  {
+    // Sizing the target to its whole capacity makes every byte the growth
+    // policy handed out usable without another call into the array.
+    target_.resizeForOverwrite(written_ + n);
+    target_.resizeForOverwrite(target_.capacity());
+    reserved_ = target_.size();
+    data_ = target_.data();
+  }
+} // namespace Boron
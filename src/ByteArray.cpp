@@ -1,45 +1,71 @@
 #include "Boron/ByteArray.hpp"
-#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <utility>
+#include "AsciiCase.hpp"
+#include "Base64Codec.hpp"
+#include "Boron/Base64Decoder.hpp"
+#include "Boron/PercentEncoder.hpp"
+#include "Boron/String.hpp"
+#include "Boron/Unicode.hpp"
+#include "Boron/Varint.hpp"
 #include "ByteArrayAlgorithms.hpp"
+#include "ByteTranslation.hpp"
+#include "ChecksumKernels.hpp"
+#include "HexCodec.hpp"
+#include "NumberFormatting.hpp"
+#include "NumberParsing.hpp"
+#include "PercentCodec.hpp"
+#include "UnicodeCodec.hpp"
+#include "Whitespace.hpp"
 
 namespace Boron
 {
-
-  ByteArray::ByteArray(const uint8_t* data, size_t size)
+  namespace
   {
-    if (!data)
+    using CaseConversion = void (*)(const byte* in, size_t size, byte* out);
+
+    ByteArray convertedCopy(const ByteArray& a, CaseConversion convert)
     {
-      this->data_ = Container();
+      ByteArray result(a.resource());
+      result.resize_and_overwrite(a.size(), [&](uint8_t* out, size_t n) {
+        convert(a.data(), n, out);
+        return n;
+      });
+      return result;
     }
-    else
+
+    // Copying while converting beats detaching first and converting after.
+    ByteArray convertedInPlace(ByteArray& a, CaseConversion convert)
+    {
+      if (!a.isDetached())
+        return convertedCopy(a, convert);
+      const auto data = a.data();
+      convert(data, a.size(), data);
+      return std::move(a);
+    }
+  } // namespace
+
+  ByteArray::ByteArray(const uint8_t* data, size_t size)
+  {
+    if (data)
     {
       if (size == kDetectLength)
         size = strlen(reinterpret_cast<const char*>(data));
-      if (!size)
-      {
-        this->data_ = Container();
-      }
-      else
-      {
-        this->data_ = Container(data, data + size);
-      }
+      this->data_.assign(data, size);
     }
   }
 
   // TODO: zero-terminated string
-  ByteArray::ByteArray(size_t size, uint8_t ch)
+  ByteArray::ByteArray(size_t size, uint8_t ch) : data_(size, ch)
+  {
+  }
+
+  ByteArray::ByteArray(ByteArrayView data, std::pmr::memory_resource* resource)
+    : data_(data.data(), data.size(), resource)
   {
-    if (size <= 0)
-    {
-      this->data_ = Container();
-    }
-    else
-    {
-      this->data_ = Container(size, ch);
-    }
   }
 
   void ByteArray::resize(size_t size)
@@ -54,7 +80,7 @@ namespace Boron
 
   ByteArray& ByteArray::fill(uint8_t ch, size_t size)
   {
-    this->resize(size == kDetectLength ? this->size() : size);
+    this->resizeForOverwrite(size == kDetectLength ? this->size() : size);
     if (this->size())
       memset(this->data(), ch, this->size());
     return *this;
@@ -62,7 +88,7 @@ namespace Boron
 
   size_t ByteArray::count(uint8_t c) const
   {
-    return std::count(this->begin(), this->end(), c);
+    return Detail::countByte(*this, c);
   }
 
   size_t ByteArray::count(ByteArrayView needle) const
@@ -80,77 +106,315 @@ namespace Boron
     return Detail::findByteArray(*this, from, needle);
   }
 
-  // TODO: check if unnecessary copy is made
+  size_t ByteArray::indexOf(ByteArrayView needle, size_t from, CaseSensitivity cs) const
+  {
+    return ByteArrayView(*this).indexOf(needle, from, cs);
+  }
+
+  int ByteArray::compare(ByteArrayView a, CaseSensitivity cs) const noexcept
+  {
+    return ByteArrayView(*this).compare(a, cs);
+  }
+
+  size_t ByteArray::lastIndexOf(uint8_t chr, size_t from) const
+  {
+    return Detail::findLastByte(*this, from, chr);
+  }
+
+  size_t ByteArray::lastIndexOf(ByteArrayView needle) const
+  {
+    return Detail::findLastByteArray(*this, kNpos, needle);
+  }
+
+  size_t ByteArray::lastIndexOf(ByteArrayView needle, size_t from) const
+  {
+    return Detail::findLastByteArray(*this, from, needle);
+  }
+
+  // Reuses the buffer of the rvalue instead of copying the slice out of it.
   ByteArray ByteArray::sliced_helper(ByteArray& ba, size_t pos, size_t n)
   {
-    return ba.sliced(pos, n);
+    ba.data_.sliceInPlace(pos, n);
+    return std::move(ba);
+  }
+
+  ByteArray ByteArray::mid(size_t index, size_t len) const &
+  {
+    if (index >= size())
+      return {};
+    return sliced(index, std::min(len, size() - index));
+  }
+
+  ByteArray ByteArray::mid(size_t index, size_t len) &&
+  {
+    if (index >= size())
+      return {};
+    return sliced_helper(*this, index, std::min(len, size() - index));
   }
 
   ByteArray ByteArray::trimmed_helper(const ByteArray& a)
   {
-    auto l = a.begin(), r = a.end();
-    while (l < r && (std::isspace(*l) || *l == 0))
-      ++l;
-    while (l < r && (std::isspace(*(r - 1)) || *(r - 1) == 0))
-      --r;
-    return {l, r};
+    const auto trimmed = Detail::trimWhitespace(a);
+    return a.sliced(trimmed.data() - a.constData(), trimmed.size());
   }
 
   ByteArray ByteArray::trimmed_helper(ByteArray& a)
   {
-    return trimmed_helper(static_cast<const ByteArray&>(a));
+    const auto trimmed = Detail::trimWhitespace(a);
+    return sliced_helper(a, trimmed.data() - a.constData(), trimmed.size());
   }
 
+  ByteArray ByteArray::simplified_helper(const ByteArray& a)
+  {
+    ByteArray result(a.resource());
+    result.resize_and_overwrite(a.size(), [&](uint8_t* out, size_t) { return Detail::simplifyWhitespace(a, out); });
+    return result;
+  }
 
-  bool ByteArray::startsWith(ByteArrayView bv) const
+  ByteArray ByteArray::simplified_helper(ByteArray& a)
   {
-    // TODO: fix some security issues
-    if (bv.size() > this->size())
-      return false;
-    for (auto i = 0_sz; i < bv.size(); i++)
-      if (bv[i] != this->data_[i])
-        return false;
-    return true;
+    if (!a.isDetached())
+      return simplified_helper(std::as_const(a));
+    a.resize(Detail::simplifyWhitespace(a, a.data()));
+    return std::move(a);
   }
 
-  bool ByteArray::endsWith(ByteArrayView bv) const
+  ByteArray ByteArray::leftJustified(size_t width, uint8_t fill, bool truncate) const
   {
-    if (bv.size() > this->size())
-      return false;
-    for (auto i = 0_sz; i < bv.size(); i++)
-      if (bv[i] != this->data_[this->size() - bv.size() + i])
-        return false;
-    return true;
+    if (size() >= width)
+      return truncate ? first(width) : *this;
+    ByteArray result(resource());
+    result.resize_and_overwrite(width, [&](uint8_t* out, size_t n) {
+      memcpy(out, constData(), size());
+      memset(out + size(), fill, n - size());
+      return n;
+    });
+    return result;
   }
 
-  // TODO: try to optimize this
-  std::vector<ByteArray> ByteArray::split(uint8_t sep) const
+  ByteArray ByteArray::rightJustified(size_t width, uint8_t fill, bool truncate) const
   {
-    std::vector<ByteArray> result;
-    for (auto it = this->begin(), last = this->begin(); it != this->end(); ++it)
+    if (size() >= width)
+      return truncate ? first(width) : *this;
+    ByteArray result(resource());
+    result.resize_and_overwrite(width, [&](uint8_t* out, size_t n) {
+      memset(out, fill, n - size());
+      memcpy(out + n - size(), constData(), size());
+      return n;
+    });
+    return result;
+  }
+
+  ByteArray& ByteArray::replace(ByteArrayView before, ByteArrayView after)
+  {
+    if (before.empty())
+      return *this;
+    auto pos = Detail::findByteArray(*this, 0, before);
+    if (pos == Detail::kNotFound)
+      return *this;
+
+    // Both are read while this array is rewritten.
+    const auto within = [this](ByteArrayView v) { return v.data() >= constData() && v.data() < constData() + size(); };
+    const ByteArray before_copy = within(before) ? before.toByteArray() : ByteArray();
+    const ByteArray after_copy = within(after) ? after.toByteArray() : ByteArray();
+    if (!before_copy.isEmpty())
+      before = before_copy;
+    if (!after_copy.isEmpty())
+      after = after_copy;
+
+    if (after.size() <= before.size() && isDetached())
     {
-      if (*it == sep && it != last)
+      // The output never passes the input, which is searched ahead of it.
+      const auto out = data();
+      const auto old_size = size();
+      size_t read = 0;
+      size_t written = 0;
+      while (pos != Detail::kNotFound)
       {
-        result.emplace_back(last, it);
-        last = it + 1;
+        memmove(out + written, out + read, pos - read);
+        written += pos - read;
+        memcpy(out + written, after.data(), after.size());
+        written += after.size();
+        read = pos + before.size();
+        pos = Detail::findByteArray(ByteArrayView(out, old_size), read, before);
       }
+      memmove(out + written, out + read, old_size - read);
+      resize(written + old_size - read);
+      return *this;
     }
+
+    const auto matches = Detail::countByteArray(ByteArrayView(*this).sliced(pos, size() - pos), before);
+    ByteArray result(resource());
+    result.resize_and_overwrite(size() - matches * before.size() + matches * after.size(), [&](uint8_t* out, size_t n) {
+      const auto in = constData();
+      size_t read = 0;
+      size_t written = 0;
+      while (pos != Detail::kNotFound)
+      {
+        memcpy(out + written, in + read, pos - read);
+        written += pos - read;
+        memcpy(out + written, after.data(), after.size());
+        written += after.size();
+        read = pos + before.size();
+        pos = Detail::findByteArray(*this, read, before);
+      }
+      memcpy(out + written, in + read, size() - read);
+      return n;
+    });
+    *this = std::move(result);
+    return *this;
+  }
+
+  ByteArray& ByteArray::replace(uint8_t before, uint8_t after)
+  {
+    const auto pos = indexOf(before);
+    if (pos == kNpos || before == after)
+      return *this;
+    Detail::replaceByte(data() + pos, size() - pos, before, after);
+    return *this;
+  }
+
+  ByteArray& ByteArray::translate(const std::array<uint8_t, 256>& table)
+  {
+    if (!isEmpty())
+      Detail::translateBytes(data(), size(), table.data());
+    return *this;
+  }
+
+  ByteArray ByteArray::toLower_helper(const ByteArray& a)
+  {
+    if (!Detail::containsAsciiUpper(a))
+      return a;
+    return convertedCopy(a, Detail::asciiToLower);
+  }
+
+  ByteArray ByteArray::toLower_helper(ByteArray& a)
+  {
+    if (!Detail::containsAsciiUpper(a))
+      return std::move(a);
+    return convertedInPlace(a, Detail::asciiToLower);
+  }
+
+  ByteArray ByteArray::toUpper_helper(const ByteArray& a)
+  {
+    if (!Detail::containsAsciiLower(a))
+      return a;
+    return convertedCopy(a, Detail::asciiToUpper);
+  }
+
+  ByteArray ByteArray::toUpper_helper(ByteArray& a)
+  {
+    if (!Detail::containsAsciiLower(a))
+      return std::move(a);
+    return convertedInPlace(a, Detail::asciiToUpper);
+  }
+
+  bool ByteArray::isUpper() const
+  {
+    return !Detail::containsAsciiLower(*this);
+  }
+
+  bool ByteArray::isLower() const
+  {
+    return !Detail::containsAsciiUpper(*this);
+  }
+
+  size_t ByteArrayView::indexOf(uint8_t chr, size_t from) const
+  {
+    return Detail::findByte(*this, from, chr);
+  }
+
+  size_t ByteArrayView::indexOf(ByteArrayView needle, size_t from) const
+  {
+    return Detail::findByteArray(*this, from, needle);
+  }
+
+  size_t ByteArrayView::indexOf(ByteArrayView needle, size_t from, CaseSensitivity cs) const
+  {
+    if (cs == CaseSensitivity::CaseSensitive)
+      return Detail::findByteArray(*this, from, needle);
+    return Detail::findCaseInsensitive(*this, from, needle);
+  }
+
+  ByteArrayView ByteArrayView::trimmed() const
+  {
+    return Detail::trimWhitespace(*this);
+  }
+
+  bool ByteArrayView::startsWith(ByteArrayView bv, CaseSensitivity cs) const
+  {
+    if (bv.size() > size())
+      return false;
+    const auto head = sliced(0, bv.size());
+    return cs == CaseSensitivity::CaseSensitive ? head == bv : Detail::equalsCaseInsensitive(head, bv);
+  }
+
+  bool ByteArrayView::endsWith(ByteArrayView bv, CaseSensitivity cs) const
+  {
+    if (bv.size() > size())
+      return false;
+    const auto tail = sliced(size() - bv.size(), bv.size());
+    return cs == CaseSensitivity::CaseSensitive ? tail == bv : Detail::equalsCaseInsensitive(tail, bv);
+  }
+
+  int ByteArrayView::compare(ByteArrayView bv, CaseSensitivity cs) const noexcept
+  {
+    if (cs == CaseSensitivity::CaseSensitive)
+      return orderToInt(*this <=> bv);
+    return Detail::compareCaseInsensitive(*this, bv);
+  }
+
+  std::vector<ByteArrayView> ByteArrayView::splitView(uint8_t sep, SplitBehavior behavior) const
+  {
+    std::vector<ByteArrayView> result;
+    for (auto field : splitRange(sep, behavior))
+      result.push_back(field);
+    return result;
+  }
+
+  std::vector<ByteArrayView> ByteArrayView::splitView(ByteArrayView sep, SplitBehavior behavior) const
+  {
+    std::vector<ByteArrayView> result;
+    for (auto field : splitRange(sep, behavior))
+      result.push_back(field);
+    return result;
+  }
+
+  std::vector<ByteArray> ByteArray::split(uint8_t sep) const
+  {
+    std::vector<ByteArray> result;
+    for (auto field : splitRange(sep))
+      result.emplace_back(field, resource());
+    return result;
+  }
+
+  std::vector<ByteArray> ByteArray::split(ByteArrayView sep) const
+  {
+    std::vector<ByteArray> result;
+    for (auto field : splitRange(sep))
+      result.emplace_back(field, resource());
     return result;
   }
 
   ByteArray ByteArray::repeated(size_t times) const
   {
-    ByteArray result;
-    result.data_.resize(this->size() * times);
-    for (auto i = 0_sz; i < times; i++)
-      memcpy(result.data_.data() + i * this->size(), this->data_.data(), this->size());
+    ByteArray result(resource());
+    const auto total = this->size() * times;
+    if (total == 0)
+      return result;
+    result.resize_and_overwrite(total, [this, total](uint8_t* out, size_t) {
+      // Double the filled prefix, so there are O(log times) large copies.
+      memcpy(out, this->constData(), this->size());
+      for (auto filled = this->size(); filled < total; filled *= 2)
+        memcpy(out + filled, out, std::min(filled, total - filled));
+      return total;
+    });
     return result;
   }
 
   ByteArray& ByteArray::setRawData(const uint8_t* a, size_t n)
   {
-    this->data_.reserve(n);
-    memcpy(this->data_.data(), a, n);
+    this->data_.assign(a, n);
     return *this;
   }
 
@@ -159,59 +423,319 @@ namespace Boron
     return fromRawData(reinterpret_cast<const uint8_t*>(s.data()), s.size());
   }
 
+  ByteArray ByteArray::fromUtf16(std::u16string_view s)
+  {
+    ByteArray result;
+    result.resize_and_overwrite(s.size() * 3, [&](uint8_t* out, size_t) {
+      size_t written = 0;
+      while (true)
+      {
+        const auto converted = utf16ToUtf8(s, out + written);
+        written += converted.written;
+        if (converted)
+          return written;
+        written += Detail::encodeUtf8(Detail::kReplacementCharacter, out + written);
+        s.remove_prefix(converted.errorPosition + 1);
+      }
+    });
+    return result;
+  }
+
+  String ByteArray::toString() const &
+  {
+    return String(*this);
+  }
+
+  String ByteArray::toString() &&
+  {
+    return String(std::move(*this));
+  }
+
   std::string ByteArray::toStdString() const
   {
-    return {reinterpret_cast<const char*>(this->data_.data()), this->data_.size()};
+    return {reinterpret_cast<const char*>(this->data()), this->size()};
   }
 
   std::string ByteArray::toHex(char separator) const
   {
-    static constexpr const char kHexChars[] = "0123456789ABCDEF";
-    std::string result;
-    auto res_size = this->size() * (separator == '\0' ? 2 : 3);
-    result.reserve(res_size);
-    for (auto i = 0_sz; i < this->size(); i++)
+    std::string result(hexSize(separator), '\0');
+    writeHex(result.data(), separator);
+    return result;
+  }
+
+  size_t ByteArray::hexSize(char separator) const noexcept
+  {
+    return Detail::hexEncodedSize(size(), separator);
+  }
+
+  size_t ByteArray::writeHex(char* out, char separator) const
+  {
+    Detail::encodeHex(*this, out, separator);
+    return hexSize(separator);
+  }
+
+  ByteArray ByteArray::fromHex(const std::string& hexEncoded)
+  {
+    return fromHexEncoding({reinterpret_cast<const uint8_t*>(hexEncoded.data()), hexEncoded.size()}).decoded;
+  }
+
+  ByteArray::FromHexResult ByteArray::fromHexEncoding(ByteArrayView hexEncoded)
+  {
+    FromHexResult result;
+    result.decoded.resize_and_overwrite(hexEncoded.size() / 2, [&](uint8_t* out, size_t n) {
+      result.decodingStatus = decodeHex(hexEncoded, out, &result.errorPosition);
+      return result.decodingStatus == HexDecodingStatus::Ok ? n : 0;
+    });
+    return result;
+  }
+
+  HexDecodingStatus ByteArray::decodeHex(ByteArrayView hexEncoded, uint8_t* out, size_t* errorPosition)
+  {
+    auto status = HexDecodingStatus::Ok;
+    auto pos = kNpos;
+    if (hexEncoded.size() % 2 != 0)
+    {
+      status = HexDecodingStatus::IllegalLength;
+      pos = hexEncoded.size();
+    }
+    else
     {
-      result.push_back(kHexChars[this->data_[i] >> 4]);
-      result.push_back(kHexChars[this->data_[i] & 0x0F]);
-      if (separator && i + 1 < this->size())
-        result.push_back(separator);
+      pos = Detail::decodeHex(reinterpret_cast<const char*>(hexEncoded.data()), hexEncoded.size(), out);
+      if (pos != Detail::kNotFound)
+        status = HexDecodingStatus::IllegalCharacter;
     }
+    if (errorPosition)
+      *errorPosition = pos;
+    return status;
+  }
+
+  ByteArray& ByteArray::setNum(float n, uint8_t format, int precision)
+  {
+    clear();
+    return appendNumber(n, format, precision);
+  }
+
+  ByteArray& ByteArray::setNum(double n, uint8_t format, int precision)
+  {
+    clear();
+    return appendNumber(n, format, precision);
+  }
+
+  ByteArray& ByteArray::appendNumber(float n, uint8_t format, int precision)
+  {
+    const auto old_size = size();
+    resize_and_overwrite(old_size + Detail::floatingPointBound(format, precision), [&](uint8_t* out, size_t) {
+      return old_size + Detail::formatFloatingPoint(n, format, precision, reinterpret_cast<char*>(out + old_size));
+    });
+    return *this;
+  }
+
+  ByteArray& ByteArray::appendNumber(double n, uint8_t format, int precision)
+  {
+    const auto old_size = size();
+    resize_and_overwrite(old_size + Detail::floatingPointBound(format, precision), [&](uint8_t* out, size_t) {
+      return old_size + Detail::formatFloatingPoint(n, format, precision, reinterpret_cast<char*>(out + old_size));
+    });
+    return *this;
+  }
+
+  ByteArray ByteArray::number(double n, uint8_t format, int precision)
+  {
+    ByteArray result;
+    result.appendNumber(n, format, precision);
     return result;
   }
 
-  ByteArray ByteArray::fromHex(const std::string& hexEncoded)
+  ByteArray& ByteArray::appendNumber_helper(unsigned long long magnitude, bool negative, int base)
+  {
+    if (base < 2 || base > 36)
+      return *this;
+    const auto old_size = size();
+    resize_and_overwrite(old_size + Detail::kMaxIntegerChars, [&](uint8_t* out, size_t) {
+      return old_size + Detail::formatInteger(magnitude, negative, base, reinterpret_cast<char*>(out + old_size));
+    });
+    return *this;
+  }
+
+  ByteArray& ByteArray::appendVarint(uint64_t value)
+  {
+    const auto old_size = size();
+    resize_and_overwrite(old_size + varintSize(value), [&](uint8_t* out, size_t n) {
+      encodeVarint(value, out + old_size);
+      return n;
+    });
+    return *this;
+  }
+
+  ByteArray& ByteArray::appendZigZagVarint(int64_t value)
+  {
+    return appendVarint(zigZagEncode(value));
+  }
+
+  long long ByteArrayView::toLongLong(bool* ok, int base) const
+  {
+    uint64_t magnitude = 0;
+    bool negative = false;
+    auto parsed = Detail::parseInteger(*this, base, magnitude, negative);
+    // The magnitude of the minimum is one past the maximum.
+    const auto limit = static_cast<uint64_t>(std::numeric_limits<long long>::max()) + negative;
+    parsed = parsed && magnitude <= limit;
+    if (ok)
+      *ok = parsed;
+    if (!parsed)
+      return 0;
+    return negative ? static_cast<long long>(0 - magnitude) : static_cast<long long>(magnitude);
+  }
+
+  unsigned long long ByteArrayView::toULongLong(bool* ok, int base) const
+  {
+    uint64_t magnitude = 0;
+    bool negative = false;
+    const auto parsed = Detail::parseInteger(*this, base, magnitude, negative) && !negative;
+    if (ok)
+      *ok = parsed;
+    return parsed ? magnitude : 0;
+  }
+
+  float ByteArrayView::toFloat(bool* ok) const
+  {
+    float value = 0;
+    const auto parsed = Detail::parseFloatingPoint(*this, value);
+    if (ok)
+      *ok = parsed;
+    return value;
+  }
+
+  double ByteArrayView::toDouble(bool* ok) const
+  {
+    double value = 0;
+    const auto parsed = Detail::parseFloatingPoint(*this, value);
+    if (ok)
+      *ok = parsed;
+    return value;
+  }
+
+  uint64_t ByteArrayView::toVarint(size_t* consumed) const
+  {
+    uint64_t value = 0;
+    const auto size = decodeVarint(data(), this->size(), value);
+    if (consumed)
+      *consumed = size;
+    return size ? value : 0;
+  }
+
+  int64_t ByteArrayView::toZigZagVarint(size_t* consumed) const
+  {
+    return zigZagDecode(toVarint(consumed));
+  }
+
+  uint32_t ByteArrayView::crc32() const
+  {
+    return ~Detail::updateCrc32(~uint32_t{0}, data(), size());
+  }
+
+  uint32_t ByteArrayView::crc32c() const
+  {
+    return ~Detail::updateCrc32c(~uint32_t{0}, data(), size());
+  }
+
+  uint32_t ByteArrayView::adler32() const
+  {
+    return Detail::updateAdler32(1, data(), size());
+  }
+
+  bool ByteArrayView::isValidUtf8() const noexcept
+  {
+    return Boron::isValidUtf8(*this);
+  }
+
+  std::u16string ByteArrayView::toUtf16() const
+  {
+    // No more units than bytes, replacements included.
+    std::u16string result(size(), u'\0');
+    size_t pos = 0;
+    size_t written = 0;
+    while (true)
+    {
+      const auto converted = utf8ToUtf16(sliced(pos, size() - pos), result.data() + written);
+      written += converted.written;
+      if (converted)
+        break;
+      pos += converted.errorPosition;
+      result[written++] = static_cast<char16_t>(Detail::kReplacementCharacter);
+      pos += Detail::malformedUtf8Length(data() + pos, size() - pos);
+    }
+    result.resize(written);
+    return result;
+  }
+
+  String ByteArrayView::toString() const
+  {
+    return String(toByteArray());
+  }
+
+  ByteArray ByteArrayView::toBase64(Base64Options options) const
   {
-    static constexpr const byte kHexChars[256] = {
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 0-15
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 16-31
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 32-47
-      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 255, 255, 255, 255, 255, 255, // '0'-'9' and others
-      255, 10, 11, 12, 13, 14, 15, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 'A'-'F' and others
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 80-95
-      255, 10, 11, 12, 13, 14, 15, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 'a'-'f' and others
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 112-127
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 128-143
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 144-159
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 160-175
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 176-191
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 192-207
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 208-223
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 224-239
-      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 // 240-255
-
-    };
     ByteArray result;
-    assert(hexEncoded.size() % 2 == 0);
-    result.data_.reserve(hexEncoded.size() / 2);
-    for (auto i = 0_sz; i < hexEncoded.size(); i += 2)
+    result.resize_and_overwrite(base64Size(options), [&](uint8_t* out, size_t n) {
+      writeBase64(reinterpret_cast<char*>(out), options);
+      return n;
+    });
+    return result;
+  }
+
+  size_t ByteArrayView::base64Size(Base64Options options) const noexcept
+  {
+    return Detail::base64EncodedSize(size(), !(options & Base64Options::OmitTrailingEquals));
+  }
+
+  size_t ByteArrayView::writeBase64(char* out, Base64Options options) const
+  {
+    const bool pad = !(options & Base64Options::OmitTrailingEquals);
+    Detail::encodeBase64(data(), size(), out, options & Base64Options::Base64UrlEncoding, pad);
+    return Detail::base64EncodedSize(size(), pad);
+  }
+
+  ByteArray::FromBase64Result ByteArray::fromBase64Encoding(ByteArrayView base64, Base64Options options)
+  {
+    FromBase64Result result;
+    Base64Decoder decoder(options);
+    result.decoded.resize_and_overwrite(Base64Decoder::maxDecodedSize(base64.size()), [&](uint8_t* out, size_t) {
+      const auto n = decoder.feed(base64, out);
+      const auto total = n + decoder.finish(out + n);
+      return decoder.status() == Base64DecodingStatus::Ok ? total : 0;
+    });
+    result.decodingStatus = decoder.status();
+    return result;
+  }
+
+  ByteArray ByteArray::fromBase64(ByteArrayView base64, Base64Options options)
+  {
+    return fromBase64Encoding(base64, options).decoded;
+  }
+
+  std::string ByteArray::toPercentEncoding(const ByteArray& exclude, const ByteArray& include, uint8_t percent) const
+  {
+    if (exclude.isEmpty() && include.isEmpty() && percent == '%')
     {
-      auto hi = kHexChars[static_cast<unsigned char>(hexEncoded[i])];
-      auto lo = kHexChars[static_cast<unsigned char>(hexEncoded[i + 1])];
-      result.data_.push_back(hi << 4 | lo);
+      static const PercentEncoder kDefaultEncoder;
+      return kDefaultEncoder.encode(*this);
     }
+    return PercentEncoder(exclude, include, percent).encode(*this);
+  }
+
+  ByteArray ByteArray::percentDecoded(uint8_t percent) const
+  {
+    ByteArray result(resource());
+    result.resize_and_overwrite(size(), [&](uint8_t* out, size_t) {
+      return Detail::decodePercent(constData(), size(), out, percent);
+    });
     return result;
   }
 
+  ByteArray ByteArray::fromPercentEncoding(const ByteArray& pctEncoded, uint8_t percent)
+  {
+    return pctEncoded.percentDecoded(percent);
+  }
 
 } // namespace Boron
@@ -1,17 +1,334 @@
 #include "ByteArrayAlgorithms.hpp"
+#include "CpuFeatures.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <cstring>
 #include <iterator>
 
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
 namespace Boron::Detail
 {
+  namespace
+  {
+    // Substring search kernels. All of them share the same contract: needle_size
+    // is at least 2 and at most size, and the returned offset is relative to
+    // haystack.
+    //
+    // The SIMD variants compare a block of candidate positions against the first
+    // and the last byte of the needle at once and only verify the middle of the
+    // needle for positions where both match. That filter rejects nearly every
+    // candidate in real data, so the kernels run close to memory bandwidth and
+    // need no per-needle preprocessing.
+    using FindFn = size_t (*)(const byte* haystack, size_t size, const byte* needle, size_t needle_size);
+
+    size_t findScalar(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto last = needle[needle_size - 1];
+      const auto candidates_end = haystack + (size - needle_size + 1);
+      auto ptr = haystack;
+      while (ptr < candidates_end)
+      {
+        ptr = static_cast<const byte*>(memchr(ptr, needle[0], candidates_end - ptr));
+        if (ptr == nullptr)
+          return kNotFound;
+        if (ptr[needle_size - 1] == last && memcmp(ptr + 1, needle + 1, needle_size - 2) == 0)
+          return ptr - haystack;
+        ++ptr;
+      }
+      return kNotFound;
+    }
+
+#if BORON_ARCH_X86
+    BORON_TARGET("sse2")
+    size_t findSse2(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = _mm_set1_epi8(static_cast<char>(needle[0]));
+      const auto last = _mm_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+      const auto candidates = size - needle_size + 1;
+      size_t i = 0;
+      for (; i + 16 <= candidates; i += 16)
+      {
+        const auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        const auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needle_size - 1));
+        auto mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+          const auto pos = i + std::countr_zero(mask);
+          if (memcmp(haystack + pos + 1, needle + 1, needle_size - 2) == 0)
+            return pos;
+          mask &= mask - 1;
+        }
+      }
+      const auto pos = findScalar(haystack + i, size - i, needle, needle_size);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx2")
+    size_t findAvx2(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+      const auto last = _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+      const auto candidates = size - needle_size + 1;
+      size_t i = 0;
+      for (; i + 32 <= candidates; i += 32)
+      {
+        const auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+        const auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needle_size - 1));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask != 0)
+        {
+          const auto pos = i + std::countr_zero(mask);
+          if (memcmp(haystack + pos + 1, needle + 1, needle_size - 2) == 0)
+            return pos;
+          mask &= mask - 1;
+        }
+      }
+      // The SSE2 tail is legacy encoded, running it with dirty upper register
+      // halves stalls; the same holds for every AVX2 kernel below.
+      _mm256_zeroupper();
+      const auto pos = findSse2(haystack + i, size - i, needle, needle_size);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx512f,avx512bw")
+    size_t findAvx512(const byte* haystack, size_t size, const byte* needle, size_t needle_size)
+    {
+      const auto first = _mm512_set1_epi8(static_cast<char>(needle[0]));
+      const auto last = _mm512_set1_epi8(static_cast<char>(needle[needle_size - 1]));
+      const auto candidates = size - needle_size + 1;
+      size_t i = 0;
+      for (; i + 64 <= candidates; i += 64)
+      {
+        const auto block_first = _mm512_loadu_si512(haystack + i);
+        const auto block_last = _mm512_loadu_si512(haystack + i + needle_size - 1);
+        auto mask = static_cast<uint64_t>(_mm512_cmpeq_epi8_mask(first, block_first) &
+                                          _mm512_cmpeq_epi8_mask(last, block_last));
+        while (mask != 0)
+        {
+          const auto pos = i + std::countr_zero(mask);
+          if (memcmp(haystack + pos + 1, needle + 1, needle_size - 2) == 0)
+            return pos;
+          mask &= mask - 1;
+        }
+      }
+      const auto pos = findAvx2(haystack + i, size - i, needle, needle_size);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+#endif
+
+    FindFn selectFind()
+    {
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx512bw)
+        return findAvx512;
+      if (features.avx2)
+        return findAvx2;
+      if (features.sse2)
+        return findSse2;
+#endif
+      return findScalar;
+    }
+
+    // Single byte kernels: forward search, backward search and counting. The
+    // vector variants process 16, 32 or 64 bytes per step and hand the tail to
+    // the next narrower variant; the counters popcount the compare masks.
+    struct ByteKernels
+    {
+      size_t (*find)(const byte* data, size_t size, byte chr);
+      size_t (*findLast)(const byte* data, size_t size, byte chr);
+      size_t (*count)(const byte* data, size_t size, byte chr);
+    };
+
+    size_t findByteScalar(const byte* data, size_t size, byte chr)
+    {
+      const auto ptr = static_cast<const byte*>(memchr(data, chr, size));
+      return ptr == nullptr ? kNotFound : ptr - data;
+    }
+
+    size_t findLastByteScalar(const byte* data, size_t size, byte chr)
+    {
+      for (auto i = size; i > 0; --i)
+      {
+        if (data[i - 1] == chr)
+          return i - 1;
+      }
+      return kNotFound;
+    }
+
+    size_t countByteScalar(const byte* data, size_t size, byte chr)
+    {
+      return std::count(data, data + size, chr);
+    }
+
+#if BORON_ARCH_X86
+    BORON_TARGET("sse2")
+    size_t findByteSse2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm_set1_epi8(static_cast<char>(chr));
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (mask != 0)
+          return i + std::countr_zero(mask);
+      }
+      const auto pos = findByteScalar(data + i, size - i, chr);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("sse2")
+    size_t findLastByteSse2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm_set1_epi8(static_cast<char>(chr));
+      auto i = size;
+      for (; i >= 16; i -= 16)
+      {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 16));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (mask != 0)
+          return i - 16 + (31 - std::countl_zero(mask));
+      }
+      return findLastByteScalar(data, i, chr);
+    }
+
+    BORON_TARGET("sse2,popcnt")
+    size_t countByteSse2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm_set1_epi8(static_cast<char>(chr));
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        count += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+      }
+      return count + countByteScalar(data + i, size - i, chr);
+    }
+
+    BORON_TARGET("avx2")
+    size_t findByteAvx2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm256_set1_epi8(static_cast<char>(chr));
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask != 0)
+          return i + std::countr_zero(mask);
+      }
+      _mm256_zeroupper();
+      const auto pos = findByteSse2(data + i, size - i, chr);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx2")
+    size_t findLastByteAvx2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm256_set1_epi8(static_cast<char>(chr));
+      auto i = size;
+      for (; i >= 32; i -= 32)
+      {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 32));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask != 0)
+          return i - 32 + (31 - std::countl_zero(mask));
+      }
+      _mm256_zeroupper();
+      return findLastByteSse2(data, i, chr);
+    }
+
+    BORON_TARGET("avx2,popcnt")
+    size_t countByteAvx2(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm256_set1_epi8(static_cast<char>(chr));
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))));
+      }
+      _mm256_zeroupper();
+      return count + countByteSse2(data + i, size - i, chr);
+    }
+
+    BORON_TARGET("avx512f,avx512bw")
+    size_t findByteAvx512(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm512_set1_epi8(static_cast<char>(chr));
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64)
+      {
+        const auto mask = static_cast<uint64_t>(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i), needle));
+        if (mask != 0)
+          return i + std::countr_zero(mask);
+      }
+      const auto pos = findByteAvx2(data + i, size - i, chr);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx512f,avx512bw")
+    size_t findLastByteAvx512(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm512_set1_epi8(static_cast<char>(chr));
+      auto i = size;
+      for (; i >= 64; i -= 64)
+      {
+        const auto mask = static_cast<uint64_t>(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i - 64), needle));
+        if (mask != 0)
+          return i - 64 + (63 - std::countl_zero(mask));
+      }
+      return findLastByteAvx2(data, i, chr);
+    }
+
+    BORON_TARGET("avx512f,avx512bw,popcnt")
+    size_t countByteAvx512(const byte* data, size_t size, byte chr)
+    {
+      const auto needle = _mm512_set1_epi8(static_cast<char>(chr));
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64)
+        count += std::popcount(static_cast<uint64_t>(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i), needle)));
+      return count + countByteAvx2(data + i, size - i, chr);
+    }
+#endif
+
+    ByteKernels selectByteKernels()
+    {
+      ByteKernels kernels{findByteScalar, findLastByteScalar, countByteScalar};
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx512bw)
+        kernels = {findByteAvx512, findLastByteAvx512, countByteAvx512};
+      else if (features.avx2)
+        kernels = {findByteAvx2, findLastByteAvx2, countByteAvx2};
+      else if (features.sse2)
+        kernels = {findByteSse2, findLastByteSse2, countByteSse2};
+      // The counters are built with POPCNT, which has a CPUID bit of its own.
+      if (!features.popcnt)
+        kernels.count = countByteScalar;
+#endif
+      return kernels;
+    }
+  } // namespace
+
 
-  // TODO: Implement countByteArray using Boyer-Moore search
   size_t countByteArray(ByteArrayView haystack, ByteArrayView needle)
   {
+    // The empty needle matches in front of every byte and at the end.
+    if (needle.empty())
+      return haystack.size() + 1;
     size_t count = 0;
     size_t pos = 0;
     while ((pos = findByteArray(haystack, pos, needle)) != kNotFound)
@@ -22,22 +339,28 @@ namespace Boron::Detail
     return count;
   }
 
-  // TODO: Implement Boyer-Moore search
+  size_t countByte(ByteArrayView haystack, uint8_t chr)
+  {
+    return dispatched<selectByteKernels>().count(haystack.data(), haystack.size(), chr);
+  }
 
   size_t findByte(ByteArrayView haystack, size_t from, uint8_t chr)
+  {
+    const auto l = haystack.size();
+    if (from >= l)
+      return -1;
+    const auto pos = dispatched<selectByteKernels>().find(haystack.data() + from, l - from, chr);
+    return pos == kNotFound ? kNotFound : pos + from;
+  }
+
+  size_t findLastByte(ByteArrayView haystack, size_t from, uint8_t chr)
   {
     const auto l = haystack.size();
     if (l == 0)
       return -1;
-    // if (from < 0)
-    // from += l;
-    // if (from < 0)
-    // from = 0;
     if (from >= l)
-      return -1;
-    // TODO: use memchr
-    const auto it = std::find(haystack.begin() + from, haystack.end(), chr);
-    return it == haystack.end() ? -1 : it - haystack.begin();
+      from = l - 1;
+    return dispatched<selectByteKernels>().findLast(haystack.data(), from + 1, chr);
   }
 
   size_t findByteArray(ByteArrayView haystack, size_t from,
@@ -59,44 +382,35 @@ namespace Boron::Detail
     if (from > l || ol + from > l)
       return -1;
 
-    // use Boyer-Moore search for large haystacks
-    if (l > 500 && ol > 5)
-    {
-      auto it =
-        std::search(haystack.begin() + from, haystack.end(),
-                    std::boyer_moore_searcher(needle.begin(), needle.end()));
-      return std::distance(haystack.begin(), it);
-    }
+    const auto pos = dispatched<selectFind>()(haystack.data() + from, l - from, needle.data(), ol);
+    return pos == kNotFound ? kNotFound : pos + from;
+  }
 
-    // else use hash search
-    static constexpr const size_t kBase = 31;
-    // TODO: check if this kMod is reasonable
-    // static constexpr const size_t kMod = 75903750772792949;
-    auto haystackptr = haystack.data() + from;
-    auto end = haystack.data() + l - ol;
-    auto needleptr = needle.data();
-    size_t pow_base = 1;
-    size_t needle_hash = 0, haystack_hash = 0;
-    size_t idx = 0;
-    for (idx = 0; idx < ol - 1; ++idx)
-    {
-      needle_hash = needle_hash * kBase + needleptr[idx];
-      haystack_hash = haystack_hash * kBase + haystackptr[idx];
-      pow_base *= kBase;
-    }
-    needle_hash = needle_hash * kBase + needleptr[idx];
-    while (haystackptr <= end)
+  size_t findLastByteArray(ByteArrayView haystack, size_t from, ByteArrayView needle)
+  {
+    const auto ol = needle.size();
+    const auto l = haystack.size();
+    if (ol > l)
+      return -1;
+    from = std::min(from, l - ol);
+    if (ol == 0)
+      return from;
+    if (ol == 1)
+      return findLastByte(haystack, from, needle[0]);
+
+    // Walk the candidates for the first byte backwards with the byte kernel and
+    // verify the rest of the needle in place.
+    const auto data = haystack.data();
+    auto end = from + 1;
+    while (end > 0)
     {
-      haystack_hash = haystack_hash * kBase + haystackptr[idx];
-      if (haystack_hash == needle_hash && *haystackptr == *needleptr)
-      {
-        // TODO: check the implementation of std::equal and memcmp
-        if (std::equal(needleptr, needleptr + ol, haystackptr))
-          return haystackptr - haystack.data();
-      }
-      haystack_hash -= *haystackptr * pow_base;
-      ++haystackptr;
+      const auto pos = dispatched<selectByteKernels>().findLast(data, end, needle[0]);
+      if (pos == kNotFound)
+        return kNotFound;
+      if (memcmp(data + pos + 1, needle.data() + 1, ol - 1) == 0)
+        return pos;
+      end = pos;
     }
-    return -1;
+    return kNotFound;
   }
 } // namespace Boron::Detail
@@ -7,9 +7,14 @@ namespace Boron::Detail {
 
 constexpr const size_t kNotFound = -1;
 
+size_t countByte(ByteArrayView haystack, uint8_t chr);
 size_t countByteArray(ByteArrayView haystack, ByteArrayView needle);
 size_t findByte(ByteArrayView haystack, size_t from, uint8_t chr);
 size_t findByteArray(ByteArrayView haystack, size_t from, ByteArrayView needle);
+// Backward searches: the last match starting at or before from. A from past
+// the end searches the whole haystack.
+size_t findLastByte(ByteArrayView haystack, size_t from, uint8_t chr);
+size_t findLastByteArray(ByteArrayView haystack, size_t from, ByteArrayView needle);
 
 }
 
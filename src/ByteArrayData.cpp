@@ -0,0 +1,267 @@
+#include "Boron/ByteArrayData.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <new>
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    bool aliases(const byte* ptr, const byte* begin, size_t size)
+    {
+      return std::greater_equal<const byte*>()(ptr, begin) && std::less<const byte*>()(ptr, begin + size);
+    }
+
+    // The global heap is handled without going through a resource.
+    std::pmr::memory_resource* bindable(std::pmr::memory_resource* resource)
+    {
+      return resource == std::pmr::new_delete_resource() ? nullptr : resource;
+    }
+  } // namespace
+
+  ByteArrayData::ByteArrayData(std::pmr::memory_resource* resource)
+    : ByteArrayData(withCapacity(0, bindable(resource)))
+  {
+  }
+
+  ByteArrayData::ByteArrayData(const byte* data, size_t size, std::pmr::memory_resource* resource)
+    : ByteArrayData(withCapacity(size, bindable(resource)))
+  {
+    assign(data, size);
+  }
+
+  ByteArrayData::ByteArrayData(size_t size, byte c, std::pmr::memory_resource* resource)
+    : ByteArrayData(withCapacity(size, bindable(resource)))
+  {
+    resize(size, c);
+  }
+
+  ByteArrayData ByteArrayData::withCapacity(size_t capacity, std::pmr::memory_resource* resource)
+  {
+    ByteArrayData result;
+    if (resource && capacity == 0)
+      result.setEmpty(resource);
+    else if (resource)
+    {
+      // Arena blocks are cheap but never grow in place, start with some room.
+      capacity = std::max(capacity, kInlineCapacity);
+      const auto block = static_cast<Block*>(resource->allocate(sizeof(Block) + capacity, alignof(Block)));
+      new (block) Block{{1}, capacity, resource};
+      result.setHeap(block->payload(), block, 0);
+    }
+    else if (capacity > kInlineCapacity)
+    {
+      const auto block = static_cast<Block*>(::operator new(sizeof(Block) + capacity));
+      new (block) Block{{1}, capacity, nullptr};
+      result.setHeap(block->payload(), block, 0);
+    }
+    return result;
+  }
+
+  void ByteArrayData::release() noexcept
+  {
+    if (isInline())
+      return;
+    const auto block = rep_.heap.block;
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      const auto resource = block->resource;
+      const auto capacity = block->capacity;
+      block->~Block();
+      if (resource)
+        resource->deallocate(block, sizeof(Block) + capacity, alignof(Block));
+      else
+        ::operator delete(block);
+    }
+  }
+
+  void ByteArrayData::reallocate(size_t capacity)
+  {
+    const auto old_size = size();
+    auto fresh = withCapacity(std::max(capacity, old_size), resource());
+    memcpy(fresh.mutableData(), constData(), old_size);
+    fresh.setSize(old_size);
+    swap(fresh);
+  }
+
+  ByteArrayData ByteArrayData::sliced(size_t pos, size_t n) const
+  {
+    const auto resource = this->resource();
+    if (n <= kInlineCapacity && !resource)
+      return {data() + pos, n};
+    ByteArrayData result(resource);
+    if (isInline())
+      return result;
+    result.share(*this);
+    result.setHeap(rep_.heap.data + pos, rep_.heap.block, n);
+    return result;
+  }
+
+  void ByteArrayData::sliceInPlace(size_t pos, size_t n)
+  {
+    if (isUnallocated())
+      return;
+    if (isInline())
+    {
+      memmove(rep_.small.data, rep_.small.data + pos, n);
+      setInlineSize(n);
+      return;
+    }
+    setHeap(rep_.heap.data + pos, rep_.heap.block, n);
+  }
+
+  void ByteArrayData::reserve(size_t capacity)
+  {
+    if (capacity > this->capacity())
+      reallocate(capacity);
+  }
+
+  void ByteArrayData::shrinkToFit()
+  {
+    if (isInline())
+      return;
+    const auto fits = resource() ? std::max(size(), kInlineCapacity) : size();
+    if (isShared() || capacity() > fits || rep_.heap.data != rep_.heap.block->payload())
+      reallocate(size());
+  }
+
+  void ByteArrayData::clear() noexcept
+  {
+    // A bound array keeps its block, the next write detaches it.
+    if (isShared() && !resource())
+    {
+      release();
+      setInlineSize(0);
+      return;
+    }
+    setSize(0);
+  }
+
+  void ByteArrayData::resize(size_t size)
+  {
+    resize(size, 0);
+  }
+
+  void ByteArrayData::resize(size_t size, byte c)
+  {
+    const auto old_size = this->size();
+    if (size <= old_size)
+    {
+      // Other owners never see past their own size, so truncating is safe
+      // without detaching.
+      setSize(size);
+      return;
+    }
+    resizeForOverwrite(size);
+    memset(mutableData() + old_size, c, size - old_size);
+  }
+
+  void ByteArrayData::resizeForOverwrite(size_t size)
+  {
+    if (size > this->size() && (size > capacity() || !isWritable()))
+      reallocate(growCapacity(size));
+    setSize(size);
+  }
+
+  void ByteArrayData::assign(const byte* data, size_t size)
+  {
+    if (size == 0)
+    {
+      clear();
+      return;
+    }
+    if (isWritable() && size <= capacity())
+    {
+      memmove(mutableData(), data, size);
+      setSize(size);
+      return;
+    }
+    // The source may live in the buffer being replaced, so release it only
+    // after copying.
+    auto fresh = withCapacity(size, resource());
+    memcpy(fresh.mutableData(), data, size);
+    fresh.setSize(size);
+    swap(fresh);
+  }
+
+  void ByteArrayData::assign(size_t size, byte c)
+  {
+    clear();
+    resize(size, c);
+  }
+
+  void ByteArrayData::insert(size_t pos, const byte* data, size_t size)
+  {
+    if (size == 0)
+      return;
+    const auto old_size = this->size();
+    const auto begin = constData();
+    if (isWritable() && old_size + size <= capacity())
+    {
+      if (aliases(data, begin, old_size))
+      {
+        const ByteArrayData copy(data, size);
+        insert(pos, copy.data(), size);
+        return;
+      }
+      const auto target = mutableData();
+      memmove(target + pos + size, target + pos, old_size - pos);
+      memcpy(target + pos, data, size);
+      setSize(old_size + size);
+      return;
+    }
+    auto fresh = withCapacity(growCapacity(old_size + size), resource());
+    const auto target = fresh.mutableData();
+    memcpy(target, begin, pos);
+    memcpy(target + pos, data, size);
+    memcpy(target + pos + size, begin + pos, old_size - pos);
+    fresh.setSize(old_size + size);
+    swap(fresh);
+  }
+
+  void ByteArrayData::insert(size_t pos, size_t count, byte c)
+  {
+    if (count == 0)
+      return;
+    const auto old_size = size();
+    if (!isWritable() || old_size + count > capacity())
+      reallocate(growCapacity(old_size + count));
+    const auto target = mutableData();
+    memmove(target + pos + count, target + pos, old_size - pos);
+    memset(target + pos, c, count);
+    setSize(old_size + count);
+  }
+
+  void ByteArrayData::erase(size_t pos, size_t count)
+  {
+    if (count == 0)
+      return;
+    const auto old_size = size();
+    if (pos + count == old_size)
+    {
+      setSize(pos);
+      return;
+    }
+    if (pos == 0 && !isInline())
+    {
+      // Dropping a prefix only moves the start of this array in the block.
+      setHeap(rep_.heap.data + count, rep_.heap.block, old_size - count);
+      return;
+    }
+    if (!isWritable())
+    {
+      auto fresh = withCapacity(old_size - count, resource());
+      const auto target = fresh.mutableData();
+      memcpy(target, constData(), pos);
+      memcpy(target + pos, constData() + pos + count, old_size - pos - count);
+      fresh.setSize(old_size - count);
+      swap(fresh);
+      return;
+    }
+    const auto target = mutableData();
+    memmove(target + pos, target + pos + count, old_size - pos - count);
+    setSize(old_size - count);
+  }
+} // namespace Boron::Detail
@@ -0,0 +1,218 @@
+#include "Boron/ByteArrayMatcher.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include "ByteArrayAlgorithms.hpp"
+#include "CpuFeatures.hpp"
+
+namespace Boron
+{
+  namespace
+  {
+    // Needles up to this size are left to the vector kernel, whose stride is
+    // hard to beat with skip tables.
+    constexpr size_t kSimdMaxPattern = 64;
+    // Patterns made of at most this many distinct bytes make both the first+last
+    // filter and the Horspool skips degenerate.
+    constexpr size_t kSmallAlphabet = 2;
+
+    // Maximal suffix of pattern for the lexicographic order, or for the reversed
+    // order if reversed is set. Returns the position just before the suffix
+    // (possibly -1) and the period of the suffix.
+    std::pair<ptrdiff_t, ptrdiff_t> maximalSuffix(const byte* pattern, ptrdiff_t size, bool reversed)
+    {
+      ptrdiff_t max_suffix = -1, j = 0, k = 1, period = 1;
+      while (j + k < size)
+      {
+        const auto a = pattern[j + k];
+        const auto b = pattern[max_suffix + k];
+        if (reversed ? b < a : a < b)
+        {
+          j += k;
+          k = 1;
+          period = j - max_suffix;
+        }
+        else if (a == b)
+        {
+          if (k != period)
+          {
+            ++k;
+          }
+          else
+          {
+            j += period;
+            k = 1;
+          }
+        }
+        else
+        {
+          max_suffix = j++;
+          k = period = 1;
+        }
+      }
+      return {max_suffix, period};
+    }
+  } // namespace
+
+  ByteArrayMatcher::ByteArrayMatcher(ByteArrayView pattern)
+  {
+    setPattern(pattern);
+  }
+
+  ByteArrayMatcher::ByteArrayMatcher(ByteArrayView pattern, Strategy strategy)
+  {
+    setPattern(pattern, strategy);
+  }
+
+  void ByteArrayMatcher::setPattern(ByteArrayView pattern)
+  {
+    setPattern(pattern, defaultStrategy(pattern));
+  }
+
+  void ByteArrayMatcher::setPattern(ByteArrayView pattern, Strategy strategy)
+  {
+    pattern_ = pattern.toByteArray();
+    strategy_ = strategy;
+    const auto size = pattern_.size();
+    if (size < 2)
+    {
+      // Single bytes and the empty pattern are always answered by findByte.
+      strategy_ = Strategy::Simd;
+      return;
+    }
+
+    switch (strategy_)
+    {
+    case Strategy::Simd:
+      break;
+    case Strategy::TwoWay:
+      {
+        const auto n = static_cast<ptrdiff_t>(size);
+        const auto [forward, forward_period] = maximalSuffix(pattern_.data(), n, false);
+        const auto [backward, backward_period] = maximalSuffix(pattern_.data(), n, true);
+        const auto use_forward = forward >= backward;
+        suffix_ = static_cast<size_t>((use_forward ? forward : backward) + 1);
+        period_ = static_cast<size_t>(use_forward ? forward_period : backward_period);
+        periodic_ = period_ < size && memcmp(pattern_.data(), pattern_.data() + period_, suffix_) == 0;
+        if (!periodic_)
+          period_ = std::max(suffix_, size - suffix_) + 1;
+        break;
+      }
+    case Strategy::Horspool:
+      shift_.fill(size);
+      for (auto i = 0_sz; i + 1 < size; i++)
+        shift_[pattern_[i]] = size - 1 - i;
+      break;
+    }
+  }
+
+  ByteArrayMatcher::Strategy ByteArrayMatcher::defaultStrategy(ByteArrayView pattern)
+  {
+    if (pattern.size() < 2)
+      return Strategy::Simd;
+    std::bitset<256> alphabet;
+    for (auto c : pattern)
+      alphabet.set(c);
+    if (alphabet.count() <= kSmallAlphabet && pattern.size() > 4)
+      return Strategy::TwoWay;
+    if (pattern.size() > kSimdMaxPattern || !Detail::cpuFeatures().sse2)
+      return pattern.size() >= 8 ? Strategy::Horspool : Strategy::Simd;
+    return Strategy::Simd;
+  }
+
+  size_t ByteArrayMatcher::indexIn(ByteArrayView haystack, size_t from) const
+  {
+    const auto size = pattern_.size();
+    if (size < 2 || strategy_ == Strategy::Simd)
+      return Detail::findByteArray(haystack, from, pattern_);
+    if (from > haystack.size() || size > haystack.size() - from)
+      return ByteArray::kNpos;
+
+    const auto pos = strategy_ == Strategy::TwoWay
+      ? searchTwoWay(haystack.data() + from, haystack.size() - from)
+      : searchHorspool(haystack.data() + from, haystack.size() - from);
+    return pos == ByteArray::kNpos ? ByteArray::kNpos : pos + from;
+  }
+
+  size_t ByteArrayMatcher::countIn(ByteArrayView haystack) const
+  {
+    if (pattern_.isEmpty())
+      return haystack.size() + 1;
+    size_t count = 0;
+    forEachMatch(haystack, [&count](size_t) { ++count; });
+    return count;
+  }
+
+  size_t ByteArrayMatcher::searchTwoWay(const byte* haystack, size_t size) const
+  {
+    const auto needle = pattern_.data();
+    const auto n = static_cast<ptrdiff_t>(pattern_.size());
+    const auto last = static_cast<ptrdiff_t>(size) - n;
+    const auto suffix = static_cast<ptrdiff_t>(suffix_);
+    const auto period = static_cast<ptrdiff_t>(period_);
+    ptrdiff_t j = 0;
+    if (periodic_)
+    {
+      // The left part of the factorization repeats with the period, so what was
+      // matched on the previous alignment does not need to be compared again.
+      ptrdiff_t memory = 0;
+      while (j <= last)
+      {
+        auto i = std::max(suffix, memory);
+        while (i < n && needle[i] == haystack[i + j])
+          ++i;
+        if (i < n)
+        {
+          j += i - suffix + 1;
+          memory = 0;
+          continue;
+        }
+        i = suffix - 1;
+        while (i >= memory && needle[i] == haystack[i + j])
+          --i;
+        if (i < memory)
+          return static_cast<size_t>(j);
+        j += period;
+        memory = n - period;
+      }
+    }
+    else
+    {
+      while (j <= last)
+      {
+        auto i = suffix;
+        while (i < n && needle[i] == haystack[i + j])
+          ++i;
+        if (i < n)
+        {
+          j += i - suffix + 1;
+          continue;
+        }
+        i = suffix - 1;
+        while (i >= 0 && needle[i] == haystack[i + j])
+          --i;
+        if (i < 0)
+          return static_cast<size_t>(j);
+        j += period;
+      }
+    }
+    return ByteArray::kNpos;
+  }
+
+  size_t ByteArrayMatcher::searchHorspool(const byte* haystack, size_t size) const
+  {
+    const auto needle = pattern_.data();
+    const auto n = pattern_.size();
+    const auto tail = needle[n - 1];
+    for (size_t j = 0; j <= size - n;)
+    {
+      const auto c = haystack[j + n - 1];
+      if (c == tail && memcmp(haystack + j, needle, n - 1) == 0)
+        return j;
+      j += shift_[c];
+    }
+    return ByteArray::kNpos;
+  }
+} // namespace Boron
@@ -0,0 +1,123 @@
+#include "ByteTranslation.hpp"
+#include "CpuFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    using ReplaceByteFn = void (*)(byte* data, size_t size, byte before, byte after);
+    using TranslateFn = void (*)(byte* data, size_t size, const byte* table);
+
+    void replaceByteScalar(byte* data, size_t size, byte before, byte after)
+    {
+      for (size_t i = 0; i < size; i++)
+        data[i] = data[i] == before ? after : data[i];
+    }
+
+    void translateScalar(byte* data, size_t size, const byte* table)
+    {
+      for (size_t i = 0; i < size; i++)
+        data[i] = table[data[i]];
+    }
+
+#if BORON_ARCH_X86
+    // A matching byte is xored with before ^ after, which turns it into
+    // after and needs no blend.
+    BORON_TARGET("sse2")
+    void replaceByteSse2(byte* data, size_t size, byte before, byte after)
+    {
+      const auto needle = _mm_set1_epi8(static_cast<char>(before));
+      const auto flip = _mm_set1_epi8(static_cast<char>(before ^ after));
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto p = reinterpret_cast<__m128i*>(data + i);
+        const auto v = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_xor_si128(v, _mm_and_si128(_mm_cmpeq_epi8(v, needle), flip)));
+      }
+      replaceByteScalar(data + i, size - i, before, after);
+    }
+
+    BORON_TARGET("avx2")
+    void replaceByteAvx2(byte* data, size_t size, byte before, byte after)
+    {
+      const auto needle = _mm256_set1_epi8(static_cast<char>(before));
+      const auto flip = _mm256_set1_epi8(static_cast<char>(before ^ after));
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto p = reinterpret_cast<__m256i*>(data + i);
+        const auto v = _mm256_loadu_si256(p);
+        _mm256_storeu_si256(p, _mm256_xor_si256(v, _mm256_and_si256(_mm256_cmpeq_epi8(v, needle), flip)));
+      }
+      _mm256_zeroupper();
+      replaceByteSse2(data + i, size - i, before, after);
+    }
+
+    // The table as 16 rows of 16 entries, one per high nibble. For row r,
+    // b - 16 * r is below 16 only when b is in that row; adding 0x70 with
+    // saturation keeps its low nibble there and sets the high bit of every
+    // other byte, for which pshufb yields 0. Or-ing all 16 lookups leaves
+    // the one entry of each byte.
+    BORON_TARGET("avx2")
+    void translateAvx2(byte* data, size_t size, const byte* table)
+    {
+      __m256i rows[16];
+      for (int r = 0; r < 16; r++)
+        rows[r] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * r)));
+      const auto bias = _mm256_set1_epi8(0x70);
+      const auto step = _mm256_set1_epi8(16);
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto p = reinterpret_cast<__m256i*>(data + i);
+        auto v = _mm256_loadu_si256(p);
+        auto result = _mm256_setzero_si256();
+        for (int r = 0; r < 16; r++)
+        {
+          result = _mm256_or_si256(result, _mm256_shuffle_epi8(rows[r], _mm256_adds_epu8(v, bias)));
+          v = _mm256_sub_epi8(v, step);
+        }
+        _mm256_storeu_si256(p, result);
+      }
+      _mm256_zeroupper();
+      translateScalar(data + i, size - i, table);
+    }
+#endif
+
+    struct TranslationKernels
+    {
+      ReplaceByteFn replaceByte;
+      TranslateFn translate;
+    };
+
+    TranslationKernels selectTranslationKernels()
+    {
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx2)
+        return {replaceByteAvx2, translateAvx2};
+      if (features.sse2)
+        return {replaceByteSse2, translateScalar};
+#endif
+      return {replaceByteScalar, translateScalar};
+    }
+  } // namespace
+
+  void replaceByte(byte* data, size_t size, byte before, byte after)
+  {
+    dispatched<selectTranslationKernels>().replaceByte(data, size, before, after);
+  }
+
+  void translateBytes(byte* data, size_t size, const byte* table)
+  {
+    dispatched<selectTranslationKernels>().translate(data, size, table);
+  }
+} // namespace Boron::Detail
@@ -0,0 +1,16 @@
+#ifndef BORON_SRC_BYTETRANSLATION_HPP_
+#define BORON_SRC_BYTETRANSLATION_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // In place: every before in data becomes after.
+  void replaceByte(byte* data, size_t size, byte before, byte after);
+
+  // In place: every byte b in data becomes table[b], table having 256
+  // entries.
+  void translateBytes(byte* data, size_t size, const byte* table);
+} // namespace Boron::Detail
+
+#endif
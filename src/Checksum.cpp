@@ -0,0 +1,23 @@
+#include "Boron/Checksum.hpp"
+#include "ChecksumKernels.hpp"
+
+namespace Boron
+{
+  Crc32& Crc32::update(ByteArrayView data)
+  {
+    state_ = Detail::updateCrc32(state_, data.data(), data.size());
+    return *this;
+  }
+
+  Crc32c& Crc32c::update(ByteArrayView data)
+  {
+    state_ = Detail::updateCrc32c(state_, data.data(), data.size());
+    return *this;
+  }
+
+  Adler32& Adler32::update(ByteArrayView data)
+  {
+    state_ = Detail::updateAdler32(state_, data.data(), data.size());
+    return *this;
+  }
+} // namespace Boron
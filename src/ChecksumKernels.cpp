@@ -0,0 +1,264 @@
+#include "ChecksumKernels.hpp"
+#include "Boron/Endian.hpp"
+#include "CpuFeatures.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    using UpdateFn = uint32_t (*)(uint32_t state, const byte* data, size_t size);
+
+    // Slicing-by-8: tables[k][b] is the CRC of byte b followed by k zero
+    // bytes, so eight table lookups advance the register by eight bytes.
+    using CrcTables = std::array<std::array<uint32_t, 256>, 8>;
+
+    constexpr CrcTables makeCrcTables(uint32_t reflected_polynomial)
+    {
+      CrcTables tables{};
+      for (uint32_t i = 0; i < 256; i++)
+      {
+        auto crc = i;
+        for (int bit = 0; bit < 8; bit++)
+          crc = crc >> 1 ^ (crc & 1 ? reflected_polynomial : 0);
+        tables[0][i] = crc;
+      }
+      for (size_t k = 1; k < tables.size(); k++)
+      {
+        for (size_t i = 0; i < 256; i++)
+          tables[k][i] = tables[k - 1][i] >> 8 ^ tables[0][tables[k - 1][i] & 0xFF];
+      }
+      return tables;
+    }
+
+    constexpr CrcTables kCrc32Tables = makeCrcTables(0xEDB88320);
+    constexpr CrcTables kCrc32cTables = makeCrcTables(0x82F63B78);
+
+    uint32_t updateCrcSlicing(const CrcTables& t, uint32_t crc, const byte* data, size_t size)
+    {
+      for (; size >= 8; data += 8, size -= 8)
+      {
+        const auto word = loadEndian<uint64_t, std::endian::little>(data) ^ crc;
+        crc = t[7][word & 0xFF] ^ t[6][word >> 8 & 0xFF] ^ t[5][word >> 16 & 0xFF] ^ t[4][word >> 24 & 0xFF] ^
+          t[3][word >> 32 & 0xFF] ^ t[2][word >> 40 & 0xFF] ^ t[1][word >> 48 & 0xFF] ^ t[0][word >> 56];
+      }
+      for (; size; data++, size--)
+        crc = t[0][(crc ^ *data) & 0xFF] ^ crc >> 8;
+      return crc;
+    }
+
+    uint32_t updateCrc32Scalar(uint32_t crc, const byte* data, size_t size)
+    {
+      return updateCrcSlicing(kCrc32Tables, crc, data, size);
+    }
+
+    uint32_t updateCrc32cScalar(uint32_t crc, const byte* data, size_t size)
+    {
+      return updateCrcSlicing(kCrc32cTables, crc, data, size);
+    }
+
+    constexpr uint32_t kAdlerModulus = 65521;
+    // The most bytes that can be summed before s2 may overflow 32 bits.
+    constexpr size_t kAdlerMaxRun = 5552;
+
+    uint32_t updateAdler32Scalar(uint32_t adler, const byte* data, size_t size)
+    {
+      uint32_t s1 = adler & 0xFFFF;
+      uint32_t s2 = adler >> 16;
+      while (size)
+      {
+        const auto run = std::min(size, kAdlerMaxRun);
+        size -= run;
+        for (size_t i = 0; i < run; i++)
+        {
+          s1 += data[i];
+          s2 += s1;
+        }
+        data += run;
+        s1 %= kAdlerModulus;
+        s2 %= kAdlerModulus;
+      }
+      return s2 << 16 | s1;
+    }
+
+#if BORON_ARCH_X86
+    BORON_TARGET("sse4.1,pclmul")
+    __m128i load(const byte* p)
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    // Multiplies the two halves of x by the two constants in k, which moves
+    // them forward by the distance k stands for, and adds the next block.
+    BORON_TARGET("sse4.1,pclmul")
+    __m128i fold(__m128i x, __m128i k, __m128i next)
+    {
+      return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+    }
+
+    // Folding with carry-less multiplication, after Intel's "Fast CRC
+    // Computation for Generic Polynomials Using PCLMULQDQ": four 128-bit
+    // accumulators are folded 64 bytes ahead, then into one, then reduced to
+    // 32 bits with Barrett reduction. The constants are x^n mod P for the
+    // bit-reflected CRC-32 polynomial. Takes a multiple of 16 bytes, at least
+    // 64.
+    BORON_TARGET("sse4.1,pclmul")
+    uint32_t foldCrc32Pclmul(uint32_t crc, const byte* data, size_t size)
+    {
+      const auto k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+      const auto k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+      const auto k5 = _mm_set_epi64x(0, 0x0163cd6124);
+      const auto poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+      const auto low32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+      auto x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+      auto x2 = load(data + 16);
+      auto x3 = load(data + 32);
+      auto x4 = load(data + 48);
+      data += 64;
+      size -= 64;
+      for (; size >= 64; data += 64, size -= 64)
+      {
+        x1 = fold(x1, k1k2, load(data));
+        x2 = fold(x2, k1k2, load(data + 16));
+        x3 = fold(x3, k1k2, load(data + 32));
+        x4 = fold(x4, k1k2, load(data + 48));
+      }
+      x1 = fold(x1, k3k4, x2);
+      x1 = fold(x1, k3k4, x3);
+      x1 = fold(x1, k3k4, x4);
+      for (; size >= 16; data += 16, size -= 16)
+        x1 = fold(x1, k3k4, load(data));
+
+      // 128 to 64 bits, then 64 to 32.
+      auto t = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+      x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+      t = _mm_srli_si128(x1, 4);
+      x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, low32), k5, 0x00), t);
+
+      // Barrett reduction.
+      t = _mm_clmulepi64_si128(_mm_and_si128(x1, low32), poly, 0x10);
+      t = _mm_clmulepi64_si128(_mm_and_si128(t, low32), poly, 0x00);
+      x1 = _mm_xor_si128(x1, t);
+      return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+    }
+
+    BORON_TARGET("sse4.1,pclmul")
+    uint32_t updateCrc32Pclmul(uint32_t crc, const byte* data, size_t size)
+    {
+      if (size >= 64)
+      {
+        const auto folded = size & ~size_t{15};
+        crc = foldCrc32Pclmul(crc, data, folded);
+        data += folded;
+        size -= folded;
+      }
+      return updateCrc32Scalar(crc, data, size);
+    }
+
+    BORON_TARGET("sse4.2")
+    uint32_t updateCrc32cSse42(uint32_t crc, const byte* data, size_t size)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+      uint64_t crc64 = crc;
+      for (; size >= 8; data += 8, size -= 8)
+        crc64 = _mm_crc32_u64(crc64, loadEndian<uint64_t, std::endian::little>(data));
+      crc = static_cast<uint32_t>(crc64);
+#endif
+      for (; size >= 4; data += 4, size -= 4)
+        crc = _mm_crc32_u32(crc, loadEndian<uint32_t, std::endian::little>(data));
+      for (; size; data++, size--)
+        crc = _mm_crc32_u8(crc, *data);
+      return crc;
+    }
+
+    // Thirty-two bytes per step: psadbw adds them up for s1, and pmaddubsw
+    // weighs them by 32 down to 1 for s2, which also gains 32 times the s1 of
+    // the steps before. The sums stay in 32-bit lanes for up to
+    // kAdlerMaxRun bytes.
+    BORON_TARGET("ssse3")
+    uint32_t updateAdler32Ssse3(uint32_t adler, const byte* data, size_t size)
+    {
+      constexpr size_t kStep = 32;
+      uint32_t s1 = adler & 0xFFFF;
+      uint32_t s2 = adler >> 16;
+      const auto first_weights = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+      const auto second_weights = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+      const auto zero = _mm_setzero_si128();
+      const auto ones = _mm_set1_epi16(1);
+      auto steps = size / kStep;
+      size -= steps * kStep;
+      while (steps)
+      {
+        const auto n = std::min(steps, kAdlerMaxRun / kStep);
+        steps -= n;
+        // Sum of s1 before each step, with the s1 carried in for all of them.
+        auto prefix = _mm_cvtsi32_si128(static_cast<int>(s1 * n));
+        auto v_s1 = zero;
+        auto v_s2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+        for (size_t i = 0; i < n; i++, data += kStep)
+        {
+          const auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+          const auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+          prefix = _mm_add_epi32(prefix, v_s1);
+          v_s1 = _mm_add_epi32(v_s1, _mm_add_epi32(_mm_sad_epu8(first, zero), _mm_sad_epu8(second, zero)));
+          v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(first, first_weights), ones));
+          v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(second, second_weights), ones));
+        }
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(prefix, 5));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 = (s1 + static_cast<uint32_t>(_mm_cvtsi128_si32(v_s1))) % kAdlerModulus;
+        s2 = static_cast<uint32_t>(_mm_cvtsi128_si32(v_s2)) % kAdlerModulus;
+      }
+      return updateAdler32Scalar(s2 << 16 | s1, data, size);
+    }
+#endif
+
+    struct ChecksumKernels
+    {
+      UpdateFn crc32;
+      UpdateFn crc32c;
+      UpdateFn adler32;
+    };
+
+    ChecksumKernels selectChecksumKernels()
+    {
+      ChecksumKernels kernels{updateCrc32Scalar, updateCrc32cScalar, updateAdler32Scalar};
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.pclmul && features.sse41)
+        kernels.crc32 = updateCrc32Pclmul;
+      if (features.sse42)
+        kernels.crc32c = updateCrc32cSse42;
+      if (features.ssse3)
+        kernels.adler32 = updateAdler32Ssse3;
+#endif
+      return kernels;
+    }
+  } // namespace
+
+  uint32_t updateCrc32(uint32_t crc, const byte* data, size_t size)
+  {
+    return dispatched<selectChecksumKernels>().crc32(crc, data, size);
+  }
+
+  uint32_t updateCrc32c(uint32_t crc, const byte* data, size_t size)
+  {
+    return dispatched<selectChecksumKernels>().crc32c(crc, data, size);
+  }
+
+  uint32_t updateAdler32(uint32_t adler, const byte* data, size_t size)
+  {
+    return dispatched<selectChecksumKernels>().adler32(adler, data, size);
+  }
+} // namespace Boron::Detail
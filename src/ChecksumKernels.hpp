@@ -0,0 +1,15 @@
+#ifndef BORON_SRC_CHECKSUMKERNELS_HPP_
+#define BORON_SRC_CHECKSUMKERNELS_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // The CRCs take and return the register before the final inversion, so a
+  // checksum starts from ~0 and ends with ~crc. Adler-32 starts from 1.
+  uint32_t updateCrc32(uint32_t crc, const byte* data, size_t size);
+  uint32_t updateCrc32c(uint32_t crc, const byte* data, size_t size);
+  uint32_t updateAdler32(uint32_t adler, const byte* data, size_t size);
+} // namespace Boron::Detail
+
+#endif
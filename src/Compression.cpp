@@ -0,0 +1,255 @@
+#include "Boron/Compression.hpp"
+#include "Boron/Varint.hpp"
+#include "Lz4Codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Boron
+{
+  namespace
+  {
+    constexpr size_t kMaxPayloadSize = Detail::lz4CompressBound(kCompressionBlockSize);
+    // Headers are written without padding, so longer ones are rejected.
+    constexpr size_t kMaxHeaderSize = varintSize(kCompressionBlockSize) + varintSize(kMaxPayloadSize);
+
+    struct FrameHeader
+    {
+      size_t block_size = 0;
+      // 0 for a block stored as is.
+      size_t payload_size = 0;
+      size_t header_size = 0;
+
+      BORON_NODISCARD size_t frameSize() const { return header_size + (payload_size ? payload_size : block_size); }
+    };
+
+    UncompressStatus readSize(const byte* in, size_t size, size_t max, size_t& value, size_t& consumed)
+    {
+      uint64_t v;
+      const auto n = decodeVarint(in, std::min(size, varintSize(max)), v);
+      if (n == 0)
+        return size < varintSize(max) ? UncompressStatus::TruncatedData : UncompressStatus::CorruptData;
+      if (v > max)
+        return UncompressStatus::CorruptData;
+      value = static_cast<size_t>(v);
+      consumed = n;
+      return UncompressStatus::Ok;
+    }
+
+    UncompressStatus readHeader(const byte* in, size_t size, FrameHeader& header)
+    {
+      size_t block_varint = 0;
+      size_t payload_varint = 0;
+      auto status = readSize(in, size, kCompressionBlockSize, header.block_size, block_varint);
+      if (status != UncompressStatus::Ok)
+        return status;
+      if (header.block_size == 0)
+        return UncompressStatus::CorruptData;
+      status = readSize(in + block_varint, size - block_varint, kMaxPayloadSize, header.payload_size, payload_varint);
+      header.header_size = block_varint + payload_varint;
+      return status;
+    }
+
+    bool decodeFrame(const byte* frame, const FrameHeader& header, byte* out)
+    {
+      const auto payload = frame + header.header_size;
+      if (header.payload_size == 0)
+      {
+        memcpy(out, payload, header.block_size);
+        return true;
+      }
+      return Detail::lz4Decompress(payload, header.payload_size, out, header.block_size);
+    }
+
+    void writeFrame(const byte* block, size_t size, ByteArray& out)
+    {
+      const auto old_size = out.size();
+      const auto bound = Detail::lz4CompressBound(size);
+      const auto block_varint = varintSize(size);
+      // Room for the largest payload size, the payload moves down if its
+      // size turns out shorter.
+      const auto reserved = varintSize(bound);
+      out.resizeForOverwrite(old_size + block_varint + reserved + bound);
+      const auto frame = out.data() + old_size;
+      encodeVarint(size, frame);
+      const auto payload = frame + block_varint + reserved;
+      const auto payload_size = Detail::lz4Compress(block, size, payload);
+      if (payload_size >= size)
+      {
+        frame[block_varint] = 0;
+        memcpy(frame + block_varint + 1, block, size);
+        out.resize(old_size + block_varint + 1 + size);
+        return;
+      }
+      const auto payload_varint = encodeVarint(payload_size, frame + block_varint);
+      if (payload_varint < reserved)
+        memmove(frame + block_varint + payload_varint, payload, payload_size);
+      out.resize(old_size + block_varint + payload_varint + payload_size);
+    }
+
+    // Checks the frame headers and sizes of data and sums the block sizes.
+    UncompressStatus scanFrames(ByteArrayView data, size_t& total)
+    {
+      total = 0;
+      for (size_t pos = 0; pos < data.size();)
+      {
+        FrameHeader header;
+        const auto status = readHeader(data.data() + pos, data.size() - pos, header);
+        if (status != UncompressStatus::Ok)
+          return status;
+        if (header.frameSize() > data.size() - pos)
+          return UncompressStatus::TruncatedData;
+        total += header.block_size;
+        pos += header.frameSize();
+      }
+      return UncompressStatus::Ok;
+    }
+  } // namespace
+
+  ByteArray compress(ByteArrayView data)
+  {
+    ByteArray result;
+    Compressor compressor;
+    compressor.feed(data, result);
+    compressor.finish(result);
+    return result;
+  }
+
+  ByteArray uncompress(ByteArrayView data)
+  {
+    ByteArray result;
+    if (uncompress(data, result) != UncompressStatus::Ok)
+      return {};
+    return result;
+  }
+
+  UncompressStatus uncompress(ByteArrayView data, ByteArray& out)
+  {
+    out.clear();
+    size_t total = 0;
+    const auto status = scanFrames(data, total);
+    if (status != UncompressStatus::Ok)
+      return status;
+    out.resizeForOverwrite(total);
+    auto dest = out.data();
+    for (size_t pos = 0; pos < data.size();)
+    {
+      FrameHeader header;
+      readHeader(data.data() + pos, data.size() - pos, header);
+      if (!decodeFrame(data.data() + pos, header, dest))
+      {
+        out.clear();
+        return UncompressStatus::CorruptData;
+      }
+      dest += header.block_size;
+      pos += header.frameSize();
+    }
+    return UncompressStatus::Ok;
+  }
+
+  size_t uncompressedSize(ByteArrayView data)
+  {
+    size_t total = 0;
+    return scanFrames(data, total) == UncompressStatus::Ok ? total : ByteArray::kNpos;
+  }
+
+  void Compressor::feed(ByteArrayView chunk, ByteArray& out)
+  {
+    auto in = chunk.data();
+    auto size = chunk.size();
+    if (!pending_.isEmpty())
+    {
+      const auto n = std::min(size, kCompressionBlockSize - pending_.size());
+      pending_.append(ByteArrayView(in, n));
+      in += n;
+      size -= n;
+      if (pending_.size() < kCompressionBlockSize)
+        return;
+      writeFrame(pending_.constData(), pending_.size(), out);
+      pending_.clear();
+    }
+    for (; size >= kCompressionBlockSize; in += kCompressionBlockSize, size -= kCompressionBlockSize)
+      writeFrame(in, kCompressionBlockSize, out);
+    if (size)
+      pending_.append(ByteArrayView(in, size));
+  }
+
+  void Compressor::finish(ByteArray& out)
+  {
+    if (!pending_.isEmpty())
+      writeFrame(pending_.constData(), pending_.size(), out);
+    pending_.clear();
+  }
+
+  UncompressStatus Decompressor::feed(ByteArrayView chunk, ByteArray& out)
+  {
+    auto in = chunk.data();
+    auto size = chunk.size();
+    while (size && status_ == UncompressStatus::Ok)
+    {
+      if (pending_.isEmpty())
+      {
+        const auto n = decodeFrames(ByteArrayView(in, size), out);
+        if (status_ == UncompressStatus::Ok && n < size)
+          pending_.append(ByteArrayView(in + n, size - n));
+        break;
+      }
+      // Completes the frame split from the previous chunk: its header first,
+      // then exactly the rest of it.
+      FrameHeader header;
+      const auto status = readHeader(pending_.constData(), pending_.size(), header);
+      if (status == UncompressStatus::CorruptData)
+      {
+        status_ = status;
+        break;
+      }
+      const auto wanted = status == UncompressStatus::Ok ? header.frameSize() : kMaxHeaderSize;
+      const auto n = std::min(size, wanted - pending_.size());
+      pending_.append(ByteArrayView(in, n));
+      in += n;
+      size -= n;
+      pending_.remove(0, decodeFrames(ByteArrayView(pending_), out));
+    }
+    return status_;
+  }
+
+  UncompressStatus Decompressor::finish()
+  {
+    if (status_ == UncompressStatus::Ok && !pending_.isEmpty())
+      status_ = UncompressStatus::TruncatedData;
+    return status_;
+  }
+
+  void Decompressor::reset()
+  {
+    pending_.clear();
+    status_ = UncompressStatus::Ok;
+  }
+
+  size_t Decompressor::decodeFrames(ByteArrayView data, ByteArray& out)
+  {
+    size_t pos = 0;
+    while (pos < data.size())
+    {
+      FrameHeader header;
+      const auto status = readHeader(data.data() + pos, data.size() - pos, header);
+      if (status == UncompressStatus::CorruptData)
+      {
+        status_ = status;
+        break;
+      }
+      if (status == UncompressStatus::TruncatedData || header.frameSize() > data.size() - pos)
+        break;
+      const auto old_size = out.size();
+      out.resizeForOverwrite(old_size + header.block_size);
+      if (!decodeFrame(data.data() + pos, header, out.data() + old_size))
+      {
+        out.resize(old_size);
+        status_ = UncompressStatus::CorruptData;
+        break;
+      }
+      pos += header.frameSize();
+    }
+    return pos;
+  }
+} // namespace Boron
@@ -0,0 +1,58 @@
+#include "CpuFeatures.hpp"
+
+#if BORON_ARCH_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    CpuFeatures detectCpuFeatures()
+    {
+      CpuFeatures features;
+#if BORON_ARCH_X86 && defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 0);
+      const int maxLeaf = info[0];
+      __cpuid(info, 1);
+      features.sse2 = (info[3] & (1 << 26)) != 0;
+      features.ssse3 = (info[2] & (1 << 9)) != 0;
+      features.sse41 = (info[2] & (1 << 19)) != 0;
+      features.sse42 = (info[2] & (1 << 20)) != 0;
+      features.popcnt = (info[2] & (1 << 23)) != 0;
+      features.pclmul = (info[2] & (1 << 1)) != 0;
+      // AVX state has to be enabled by the OS as well, see XCR0.
+      const bool osxsave = (info[2] & (1 << 27)) != 0;
+      const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+      const bool ymmState = (xcr0 & 0x06) == 0x06;
+      const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+      if (maxLeaf >= 7)
+      {
+        __cpuidex(info, 7, 0);
+        features.avx2 = ymmState && (info[1] & (1 << 5)) != 0;
+        features.bmi2 = (info[1] & (1 << 8)) != 0;
+        features.avx512bw = zmmState && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0;
+      }
+#elif BORON_ARCH_X86
+      __builtin_cpu_init();
+      features.sse2 = __builtin_cpu_supports("sse2") != 0;
+      features.ssse3 = __builtin_cpu_supports("ssse3") != 0;
+      features.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+      features.sse42 = __builtin_cpu_supports("sse4.2") != 0;
+      features.popcnt = __builtin_cpu_supports("popcnt") != 0;
+      features.pclmul = __builtin_cpu_supports("pclmul") != 0;
+      features.avx2 = __builtin_cpu_supports("avx2") != 0;
+      features.bmi2 = __builtin_cpu_supports("bmi2") != 0;
+      features.avx512bw = __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512bw") != 0;
+#endif
+      return features;
+    }
+  } // namespace
+
+  const CpuFeatures& cpuFeatures()
+  {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+  }
+} // namespace Boron::Detail
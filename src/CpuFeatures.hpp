@@ -0,0 +1,51 @@
+#ifndef BORON_SRC_CPUFEATURES_HPP_
+#define BORON_SRC_CPUFEATURES_HPP_
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && \
+  !defined(BORON_DISABLE_SIMD)
+#define BORON_ARCH_X86 1
+#else
+#define BORON_ARCH_X86 0
+#endif
+
+// Per-function instruction set selection, so that a single translation unit can
+// carry kernels for several ISAs and pick one at runtime. MSVC exposes every
+// intrinsic unconditionally and needs no annotation.
+#if defined(__GNUC__) || defined(__clang__)
+#define BORON_TARGET(features) __attribute__((target(features)))
+#else
+#define BORON_TARGET(features)
+#endif
+
+namespace Boron::Detail
+{
+  struct CpuFeatures
+  {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool popcnt = false;
+    bool pclmul = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512bw = false;
+  };
+
+  // Detected once, on first use. All flags are false when BORON_DISABLE_SIMD is
+  // defined or the target is not x86.
+  const CpuFeatures& cpuFeatures();
+
+  // What Select() picks for this CPU, chosen on first use. A function-local
+  // static instead of a namespace-scope table, so that a call from another
+  // translation unit's static initializer cannot run before the choice is
+  // made and find it empty.
+  template <auto Select>
+  const auto& dispatched()
+  {
+    static const auto kernels = Select();
+    return kernels;
+  }
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,114 @@
+#include "Boron/ByteArray.hpp"
+#include "Boron/Endian.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace Boron
+{
+  namespace
+  {
+    // wyhash (final version 4) by Wang Yi, public domain: one 64x64->128 bit
+    // multiply folds 16 bytes, three independent lanes cover long inputs and
+    // inputs up to 16 bytes need at most four loads and no loop.
+    constexpr uint64_t kSecret[4] = {0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3,
+                                     0x4d5a2da51de1aa47};
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Uint128;
+#endif
+
+    void multiply(uint64_t& a, uint64_t& b)
+    {
+#if defined(__SIZEOF_INT128__)
+      const auto product = static_cast<Uint128>(a) * b;
+      a = static_cast<uint64_t>(product);
+      b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+      a = _umul128(a, b, &b);
+#else
+      const auto ha = a >> 32, hb = b >> 32, la = a & 0xFFFFFFFF, lb = b & 0xFFFFFFFF;
+      const auto hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+      const auto mid = (ll >> 32) + (hl & 0xFFFFFFFF) + (lh & 0xFFFFFFFF);
+      a = (mid << 32) | (ll & 0xFFFFFFFF);
+      b = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+    }
+
+    uint64_t mix(uint64_t a, uint64_t b)
+    {
+      multiply(a, b);
+      return a ^ b;
+    }
+
+    uint64_t read8(const byte* p) { return loadEndian<uint64_t, std::endian::little>(p); }
+    uint64_t read4(const byte* p) { return loadEndian<uint32_t, std::endian::little>(p); }
+
+    // One, two or three bytes, read without a branch on the length.
+    uint64_t read3(const byte* p, size_t n)
+    {
+      return static_cast<uint64_t>(p[0]) << 16 | static_cast<uint64_t>(p[n >> 1]) << 8 | p[n - 1];
+    }
+
+    uint64_t wyhash(const byte* p, size_t size, uint64_t seed)
+    {
+      seed ^= mix(seed ^ kSecret[0], kSecret[1]);
+      uint64_t a = 0;
+      uint64_t b = 0;
+      if (size <= 16)
+      {
+        if (size >= 4)
+        {
+          // Two overlapping pairs of 4-byte reads cover 4 to 16 bytes.
+          const auto offset = (size >> 3) << 2;
+          a = read4(p) << 32 | read4(p + offset);
+          b = read4(p + size - 4) << 32 | read4(p + size - 4 - offset);
+        }
+        else if (size > 0)
+        {
+          a = read3(p, size);
+        }
+      }
+      else
+      {
+        auto i = size;
+        if (i >= 48)
+        {
+          auto seed1 = seed;
+          auto seed2 = seed;
+          do
+          {
+            seed = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ seed);
+            seed1 = mix(read8(p + 16) ^ kSecret[2], read8(p + 24) ^ seed1);
+            seed2 = mix(read8(p + 32) ^ kSecret[3], read8(p + 40) ^ seed2);
+            p += 48;
+            i -= 48;
+          } while (i >= 48);
+          seed ^= seed1 ^ seed2;
+        }
+        while (i > 16)
+        {
+          seed = mix(read8(p) ^ kSecret[1], read8(p + 8) ^ seed);
+          p += 16;
+          i -= 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+      }
+      a ^= kSecret[1];
+      b ^= seed;
+      multiply(a, b);
+      return mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+    }
+  } // namespace
+
+  size_t hash(ByteArrayView key, size_t seed) noexcept
+  {
+    return static_cast<size_t>(wyhash(key.data(), key.size(), seed));
+  }
+} // namespace Boron
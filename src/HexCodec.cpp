@@ -0,0 +1,244 @@
+#include "HexCodec.hpp"
+#include "ByteArrayAlgorithms.hpp"
+#include "CpuFeatures.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr char kHexDigits[] = "0123456789ABCDEF";
+    constexpr byte kInvalidNibble = 0xFF;
+
+    constexpr auto kNibbleTable = [] {
+      std::array<byte, 256> table{};
+      table.fill(kInvalidNibble);
+      for (int c = '0'; c <= '9'; c++)
+        table[c] = static_cast<byte>(c - '0');
+      for (int c = 'A'; c <= 'F'; c++)
+      {
+        table[c] = static_cast<byte>(c - 'A' + 10);
+        table[c - 'A' + 'a'] = static_cast<byte>(c - 'A' + 10);
+      }
+      return table;
+    }();
+
+    // Kernels without separators: encoders write 2 * size characters, decoders
+    // take an even size and follow the contract of decodeHex().
+    using EncodeFn = void (*)(const byte* data, size_t size, char* out);
+    using DecodeFn = size_t (*)(const char* hex, size_t size, byte* out);
+
+    void encodeHexScalar(const byte* data, size_t size, char* out)
+    {
+      for (size_t i = 0; i < size; i++)
+      {
+        out[2 * i] = kHexDigits[data[i] >> 4];
+        out[2 * i + 1] = kHexDigits[data[i] & 0x0F];
+      }
+    }
+
+    size_t decodeHexScalar(const char* hex, size_t size, byte* out)
+    {
+      for (size_t i = 0; i < size; i += 2)
+      {
+        const auto hi = kNibbleTable[static_cast<byte>(hex[i])];
+        if (hi == kInvalidNibble)
+          return i;
+        const auto lo = kNibbleTable[static_cast<byte>(hex[i + 1])];
+        if (lo == kInvalidNibble)
+          return i + 1;
+        out[i / 2] = static_cast<byte>(hi << 4 | lo);
+      }
+      return kNotFound;
+    }
+
+#if BORON_ARCH_X86
+    // The AVX2 kernels finish with narrower ones compiled for legacy SSE, and
+    // have to clear the upper register halves first: running SSE code with
+    // dirty upper halves costs a state transition or a false dependency on
+    // every instruction, which dominated short inputs.
+    //
+    // The upper and lower nibble of every byte index a 16-entry digit table
+    // with pshufb; interleaving the two results gives the digits in order.
+    BORON_TARGET("ssse3")
+    void encodeHexSsse3(const byte* data, size_t size, char* out)
+    {
+      const auto digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexDigits));
+      const auto low_mask = _mm_set1_epi8(0x0F);
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(block, 4), low_mask));
+        const auto lo = _mm_shuffle_epi8(digits, _mm_and_si128(block, low_mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+      }
+      encodeHexScalar(data + i, size - i, out + 2 * i);
+    }
+
+    BORON_TARGET("avx2")
+    void encodeHexAvx2(const byte* data, size_t size, char* out)
+    {
+      const auto digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexDigits)));
+      const auto low_mask = _mm256_set1_epi8(0x0F);
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask));
+        const auto lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(block, low_mask));
+        // Unpacking works per 128-bit lane, the permutes put the lanes in order.
+        const auto first = _mm256_unpacklo_epi8(hi, lo);
+        const auto second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+      }
+      _mm256_zeroupper();
+      encodeHexSsse3(data + i, size - i, out + 2 * i);
+    }
+
+    // Nibble values of 16 characters. valid gets 0xFF for every hex digit; the
+    // unsigned range checks are min-and-compare, as SSE2 only compares signed.
+    BORON_TARGET("sse2")
+    __m128i nibblesSse2(__m128i chars, __m128i& valid)
+    {
+      const auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+      const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+      const auto letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+      const auto is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+      valid = _mm_or_si128(is_digit, is_letter);
+      return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                          _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    // Each 16-bit lane holds the high nibble in its low byte and the low
+    // nibble in its high byte; this folds them into the low byte.
+    BORON_TARGET("sse2")
+    __m128i combineNibblesSse2(__m128i nibbles)
+    {
+      const auto merged = _mm_or_si128(_mm_slli_epi16(nibbles, 4), _mm_srli_epi16(nibbles, 8));
+      return _mm_and_si128(merged, _mm_set1_epi16(0x00FF));
+    }
+
+    BORON_TARGET("sse2")
+    size_t decodeHexSse2(const char* hex, size_t size, byte* out)
+    {
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        __m128i valid_first, valid_second;
+        const auto first = nibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i)), valid_first);
+        const auto second = nibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i + 16)), valid_second);
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(valid_first)) |
+          static_cast<uint32_t>(_mm_movemask_epi8(valid_second)) << 16;
+        if (mask != 0xFFFFFFFF)
+          return i + std::countr_zero(~mask);
+        const auto bytes = _mm_packus_epi16(combineNibblesSse2(first), combineNibblesSse2(second));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), bytes);
+      }
+      const auto pos = decodeHexScalar(hex + i, size - i, out + i / 2);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+
+    BORON_TARGET("avx2")
+    __m256i nibblesAvx2(__m256i chars, __m256i& valid)
+    {
+      const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+      const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+      const auto letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+      const auto is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+      valid = _mm256_or_si256(is_digit, is_letter);
+      return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                             _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    }
+
+    BORON_TARGET("avx2")
+    __m256i combineNibblesAvx2(__m256i nibbles)
+    {
+      const auto merged = _mm256_or_si256(_mm256_slli_epi16(nibbles, 4), _mm256_srli_epi16(nibbles, 8));
+      return _mm256_and_si256(merged, _mm256_set1_epi16(0x00FF));
+    }
+
+    BORON_TARGET("avx2")
+    size_t decodeHexAvx2(const char* hex, size_t size, byte* out)
+    {
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64)
+      {
+        __m256i valid_first, valid_second;
+        const auto first = nibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i)), valid_first);
+        const auto second =
+          nibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i + 32)), valid_second);
+        const auto mask = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(valid_first))) |
+          static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(valid_second))) << 32;
+        if (mask != ~uint64_t(0))
+          return i + std::countr_zero(~mask);
+        // Packing interleaves the 128-bit lanes of both inputs.
+        const auto packed = _mm256_packus_epi16(combineNibblesAvx2(first), combineNibblesAvx2(second));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+      }
+      _mm256_zeroupper();
+      const auto pos = decodeHexSse2(hex + i, size - i, out + i / 2);
+      return pos == kNotFound ? kNotFound : pos + i;
+    }
+#endif
+
+    struct HexKernels
+    {
+      EncodeFn encode;
+      DecodeFn decode;
+    };
+
+    HexKernels selectHexKernels()
+    {
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx2)
+        return {encodeHexAvx2, decodeHexAvx2};
+      if (features.ssse3)
+        return {encodeHexSsse3, decodeHexSse2};
+      if (features.sse2)
+        return {encodeHexScalar, decodeHexSse2};
+#endif
+      return {encodeHexScalar, decodeHexScalar};
+    }
+  } // namespace
+
+  size_t hexEncodedSize(size_t size, char separator)
+  {
+    if (size == 0)
+      return 0;
+    return separator ? 3 * size - 1 : 2 * size;
+  }
+
+  void encodeHex(ByteArrayView data, char* out, char separator)
+  {
+    if (!separator)
+    {
+      dispatched<selectHexKernels>().encode(data.data(), data.size(), out);
+      return;
+    }
+    for (size_t i = 0; i < data.size(); i++)
+    {
+      if (i)
+        *out++ = separator;
+      *out++ = kHexDigits[data[i] >> 4];
+      *out++ = kHexDigits[data[i] & 0x0F];
+    }
+  }
+
+  size_t decodeHex(const char* hex, size_t size, byte* out)
+  {
+    return dispatched<selectHexKernels>().decode(hex, size, out);
+  }
+} // namespace Boron::Detail
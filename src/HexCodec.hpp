@@ -0,0 +1,19 @@
+#ifndef BORON_SRC_HEXCODEC_HPP_
+#define BORON_SRC_HEXCODEC_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // Characters produced by encodeHex(): two upper case digits per byte, plus
+  // one separator between every two bytes when separator is not zero.
+  size_t hexEncodedSize(size_t size, char separator);
+  void encodeHex(ByteArrayView data, char* out, char separator);
+
+  // Decodes size / 2 bytes from an even number of digits of either case.
+  // Returns kNotFound on success, otherwise the offset of the first character
+  // that is not a hex digit; out is partially written in that case.
+  size_t decodeHex(const char* hex, size_t size, byte* out);
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,248 @@
+#include "Lz4Codec.hpp"
+#include "Boron/Endian.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr size_t kMinMatch = 4;
+    // The format wants the last match to start at least kMatchFindLimit bytes
+    // before the end and the last kLastLiterals bytes to be literals.
+    constexpr size_t kMatchFindLimit = 12;
+    constexpr size_t kLastLiterals = 5;
+    constexpr size_t kMaxOffset = 65535;
+    // Lengths of 15 and more continue in the bytes after the token.
+    constexpr size_t kLengthMask = 15;
+
+    // The hash table holds the last position of every hashed 4-byte prefix.
+    // Small inputs use a smaller table, so that clearing it does not dominate.
+    constexpr int kMinHashLog = 6;
+    constexpr int kMaxHashLog = 14;
+    // The search step grows by one every 2^kSkipShift misses, which skips
+    // quickly over incompressible data.
+    constexpr int kSkipShift = 6;
+
+    uint32_t load32(const byte* p)
+    {
+      return loadEndian<uint32_t, std::endian::little>(p);
+    }
+
+    uint64_t load64(const byte* p)
+    {
+      return loadEndian<uint64_t, std::endian::little>(p);
+    }
+
+    // Hashes five bytes, so that matches of only four are rarely proposed:
+    // they barely pay for their sequence, and on data with a small alphabet
+    // chasing them slows compression down severalfold.
+    uint32_t hashOf(const byte* p, int hash_log)
+    {
+      return static_cast<uint32_t>((load64(p) << 24) * 0xCF1BBCDCBB >> (64 - hash_log));
+    }
+
+    // Number of equal bytes at a and b, stopping at limit.
+    size_t matchLength(const byte* a, const byte* b, const byte* limit)
+    {
+      const auto start = a;
+      for (; a + 8 <= limit; a += 8, b += 8)
+      {
+        const auto diff = load64(a) ^ load64(b);
+        if (diff)
+          return a - start + std::countr_zero(diff) / 8;
+      }
+      while (a < limit && *a == *b)
+      {
+        ++a;
+        ++b;
+      }
+      return a - start;
+    }
+
+    byte* writeExtraLength(byte* out, size_t length)
+    {
+      for (length -= kLengthMask; length >= 255; length -= 255)
+        *out++ = 255;
+      *out++ = static_cast<byte>(length);
+      return out;
+    }
+
+    byte* writeLiterals(byte* out, const byte* literals, size_t count)
+    {
+      const auto token = out++;
+      *token = static_cast<byte>(std::min(count, kLengthMask) << 4);
+      if (count >= kLengthMask)
+        out = writeExtraLength(out, count);
+      memcpy(out, literals, count);
+      return out + count;
+    }
+
+    byte* writeSequence(byte* out, const byte* literals, size_t count, size_t offset, size_t length)
+    {
+      const auto token = out;
+      out = writeLiterals(out, literals, count);
+      storeEndian<std::endian::little>(static_cast<uint16_t>(offset), out);
+      out += 2;
+      length -= kMinMatch;
+      *token |= static_cast<byte>(std::min(length, kLengthMask));
+      if (length >= kLengthMask)
+        out = writeExtraLength(out, length);
+      return out;
+    }
+
+    bool readExtraLength(const byte*& in, const byte* end, size_t& length)
+    {
+      byte b;
+      do
+      {
+        if (in == end)
+          return false;
+        b = *in++;
+        length += b;
+      } while (b == 255);
+      return true;
+    }
+
+    // Copies a match of length bytes from offset bytes back. The source may
+    // overlap the destination, which repeats the last offset bytes.
+    void copyMatch(byte* out, size_t offset, size_t length, const byte* out_end)
+    {
+      auto match = out - offset;
+      const auto end = out + length;
+      // Copying in fixed-size chunks may write up to fifteen bytes past the
+      // match, which the following sequences overwrite.
+      if (out_end - end >= 16)
+      {
+        if (offset >= 16)
+        {
+          do
+          {
+            memcpy(out, match, 16);
+            out += 16;
+            match += 16;
+          } while (out < end);
+          return;
+        }
+        if (offset < 8)
+        {
+          // Byte by byte until a whole number of periods of at least eight
+          // bytes precedes the output, then copy from that far back.
+          const auto distance = offset * ((8 + offset - 1) / offset);
+          for (auto n = distance - offset; n && out < end; n--)
+            *out++ = *match++;
+          match = out - distance;
+        }
+        for (; out < end; out += 8, match += 8)
+          memcpy(out, match, 8);
+        return;
+      }
+      while (out < end)
+        *out++ = *match++;
+    }
+  } // namespace
+
+  size_t lz4Compress(const byte* in, size_t size, byte* out)
+  {
+    const auto begin = out;
+    size_t anchor = 0;
+    if (size > kMatchFindLimit)
+    {
+      const auto hash_log = std::clamp(static_cast<int>(std::bit_width(size)) - 2, kMinHashLog, kMaxHashLog);
+      std::array<uint32_t, size_t{1} << kMaxHashLog> table;
+      std::fill_n(table.begin(), size_t{1} << hash_log, 0);
+
+      const auto match_limit = in + size - kLastLiterals;
+      const auto search_limit = size - kMatchFindLimit;
+      size_t pos = 1;
+      while (pos <= search_limit)
+      {
+        size_t ref = 0;
+        bool found = false;
+        for (size_t attempts = size_t{1} << kSkipShift; pos <= search_limit; pos += attempts++ >> kSkipShift)
+        {
+          const auto h = hashOf(in + pos, hash_log);
+          ref = table[h];
+          table[h] = static_cast<uint32_t>(pos);
+          if (pos - ref <= kMaxOffset && load32(in + ref) == load32(in + pos))
+          {
+            found = true;
+            break;
+          }
+        }
+        if (!found)
+          break;
+
+        while (pos > anchor && ref > 0 && in[pos - 1] == in[ref - 1])
+        {
+          --pos;
+          --ref;
+        }
+        const auto length =
+          kMinMatch + matchLength(in + pos + kMinMatch, in + ref + kMinMatch, match_limit);
+        out = writeSequence(out, in + anchor, pos - anchor, pos - ref, length);
+        pos += length;
+        anchor = pos;
+        // The bytes just before the next search are likely to recur.
+        if (pos <= search_limit)
+          table[hashOf(in + pos - 2, hash_log)] = static_cast<uint32_t>(pos - 2);
+      }
+    }
+    out = writeLiterals(out, in + anchor, size - anchor);
+    return out - begin;
+  }
+
+  bool lz4Decompress(const byte* in, size_t in_size, byte* out, size_t size)
+  {
+    const auto in_end = in + in_size;
+    const auto out_begin = out;
+    const auto out_end = out + size;
+    while (in < in_end)
+    {
+      const auto token = *in++;
+      size_t count = token >> 4;
+      // Most sequences have a short run of literals, copied as a fixed 16
+      // bytes when both buffers have room. With at least 18 bytes of input
+      // left this cannot be the last sequence, and the offset follows.
+      if (count < kLengthMask && in_end - in >= 18 && out_end - out >= 16)
+      {
+        memcpy(out, in, 16);
+        in += count;
+        out += count;
+      }
+      else
+      {
+        if (count == kLengthMask && !readExtraLength(in, in_end, count))
+          return false;
+        if (count > static_cast<size_t>(in_end - in) || count > static_cast<size_t>(out_end - out))
+          return false;
+        memcpy(out, in, count);
+        in += count;
+        out += count;
+        if (in == in_end)
+          return out == out_end;
+        if (in_end - in < 2)
+          return false;
+      }
+
+      const size_t offset = loadEndian<uint16_t, std::endian::little>(in);
+      in += 2;
+      if (offset == 0 || offset > static_cast<size_t>(out - out_begin))
+        return false;
+      size_t length = token & kLengthMask;
+      if (length == kLengthMask && !readExtraLength(in, in_end, length))
+        return false;
+      length += kMinMatch;
+      if (length > static_cast<size_t>(out_end - out))
+        return false;
+      copyMatch(out, offset, length, out_end);
+      out += length;
+    }
+    return false;
+  }
+} // namespace Boron::Detail
@@ -0,0 +1,25 @@
+#ifndef BORON_SRC_LZ4CODEC_HPP_
+#define BORON_SRC_LZ4CODEC_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // The LZ4 block format: sequences of a token, literals and a match with a
+  // 16-bit offset, the last sequence holding literals only. Blocks are
+  // independent and readable by any LZ4 block decoder.
+
+  // Largest compressed size of size input bytes.
+  constexpr size_t lz4CompressBound(size_t size) { return size + size / 255 + 16; }
+
+  // Compresses size bytes into out, which needs room for lz4CompressBound(size)
+  // bytes, and returns the compressed size. size must fit in 32 bits.
+  size_t lz4Compress(const byte* in, size_t size, byte* out);
+
+  // Decompresses a whole block into out. Fails unless the block decodes to
+  // exactly size bytes and every input byte is used; never reads or writes
+  // out of bounds, whatever the input.
+  bool lz4Decompress(const byte* in, size_t in_size, byte* out, size_t size);
+} // namespace Boron::Detail
+
+#endif
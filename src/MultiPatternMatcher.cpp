@@ -0,0 +1,165 @@
+#include "Boron/MultiPatternMatcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Boron
+{
+  size_t MultiPatternMatcher::addPattern(ByteArrayView pattern)
+  {
+    built_ = false;
+    pending_.push_back(pattern.toByteArray());
+    pattern_sizes_.push_back(pattern.size());
+    return pending_.size() - 1;
+  }
+
+  void MultiPatternMatcher::build()
+  {
+    // Byte classes: class 0 collects every byte that no pattern uses.
+    classes_.fill(0);
+    std::array<bool, 256> used{};
+    for (const auto& pattern : pending_)
+      for (auto c : pattern)
+        used[c] = true;
+    class_count_ = 1;
+    for (auto c = 0; c < 256; c++)
+      if (used[c])
+        classes_[c] = static_cast<uint16_t>(class_count_++);
+
+    // Plain trie first, with children kept sorted by class.
+    using Edges = std::vector<std::pair<uint16_t, uint32_t>>;
+    std::vector<Edges> children(1);
+    std::vector<std::vector<uint32_t>> own_outputs(1);
+    const auto child = [&children](uint32_t state, uint16_t cls) -> uint32_t
+    {
+      const auto& edges = children[state];
+      const auto it = std::lower_bound(edges.begin(), edges.end(), std::make_pair(cls, uint32_t(0)));
+      return it != edges.end() && it->first == cls ? it->second : kNoState;
+    };
+    for (uint32_t id = 0; id < pending_.size(); id++)
+    {
+      if (pending_[id].isEmpty())
+        continue;
+      uint32_t state = 0;
+      for (auto c : pending_[id])
+      {
+        const auto cls = classes_[c];
+        auto target = child(state, cls);
+        if (target == kNoState)
+        {
+          target = static_cast<uint32_t>(children.size());
+          auto& edges = children[state];
+          edges.insert(std::lower_bound(edges.begin(), edges.end(), std::make_pair(cls, uint32_t(0))),
+                       {cls, target});
+          children.emplace_back();
+          own_outputs.emplace_back();
+        }
+        state = target;
+      }
+      own_outputs[state].push_back(id);
+    }
+
+    // Renumber breadth-first, so that failure links always point to a smaller
+    // state and the dense states form a prefix of the numbering.
+    const auto state_count = children.size();
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> renamed(state_count);
+    order.reserve(state_count);
+    order.push_back(0);
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      renamed[order[i]] = static_cast<uint32_t>(i);
+      for (const auto& edge : children[order[i]])
+        order.push_back(edge.second);
+    }
+
+    fail_.assign(state_count, 0);
+    edge_start_.assign(state_count + 1, 0);
+    edge_classes_.clear();
+    edge_targets_.clear();
+    has_output_.assign(state_count, 0);
+    dict_link_.assign(state_count, kNoState);
+    output_start_.assign(state_count + 1, 0);
+    outputs_.clear();
+    for (uint32_t s = 0; s < state_count; s++)
+    {
+      const auto old = order[s];
+      edge_start_[s] = static_cast<uint32_t>(edge_classes_.size());
+      for (const auto& [cls, target] : children[old])
+      {
+        edge_classes_.push_back(cls);
+        edge_targets_.push_back(renamed[target]);
+      }
+      output_start_[s] = static_cast<uint32_t>(outputs_.size());
+      outputs_.insert(outputs_.end(), own_outputs[old].begin(), own_outputs[old].end());
+      has_output_[s] = !own_outputs[old].empty();
+    }
+    edge_start_[state_count] = static_cast<uint32_t>(edge_classes_.size());
+    output_start_[state_count] = static_cast<uint32_t>(outputs_.size());
+
+    const auto sparse_child = [this](uint32_t state, uint16_t cls) -> uint32_t
+    {
+      const auto begin = edge_classes_.begin() + edge_start_[state];
+      const auto end = edge_classes_.begin() + edge_start_[state + 1];
+      const auto it = std::lower_bound(begin, end, cls);
+      return it != end && *it == cls ? edge_targets_[it - edge_classes_.begin()] : kNoState;
+    };
+
+    // Failure and dictionary links, in breadth-first order.
+    for (uint32_t s = 0; s < state_count; s++)
+    {
+      for (auto e = edge_start_[s]; e < edge_start_[s + 1]; e++)
+      {
+        const auto target = edge_targets_[e];
+        uint32_t fallback = 0;
+        if (s != 0)
+        {
+          auto f = fail_[s];
+          while (f != 0 && sparse_child(f, edge_classes_[e]) == kNoState)
+            f = fail_[f];
+          const auto next = sparse_child(f, edge_classes_[e]);
+          fallback = next == kNoState ? 0 : next;
+        }
+        fail_[target] = fallback;
+        dict_link_[target] = has_output_[fallback] ? fallback : dict_link_[fallback];
+      }
+    }
+
+    // Complete rows for the shallowest states. A failure link of a dense state
+    // is itself dense, so each row only copies from rows already built.
+    dense_states_ = static_cast<uint32_t>(std::clamp<size_t>(kDenseCells / class_count_, 1, state_count));
+    dense_.assign(dense_states_ * class_count_, 0);
+    for (uint32_t s = 0; s < dense_states_; s++)
+    {
+      auto row = dense_.begin() + s * class_count_;
+      if (s != 0)
+        std::copy_n(dense_.begin() + fail_[s] * class_count_, class_count_, row);
+      for (auto e = edge_start_[s]; e < edge_start_[s + 1]; e++)
+        row[edge_classes_[e]] = edge_targets_[e];
+    }
+    built_ = true;
+  }
+
+  std::vector<MultiPatternMatcher::Match> MultiPatternMatcher::findAll(ByteArrayView haystack) const
+  {
+    std::vector<Match> matches;
+    forEachMatch(haystack, [&matches](const Match& match) { matches.push_back(match); });
+    return matches;
+  }
+
+  bool MultiPatternMatcher::containsAny(ByteArrayView haystack) const
+  {
+    assert(built_);
+    uint32_t state = 0;
+    for (auto c : haystack)
+    {
+      state = next(state, classes_[c]);
+      if (has_output_[state] || dict_link_[state] != kNoState)
+        return true;
+    }
+    return false;
+  }
+} // namespace Boron
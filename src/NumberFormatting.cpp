@@ -0,0 +1,157 @@
+#include "NumberFormatting.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    // "00" to "99", so that every division by 100 yields two digits.
+    constexpr auto kDigitPairs = [] {
+      std::array<char, 200> pairs{};
+      for (int i = 0; i < 100; i++)
+      {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+      }
+      return pairs;
+    }();
+
+    constexpr auto kPowersOf10 = [] {
+      std::array<uint64_t, 20> powers{};
+      powers[0] = 1;
+      for (size_t i = 1; i < powers.size(); i++)
+        powers[i] = powers[i - 1] * 10;
+      return powers;
+    }();
+
+    size_t decimalDigits(uint64_t value)
+    {
+      // 1233 / 4096 approximates log10(2).
+      const auto guess = static_cast<size_t>(std::bit_width(value | 1) * 1233 >> 12);
+      return guess + ((value | 1) >= kPowersOf10[guess]);
+    }
+
+    size_t formatDecimal(uint64_t value, char* out)
+    {
+      const auto size = decimalDigits(value);
+      auto p = out + size;
+      while (value >= 100)
+      {
+        const auto pair = value % 100;
+        value /= 100;
+        p -= 2;
+        std::memcpy(p, &kDigitPairs[2 * pair], 2);
+      }
+      if (value >= 10)
+        std::memcpy(p - 2, &kDigitPairs[2 * value], 2);
+      else
+        p[-1] = static_cast<char>('0' + value);
+      return size;
+    }
+
+    size_t formatInBase(uint64_t value, unsigned base, char* out)
+    {
+      char buffer[64];
+      auto p = std::end(buffer);
+      if (std::has_single_bit(base))
+      {
+        const auto shift = std::countr_zero(base);
+        do
+        {
+          *--p = kDigits[value & (base - 1)];
+          value >>= shift;
+        } while (value);
+      }
+      else
+      {
+        do
+        {
+          *--p = kDigits[value % base];
+          value /= base;
+        } while (value);
+      }
+      const auto size = static_cast<size_t>(std::end(buffer) - p);
+      std::memcpy(out, p, size);
+      return size;
+    }
+
+    std::chars_format charsFormat(char format)
+    {
+      switch (format)
+      {
+      case 'e':
+      case 'E':
+        return std::chars_format::scientific;
+      case 'f':
+        return std::chars_format::fixed;
+      default:
+        return std::chars_format::general;
+      }
+    }
+
+    template <typename T>
+    size_t formatFloatingPointImpl(T value, char format, int precision, char* out)
+    {
+      const auto last = out + floatingPointBound(format, precision);
+      const auto fmt = charsFormat(format);
+      // The sign bit of a NaN means nothing, so it is not printed.
+      if (std::isnan(value))
+        value = std::copysign(value, T(1));
+      const auto [end, ec] =
+        precision < 0 ? std::to_chars(out, last, value, fmt) : std::to_chars(out, last, value, fmt, precision);
+      assert(ec == std::errc());
+      if (format == 'E' || format == 'G')
+      {
+        for (auto p = out; p != end; ++p)
+        {
+          if (*p >= 'a' && *p <= 'z')
+            *p = static_cast<char>(*p - 'a' + 'A');
+        }
+      }
+      return end - out;
+    }
+  } // namespace
+
+  size_t formatInteger(uint64_t magnitude, bool negative, int base, char* out)
+  {
+    assert(base >= 2 && base <= 36);
+    size_t size = 0;
+    if (negative)
+      out[size++] = '-';
+    if (base == 10)
+      return size + formatDecimal(magnitude, out + size);
+    return size + formatInBase(magnitude, static_cast<unsigned>(base), out + size);
+  }
+
+  size_t floatingPointBound(char format, int precision)
+  {
+    // The longest shortest forms: 17 significant digits with a sign, a point
+    // and an exponent, or up to 309 integer digits in fixed notation, and
+    // 324 fraction digits for the smallest subnormal.
+    if (precision < 0)
+      return charsFormat(format) == std::chars_format::fixed ? 350 : 32;
+    const auto digits = static_cast<size_t>(precision);
+    return charsFormat(format) == std::chars_format::fixed ? 350 + digits : 16 + digits;
+  }
+
+  size_t formatFloatingPoint(double value, char format, int precision, char* out)
+  {
+    return formatFloatingPointImpl(value, format, precision, out);
+  }
+
+  size_t formatFloatingPoint(float value, char format, int precision, char* out)
+  {
+    return formatFloatingPointImpl(value, format, precision, out);
+  }
+} // namespace Boron::Detail
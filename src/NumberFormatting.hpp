@@ -0,0 +1,24 @@
+#ifndef BORON_SRC_NUMBERFORMATTING_HPP_
+#define BORON_SRC_NUMBERFORMATTING_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // Room for 64 binary digits and a sign.
+  constexpr size_t kMaxIntegerChars = 65;
+
+  // Writes magnitude in base 2 to 36 with lower case digits, after a minus
+  // sign if negative, and returns the number of characters.
+  size_t formatInteger(uint64_t magnitude, bool negative, int base, char* out);
+
+  // Upper bound of the characters formatFloatingPoint() writes.
+  size_t floatingPointBound(char format, int precision);
+  // Formats like printf() with %e, %f or %g, upper case for 'E' and 'G'. A
+  // negative precision gives the shortest text that parses back to value.
+  // Infinities keep their sign, NaN is "nan" or "NAN" whatever its sign bit.
+  size_t formatFloatingPoint(double value, char format, int precision, char* out);
+  size_t formatFloatingPoint(float value, char format, int precision, char* out);
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,159 @@
+#include "NumberParsing.hpp"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr byte kInvalidDigit = 0xFF;
+
+    constexpr auto kDigitValues = [] {
+      std::array<byte, 256> table{};
+      table.fill(kInvalidDigit);
+      for (int c = '0'; c <= '9'; c++)
+        table[c] = static_cast<byte>(c - '0');
+      for (int c = 'a'; c <= 'z'; c++)
+      {
+        table[c] = static_cast<byte>(c - 'a' + 10);
+        table[c - 'a' + 'A'] = static_cast<byte>(c - 'a' + 10);
+      }
+      return table;
+    }();
+
+    constexpr bool isAsciiSpace(byte c)
+    {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    ByteArrayView trimmedView(ByteArrayView text)
+    {
+      auto l = text.begin(), r = text.end();
+      while (l < r && isAsciiSpace(*l))
+        ++l;
+      while (l < r && isAsciiSpace(*(r - 1)))
+        --r;
+      return {l, r};
+    }
+
+    // Eight decimal digits at once, as in Lemire's fast_float: the digit test
+    // flags every byte outside '0'..'9', the three multiplies fold adjacent
+    // digits into pairs, quads and finally the full value.
+    bool isEightDigits(uint64_t chunk)
+    {
+      return !(((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) & 0x8080808080808080);
+    }
+
+    uint32_t parseEightDigits(uint64_t chunk)
+    {
+      constexpr uint64_t mask = 0x000000FF000000FF;
+      constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+      constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+      chunk -= 0x3030303030303030;
+      chunk = chunk * 10 + (chunk >> 8);
+      return static_cast<uint32_t>(((chunk & mask) * mul1 + ((chunk >> 16) & mask) * mul2) >> 32);
+    }
+
+    bool parseDigits(const byte* p, const byte* end, unsigned base, uint64_t& value)
+    {
+      constexpr auto kMax = std::numeric_limits<uint64_t>::max();
+      if (p == end)
+        return false;
+      uint64_t result = 0;
+      if constexpr (std::endian::native == std::endian::little)
+      {
+        if (base == 10)
+        {
+          for (; end - p >= 8; p += 8)
+          {
+            uint64_t chunk;
+            std::memcpy(&chunk, p, 8);
+            if (!isEightDigits(chunk))
+              break;
+            const auto digits = parseEightDigits(chunk);
+            if (result > (kMax - digits) / 100000000)
+              return false;
+            result = result * 100000000 + digits;
+          }
+        }
+      }
+      const auto limit = kMax / base;
+      const auto last_digit = kMax % base;
+      for (; p < end; ++p)
+      {
+        const auto digit = kDigitValues[*p];
+        if (digit >= base)
+          return false;
+        if (result > limit || (result == limit && digit > last_digit))
+          return false;
+        result = result * base + digit;
+      }
+      value = result;
+      return true;
+    }
+
+    bool hasPrefix(const byte* p, const byte* end, char letter)
+    {
+      return end - p >= 2 && p[0] == '0' && (p[1] | 0x20) == letter;
+    }
+
+    template <typename T>
+    bool parseFloatingPointImpl(ByteArrayView text, T& value)
+    {
+      text = trimmedView(text);
+      auto first = reinterpret_cast<const char*>(text.data());
+      const auto last = first + text.size();
+      // from_chars takes no plus sign.
+      if (first != last && *first == '+' && last - first > 1 && first[1] != '-' && first[1] != '+')
+        ++first;
+      T result;
+      const auto [ptr, ec] = std::from_chars(first, last, result);
+      if (ec != std::errc() || ptr != last)
+        return false;
+      value = result;
+      return true;
+    }
+  } // namespace
+
+  bool parseInteger(ByteArrayView text, int base, uint64_t& magnitude, bool& negative)
+  {
+    if (base != 0 && (base < 2 || base > 36))
+      return false;
+    text = trimmedView(text);
+    auto p = text.begin();
+    const auto end = text.end();
+    negative = false;
+    if (p != end && (*p == '+' || *p == '-'))
+      negative = *p++ == '-';
+    if (base == 0)
+    {
+      if (hasPrefix(p, end, 'x'))
+        base = 16;
+      else if (hasPrefix(p, end, 'b'))
+        base = 2;
+      else if (end - p >= 2 && *p == '0')
+        base = 8;
+      else
+        base = 10;
+    }
+    if ((base == 16 && hasPrefix(p, end, 'x')) || (base == 2 && hasPrefix(p, end, 'b')))
+      p += 2;
+    return parseDigits(p, end, static_cast<unsigned>(base), magnitude);
+  }
+
+  bool parseFloatingPoint(ByteArrayView text, double& value)
+  {
+    return parseFloatingPointImpl(text, value);
+  }
+
+  bool parseFloatingPoint(ByteArrayView text, float& value)
+  {
+    return parseFloatingPointImpl(text, value);
+  }
+} // namespace Boron::Detail
@@ -0,0 +1,21 @@
+#ifndef BORON_SRC_NUMBERPARSING_HPP_
+#define BORON_SRC_NUMBERPARSING_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // Locale-free parsers for the whole of text, apart from surrounding ASCII
+  // whitespace. They return false on malformed input and on overflow; value
+  // is only written on success.
+
+  // An optional sign, then digits in base 2 to 36, or in the base given by a
+  // 0x, 0b or 0 prefix when base is 0. Bases 16 and 2 accept their prefix too.
+  bool parseInteger(ByteArrayView text, int base, uint64_t& magnitude, bool& negative);
+
+  // Decimal or exponent notation with an optional sign, inf or nan.
+  bool parseFloatingPoint(ByteArrayView text, double& value);
+  bool parseFloatingPoint(ByteArrayView text, float& value);
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,208 @@
+#include "PercentCodec.hpp"
+#include "ByteArrayAlgorithms.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    using FindFn = size_t (*)(const byte* data, size_t size, const byte* rows);
+    using CountFn = size_t (*)(const byte* data, size_t size, const byte* rows);
+
+    bool escaped(const byte* rows, byte c)
+    {
+      return rows[(c >> 7) * 16 + (c & 0x0F)] >> (c >> 4 & 7) & 1;
+    }
+
+    size_t findPercentEscapeScalar(const byte* data, size_t size, const byte* rows)
+    {
+      size_t i = 0;
+      while (i < size && !escaped(rows, data[i]))
+        i++;
+      return i;
+    }
+
+    size_t countPercentEscapesScalar(const byte* data, size_t size, const byte* rows)
+    {
+      size_t count = 0;
+      for (size_t i = 0; i < size; i++)
+        count += escaped(rows, data[i]);
+      return count;
+    }
+
+#if BORON_ARCH_X86
+    // Set membership for arbitrary bytes with two pshufb lookups: the low
+    // nibble, together with the top bit to pick one of the two row tables,
+    // selects a row whose bits stand for high nibbles 0-7 or 8-15, and a third
+    // lookup turns the high nibble into the bit to test.
+    BORON_TARGET("ssse3")
+    int escapeMaskSsse3(__m128i block, __m128i rows_low, __m128i rows_high)
+    {
+      const auto bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      const auto index = _mm_and_si128(block, _mm_set1_epi8(static_cast<char>(0x8F)));
+      // pshufb yields zero for indexes with the top bit set.
+      const auto row = _mm_or_si128(_mm_shuffle_epi8(rows_low, index),
+                                    _mm_shuffle_epi8(rows_high, _mm_xor_si128(index, _mm_set1_epi8(-128))));
+      const auto bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0F)));
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit));
+    }
+
+    BORON_TARGET("ssse3")
+    size_t findPercentEscapeSsse3(const byte* data, size_t size, const byte* rows)
+    {
+      const auto rows_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows));
+      const auto rows_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16));
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto mask =
+          escapeMaskSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), rows_low, rows_high);
+        if (mask)
+          return i + std::countr_zero(static_cast<uint32_t>(mask));
+      }
+      return i + findPercentEscapeScalar(data + i, size - i, rows);
+    }
+
+    BORON_TARGET("ssse3")
+    size_t countPercentEscapesSsse3(const byte* data, size_t size, const byte* rows)
+    {
+      const auto rows_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows));
+      const auto rows_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16));
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto mask =
+          escapeMaskSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), rows_low, rows_high);
+        count += std::popcount(static_cast<uint32_t>(mask));
+      }
+      return count + countPercentEscapesScalar(data + i, size - i, rows);
+    }
+
+    BORON_TARGET("avx2")
+    uint32_t escapeMaskAvx2(__m256i block, __m256i rows_low, __m256i rows_high)
+    {
+      const auto bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, //
+                                         1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      const auto index = _mm256_and_si256(block, _mm256_set1_epi8(static_cast<char>(0x8F)));
+      const auto row = _mm256_or_si256(_mm256_shuffle_epi8(rows_low, index),
+                                       _mm256_shuffle_epi8(rows_high, _mm256_xor_si256(index, _mm256_set1_epi8(-128))));
+      const auto bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F)));
+      return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+    }
+
+    BORON_TARGET("avx2")
+    size_t findPercentEscapeAvx2(const byte* data, size_t size, const byte* rows)
+    {
+      const auto rows_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows)));
+      const auto rows_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16)));
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto mask =
+          escapeMaskAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), rows_low, rows_high);
+        if (mask)
+        {
+          _mm256_zeroupper();
+          return i + std::countr_zero(mask);
+        }
+      }
+      _mm256_zeroupper();
+      return i + findPercentEscapeSsse3(data + i, size - i, rows);
+    }
+
+    BORON_TARGET("avx2")
+    size_t countPercentEscapesAvx2(const byte* data, size_t size, const byte* rows)
+    {
+      const auto rows_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows)));
+      const auto rows_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + 16)));
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 32 <= size; i += 32)
+      {
+        const auto mask =
+          escapeMaskAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), rows_low, rows_high);
+        count += std::popcount(mask);
+      }
+      _mm256_zeroupper();
+      return count + countPercentEscapesSsse3(data + i, size - i, rows);
+    }
+#endif
+
+    struct PercentKernels
+    {
+      FindFn find;
+      CountFn count;
+    };
+
+    PercentKernels selectPercentKernels()
+    {
+#if BORON_ARCH_X86
+      const auto& features = cpuFeatures();
+      if (features.avx2)
+        return {findPercentEscapeAvx2, countPercentEscapesAvx2};
+      if (features.ssse3)
+        return {findPercentEscapeSsse3, countPercentEscapesSsse3};
+#endif
+      return {findPercentEscapeScalar, countPercentEscapesScalar};
+    }
+
+    int hexValue(byte c)
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      c |= 0x20;
+      if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      return -1;
+    }
+  } // namespace
+
+  size_t findPercentEscape(const byte* data, size_t size, const byte* rows)
+  {
+    return dispatched<selectPercentKernels>().find(data, size, rows);
+  }
+
+  size_t countPercentEscapes(const byte* data, size_t size, const byte* rows)
+  {
+    return dispatched<selectPercentKernels>().count(data, size, rows);
+  }
+
+  size_t decodePercent(const byte* in, size_t size, byte* out, byte percent)
+  {
+    const ByteArrayView input(in, size);
+    const auto begin = out;
+    size_t i = 0;
+    while (i < size)
+    {
+      auto pos = findByte(input, i, percent);
+      if (pos == kNotFound)
+        pos = size;
+      std::memcpy(out, in + i, pos - i);
+      out += pos - i;
+      if (pos == size)
+        break;
+      const auto hi = pos + 2 < size ? hexValue(in[pos + 1]) : -1;
+      const auto lo = hi < 0 ? -1 : hexValue(in[pos + 2]);
+      if (lo < 0)
+      {
+        // Not an escape, the percent stays.
+        *out++ = percent;
+        i = pos + 1;
+        continue;
+      }
+      *out++ = static_cast<byte>(hi << 4 | lo);
+      i = pos + 3;
+    }
+    return out - begin;
+  }
+} // namespace Boron::Detail
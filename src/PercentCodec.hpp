@@ -0,0 +1,18 @@
+#ifndef BORON_SRC_PERCENTCODEC_HPP_
+#define BORON_SRC_PERCENTCODEC_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // rows is the 32-byte escape set of PercentEncoder.
+  // Offset of the first byte of data to escape, size if there is none.
+  size_t findPercentEscape(const byte* data, size_t size, const byte* rows);
+  size_t countPercentEscapes(const byte* data, size_t size, const byte* rows);
+
+  // Decodes every percent followed by two hex digits of either case and keeps
+  // anything else as is. Returns the number of bytes written.
+  size_t decodePercent(const byte* in, size_t size, byte* out, byte percent);
+} // namespace Boron::Detail
+
+#endif
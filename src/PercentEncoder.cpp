@@ -0,0 +1,70 @@
+#include "Boron/PercentEncoder.hpp"
+
+#include <cstring>
+#include "PercentCodec.hpp"
+
+namespace Boron
+{
+  namespace
+  {
+    constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+    constexpr bool isUnreserved(uint8_t c)
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.' ||
+        c == '_' || c == '~';
+    }
+  } // namespace
+
+  PercentEncoder::PercentEncoder(ByteArrayView exclude, ByteArrayView include, uint8_t percent) : percent_(percent)
+  {
+    for (int c = 0; c < 256; c++)
+      setEscaped(static_cast<uint8_t>(c), !isUnreserved(static_cast<uint8_t>(c)));
+    for (const auto c : exclude)
+      setEscaped(c, false);
+    for (const auto c : include)
+      setEscaped(c, true);
+    setEscaped(percent, true);
+  }
+
+  std::string PercentEncoder::encode(ByteArrayView input) const
+  {
+    std::string result(encodedSize(input), '\0');
+    encodeTo(input, result.data());
+    return result;
+  }
+
+  size_t PercentEncoder::encodedSize(ByteArrayView input) const
+  {
+    return input.size() + 2 * Detail::countPercentEscapes(input.data(), input.size(), rows_.data());
+  }
+
+  size_t PercentEncoder::encodeTo(ByteArrayView input, char* out) const
+  {
+    const auto begin = out;
+    const auto data = input.data();
+    const auto size = input.size();
+    size_t i = 0;
+    while (i < size)
+    {
+      const auto run = Detail::findPercentEscape(data + i, size - i, rows_.data());
+      std::memcpy(out, data + i, run);
+      out += run;
+      i += run;
+      if (i == size)
+        break;
+      *out++ = static_cast<char>(percent_);
+      *out++ = kHexDigits[data[i] >> 4];
+      *out++ = kHexDigits[data[i] & 0x0F];
+      i++;
+    }
+    return out - begin;
+  }
+
+  void PercentEncoder::setEscaped(uint8_t c, bool escaped)
+  {
+    const auto bit = static_cast<byte>(1 << (c >> 4 & 7));
+    auto& row = rows_[(c >> 7) * 16 + (c & 0x0F)];
+    row = escaped ? row | bit : row & ~bit;
+  }
+} // namespace Boron
@@ -0,0 +1,303 @@
+#include "Boron/String.hpp"
+#include "Boron/Endian.hpp"
+#include "Boron/Unicode.hpp"
+#include "UnicodeCodec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Boron
+{
+  namespace Detail
+  {
+    struct Utf8Index
+    {
+      mutable std::atomic<size_t> refs{1};
+      // Code points.
+      size_t length = 0;
+      // Byte offset of every String::kIndexStride-th code point, starting
+      // with the first; empty when every code point is a byte.
+      std::vector<size_t> offsets;
+    };
+  } // namespace Detail
+
+  namespace
+  {
+    using Detail::Utf8Index;
+
+    constexpr uint64_t kHighBits = 0x8080808080808080;
+
+    // The high bit of every byte of word that starts a code point, which is
+    // every byte but a continuation.
+    uint64_t startBits(uint64_t word)
+    {
+      return ~(word & ~(word << 1)) & kHighBits;
+    }
+
+    uint64_t load64(const byte* p)
+    {
+      return loadEndian<uint64_t, std::endian::little>(p);
+    }
+
+    // Byte offset of the n-th start in bits, one of whose high bits is set
+    // for every byte of a word.
+    size_t selectStart(uint64_t bits, size_t n)
+    {
+      for (; n; n--)
+        bits &= bits - 1;
+      return static_cast<size_t>(std::countr_zero(bits)) / 8;
+    }
+
+    const Utf8Index* buildIndex(ByteArrayView utf8)
+    {
+      auto index = new Utf8Index;
+      index->length = utf32LengthOfUtf8(utf8);
+      if (index->length == utf8.size())
+        return index;
+
+      const auto data = utf8.data();
+      const auto size = utf8.size();
+      index->offsets.reserve(index->length / String::kIndexStride + 1);
+      // Code points before i, and the number of the next one to record.
+      size_t count = 0;
+      size_t next = 0;
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8)
+      {
+        const auto starts = startBits(load64(data + i));
+        const auto n = static_cast<size_t>(std::popcount(starts));
+        // Code points are at least a byte, so a word holds at most one entry.
+        if (count + n > next)
+        {
+          index->offsets.push_back(i + selectStart(starts, next - count));
+          next += String::kIndexStride;
+        }
+        count += n;
+      }
+      for (; i < size; i++)
+      {
+        if (Detail::isUtf8Continuation(data[i]))
+          continue;
+        if (count == next)
+        {
+          index->offsets.push_back(i);
+          next += String::kIndexStride;
+        }
+        ++count;
+      }
+      return index;
+    }
+
+    void retain(const Utf8Index* index) noexcept
+    {
+      if (index)
+        index->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release(const Utf8Index* index) noexcept
+    {
+      if (index && index->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete index;
+    }
+
+    // Offset of the code point n after the one at pos.
+    size_t skipCodePoints(const byte* data, size_t size, size_t pos, size_t n)
+    {
+      auto i = pos + 1;
+      while (n)
+      {
+        if (i + 8 <= size)
+        {
+          const auto starts = startBits(load64(data + i));
+          const auto count = static_cast<size_t>(std::popcount(starts));
+          if (count < n)
+          {
+            n -= count;
+            i += 8;
+            continue;
+          }
+          return i + selectStart(starts, n - 1);
+        }
+        if (!Detail::isUtf8Continuation(data[i]) && --n == 0)
+          return i;
+        ++i;
+      }
+      return pos;
+    }
+
+    size_t offsetOf(const Utf8Index& index, ByteArrayView utf8, size_t i)
+    {
+      if (index.offsets.empty())
+        return i;
+      if (i == index.length)
+        return utf8.size();
+      const auto entry = index.offsets[i / String::kIndexStride];
+      return skipCodePoints(utf8.data(), utf8.size(), entry, i % String::kIndexStride);
+    }
+
+    // Copies utf8 with U+FFFD for every maximal malformed subpart.
+    ByteArray replaceMalformed(ByteArrayView utf8)
+    {
+      ByteArray result;
+      // A replacement takes three bytes for at least one.
+      result.resize_and_overwrite(utf8.size() * 3, [&](uint8_t* out, size_t) {
+        const auto data = utf8.data();
+        const auto size = utf8.size();
+        size_t written = 0;
+        size_t i = 0;
+        while (i < size)
+        {
+          char32_t cp;
+          if (const auto n = Detail::decodeUtf8(data + i, size - i, cp))
+          {
+            memcpy(out + written, data + i, n);
+            written += n;
+            i += n;
+            continue;
+          }
+          written += Detail::encodeUtf8(Detail::kReplacementCharacter, out + written);
+          i += Detail::malformedUtf8Length(data + i, size - i);
+        }
+        return written;
+      });
+      return result;
+    }
+  } // namespace
+
+  String::String(ByteArray utf8) : utf8_(utf8.isValidUtf8() ? std::move(utf8) : replaceMalformed(utf8)) {}
+
+  String::String(ByteArray utf8, const Detail::Utf8Index* index) noexcept : utf8_(std::move(utf8)), index_(index) {}
+
+  String::String(const String& other) noexcept : utf8_(other.utf8_)
+  {
+    const auto index = other.index_.load(std::memory_order_acquire);
+    retain(index);
+    index_.store(index, std::memory_order_relaxed);
+  }
+
+  String::String(String&& other) noexcept :
+      utf8_(std::move(other.utf8_)), index_(other.index_.exchange(nullptr, std::memory_order_relaxed))
+  {
+  }
+
+  String& String::operator=(const String& other) noexcept
+  {
+    if (this != &other)
+    {
+      String copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  String& String::operator=(String&& other) noexcept
+  {
+    if (this != &other)
+    {
+      utf8_ = std::move(other.utf8_);
+      release(index_.exchange(other.index_.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed));
+    }
+    return *this;
+  }
+
+  String::~String()
+  {
+    release(index_.load(std::memory_order_relaxed));
+  }
+
+  String String::fromStdString(const std::string& s)
+  {
+    return String(ByteArray::fromStdString(s));
+  }
+
+  String String::fromUtf16(std::u16string_view s)
+  {
+    return String(ByteArray::fromUtf16(s), nullptr);
+  }
+
+  ByteArray String::utf8() &&
+  {
+    dropIndex();
+    return std::move(utf8_);
+  }
+
+  const Detail::Utf8Index& String::index() const
+  {
+    if (const auto index = index_.load(std::memory_order_acquire))
+      return *index;
+    // Concurrent callers may each build one; all but the first to publish
+    // throw theirs away.
+    const Utf8Index* expected = nullptr;
+    const auto index = buildIndex(utf8_);
+    if (index_.compare_exchange_strong(expected, index, std::memory_order_acq_rel, std::memory_order_acquire))
+      return *index;
+    delete index;
+    return *expected;
+  }
+
+  void String::dropIndex() noexcept
+  {
+    release(index_.exchange(nullptr, std::memory_order_relaxed));
+  }
+
+  size_t String::length() const
+  {
+    return index().length;
+  }
+
+  char32_t String::at(size_t i) const
+  {
+    const auto& index = this->index();
+    assert(i < index.length);
+    if (index.offsets.empty())
+      return utf8_[i];
+    const auto pos = offsetOf(index, utf8_, i);
+    char32_t cp = 0;
+    Detail::decodeUtf8(utf8_.data() + pos, utf8_.size() - pos, cp);
+    return cp;
+  }
+
+  size_t String::utf8Offset(size_t i) const
+  {
+    const auto& index = this->index();
+    assert(i <= index.length);
+    return offsetOf(index, utf8_, i);
+  }
+
+  String String::mid(size_t index, size_t len) const &
+  {
+    const auto& code_points = this->index();
+    if (index >= code_points.length)
+      return {};
+    len = std::min(len, code_points.length - index);
+    const auto begin = offsetOf(code_points, utf8_, index);
+    const auto end = offsetOf(code_points, utf8_, index + len);
+    return String(utf8_.sliced(begin, end - begin), nullptr);
+  }
+
+  String String::mid(size_t index, size_t len) &&
+  {
+    const auto& code_points = this->index();
+    if (index >= code_points.length)
+      return {};
+    len = std::min(len, code_points.length - index);
+    const auto begin = offsetOf(code_points, utf8_, index);
+    const auto end = offsetOf(code_points, utf8_, index + len);
+    dropIndex();
+    return String(std::move(utf8_).sliced(begin, end - begin), nullptr);
+  }
+
+  String& String::append(const String& s)
+  {
+    // Well-formed text stays well-formed when concatenated.
+    utf8_.append(s.utf8_);
+    dropIndex();
+    return *this;
+  }
+} // namespace Boron
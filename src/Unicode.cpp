@@ -0,0 +1,954 @@
+#include "Boron/Unicode.hpp"
+#include "Boron/Endian.hpp"
+#include "CpuFeatures.hpp"
+#include "UnicodeCodec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron
+{
+  namespace
+  {
+    using Detail::decodeUtf8;
+    using Detail::encodeUtf8;
+
+    using ValidateFn = bool (*)(const byte* data, size_t size);
+
+    constexpr uint64_t kHighBits = 0x8080808080808080;
+    // ASCII runs are converted this many characters at a time, in loops of a
+    // fixed length that the compiler vectorizes.
+    constexpr size_t kAsciiBlock = 16;
+
+    uint64_t load64(const byte* p)
+    {
+      return loadEndian<uint64_t, std::endian::native>(p);
+    }
+
+    bool isAsciiBlock(const byte* p)
+    {
+      return ((load64(p) | load64(p + 8)) & kHighBits) == 0;
+    }
+
+    bool validateUtf8Scalar(const byte* data, size_t size)
+    {
+      size_t i = 0;
+      while (i < size)
+      {
+        if (size - i >= 8 && (load64(data + i) & kHighBits) == 0)
+        {
+          i += 8;
+          continue;
+        }
+        char32_t cp;
+        const auto n = decodeUtf8(data + i, size - i, cp);
+        if (n == 0)
+          return false;
+        i += n;
+      }
+      return true;
+    }
+
+#if BORON_ARCH_X86
+    // Keiser and Lemire's lookup algorithm. Every byte is classified by its
+    // own high nibble and by the high and low nibbles of the byte before it;
+    // each table yields a set of error kinds the pair may belong to, and the
+    // pair is invalid when all three agree on one. What the pairs cannot see,
+    // a continuation that is the third or fourth byte of a sequence, is
+    // checked against the bytes two and three back.
+    namespace Utf8Error
+    {
+      constexpr uint8_t kTooShort = 1 << 0;
+      constexpr uint8_t kTooLong = 1 << 1;
+      constexpr uint8_t kOverlong3 = 1 << 2;
+      constexpr uint8_t kTooLarge = 1 << 3;
+      constexpr uint8_t kSurrogate = 1 << 4;
+      constexpr uint8_t kOverlong2 = 1 << 5;
+      constexpr uint8_t kTooLarge1000 = 1 << 6;
+      constexpr uint8_t kOverlong4 = 1 << 6;
+      constexpr uint8_t kTwoContinuations = 1 << 7;
+      constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoContinuations;
+    } // namespace Utf8Error
+
+    BORON_TARGET("avx2")
+    __m256i lookup16(__m256i nibbles, const uint8_t (&table)[16])
+    {
+      const auto lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+      return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(lane), nibbles);
+    }
+
+    // input shifted by n bytes, with the last n bytes of previous in front.
+    template <int N>
+    BORON_TARGET("avx2")
+    __m256i previous(__m256i input, __m256i previous_input)
+    {
+      return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous_input, input, 0x21), 16 - N);
+    }
+
+    BORON_TARGET("avx2")
+    __m256i utf8Errors(__m256i input, __m256i previous_input)
+    {
+      using namespace Utf8Error;
+      static constexpr uint8_t kByte1High[16] = {
+        // 0xxx: ASCII followed by anything but ASCII or a lead.
+        kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+        // 10xx: a continuation.
+        kTwoContinuations, kTwoContinuations, kTwoContinuations, kTwoContinuations,
+        // 1100, 1101: two-byte leads.
+        kTooShort | kOverlong2, kTooShort,
+        // 1110: three-byte leads.
+        kTooShort | kOverlong3 | kSurrogate,
+        // 1111: four-byte leads.
+        kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+      static constexpr uint8_t kByte1Low[16] = {
+        kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+        kCarry | kOverlong2,
+        kCarry,
+        kCarry,
+        kCarry | kTooLarge,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000};
+      static constexpr uint8_t kByte2High[16] = {
+        // 0xxx: ASCII after a lead.
+        kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+        // 1000, 1001, 101x: continuations, which rule out different errors.
+        kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge1000 | kOverlong4,
+        kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge,
+        kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+        kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+        // 11xx: a lead after a lead.
+        kTooShort, kTooShort, kTooShort, kTooShort};
+
+      const auto low_nibbles = _mm256_set1_epi8(0x0F);
+      const auto prev1 = previous<1>(input, previous_input);
+      const auto byte1_high = lookup16(_mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibbles), kByte1High);
+      const auto byte1_low = lookup16(_mm256_and_si256(prev1, low_nibbles), kByte1Low);
+      const auto byte2_high = lookup16(_mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibbles), kByte2High);
+      const auto special = _mm256_and_si256(_mm256_and_si256(byte1_high, byte1_low), byte2_high);
+
+      // Continuations two after a three or four-byte lead, or three after a
+      // four-byte lead, are where kTwoContinuations is expected.
+      const auto third = _mm256_subs_epu8(previous<2>(input, previous_input), _mm256_set1_epi8(0xE0 - 0x80));
+      const auto fourth = _mm256_subs_epu8(previous<3>(input, previous_input), _mm256_set1_epi8(0xF0 - 0x80));
+      const auto expected = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+      return _mm256_xor_si256(expected, special);
+    }
+
+    // Nonzero where the last three bytes start a sequence they cannot hold.
+    BORON_TARGET("avx2")
+    __m256i incompleteTail(__m256i input)
+    {
+      const auto max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, //
+                                        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1),
+                                        char(0xE0 - 1), char(0xC0 - 1));
+      return _mm256_subs_epu8(input, max);
+    }
+
+    struct Utf8CheckerAvx2
+    {
+      __m256i error;
+      __m256i previous_input;
+      __m256i previous_incomplete;
+
+      BORON_TARGET("avx2")
+      void check(__m256i input)
+      {
+        error = _mm256_or_si256(error, utf8Errors(input, previous_input));
+        previous_incomplete = incompleteTail(input);
+        previous_input = input;
+      }
+
+      // ASCII is only wrong after an unfinished sequence.
+      BORON_TARGET("avx2")
+      void checkAscii(__m256i input)
+      {
+        error = _mm256_or_si256(error, previous_incomplete);
+        previous_incomplete = _mm256_setzero_si256();
+        previous_input = input;
+      }
+
+      BORON_NODISCARD BORON_TARGET("avx2")
+      bool failed() const { return !_mm256_testz_si256(error, error); }
+    };
+
+    BORON_TARGET("avx2")
+    bool validateUtf8Avx2(const byte* data, size_t size)
+    {
+      Utf8CheckerAvx2 checker{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64)
+      {
+        const auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) == 0)
+        {
+          checker.checkAscii(second);
+          continue;
+        }
+        checker.check(first);
+        checker.check(second);
+      }
+      // The tail is padded with ASCII, which catches a truncated sequence.
+      for (; i < size && !checker.failed(); i += 32)
+      {
+        alignas(32) byte block[32] = {};
+        memcpy(block, data + i, std::min<size_t>(32, size - i));
+        checker.check(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)));
+      }
+      checker.checkAscii(_mm256_setzero_si256());
+      const bool valid = !checker.failed();
+      _mm256_zeroupper();
+      return valid;
+    }
+#endif
+
+    ValidateFn selectValidateUtf8()
+    {
+#if BORON_ARCH_X86
+      if (Detail::cpuFeatures().avx2)
+        return validateUtf8Avx2;
+#endif
+      return validateUtf8Scalar;
+    }
+
+    // How far a kernel got: it stops at a character boundary and leaves the
+    // rest, if any, to the scalar loop.
+    struct Blocks
+    {
+      size_t read = 0;
+      size_t written = 0;
+    };
+
+    template <typename Unit>
+    using WideBlocksFn = Blocks (*)(const byte* in, size_t size, Unit* out);
+
+    template <typename Unit>
+    Blocks utf8ToWideBlocksScalar(const byte*, size_t, Unit*)
+    {
+      return {};
+    }
+
+#if BORON_ARCH_X86
+    // The transcoder of Lemire and Keiser, "Transcoding Billions of Unicode
+    // Characters per Second with SIMD Instructions". Which of the first twelve
+    // bytes of a block end a character selects a shuffle that moves up to six
+    // characters of one or two bytes into 16-bit lanes, or up to four of at
+    // most three bytes or three of any length into 32-bit lanes, where shifts
+    // and masks assemble the code points. The ends of 64 bytes are found at
+    // once, so that the only latency from one step to the next is the lookup
+    // of how far the shuffle reads.
+    enum class Utf8ShuffleKind : uint8_t
+    {
+      Upto2Bytes,
+      Upto3Bytes,
+      Upto4Bytes
+    };
+
+    struct Utf8Shuffle
+    {
+      uint8_t shuffle[16];
+      uint8_t count;
+      Utf8ShuffleKind kind;
+    };
+
+    struct Utf8ShuffleIndex
+    {
+      uint16_t shuffle;
+      // Bytes the shuffle consumes, 0 if the first character does not end
+      // in the window, which well-formed input rules out.
+      uint8_t read;
+    };
+
+    constexpr size_t kShuffleWindow = 12;
+
+    struct Utf8ShuffleShape
+    {
+      Utf8ShuffleKind kind;
+      size_t max_length;
+      size_t max_count;
+      // Where the shuffles of this kind start in the table.
+      size_t base;
+    };
+
+    // Shuffles only depend on the lengths of the characters they move, so the
+    // end masks map to one of few: 126 sequences of up to six lengths of one
+    // or two, 120 of up to four lengths up to three and 84 of up to three of
+    // any length.
+    constexpr Utf8ShuffleShape kUtf8ShuffleShapes[] = {
+      {Utf8ShuffleKind::Upto2Bytes, 2, 6, 0},
+      {Utf8ShuffleKind::Upto3Bytes, 3, 4, 126},
+      {Utf8ShuffleKind::Upto4Bytes, 4, 3, 246},
+    };
+    constexpr size_t kUtf8Shuffles = 330;
+
+    struct Utf8ShuffleTables
+    {
+      std::array<Utf8ShuffleIndex, size_t{1} << kShuffleWindow> index;
+      std::array<Utf8Shuffle, kUtf8Shuffles> shuffles;
+    };
+
+    constexpr Utf8ShuffleTables makeUtf8ShuffleTables()
+    {
+      Utf8ShuffleTables tables{};
+      for (size_t ends = 0; ends < tables.index.size(); ends++)
+      {
+        size_t lengths[kShuffleWindow] = {};
+        size_t characters = 0;
+        for (size_t j = 0, start = 0; j < kShuffleWindow; j++)
+        {
+          if (ends >> j & 1)
+          {
+            lengths[characters++] = j + 1 - start;
+            start = j + 1;
+          }
+        }
+
+        // The shape that reads the most, the first of equals.
+        const Utf8ShuffleShape* best = nullptr;
+        size_t best_count = 0, best_read = 0;
+        for (const auto& shape : kUtf8ShuffleShapes)
+        {
+          size_t count = 0, read = 0;
+          while (count < characters && count < shape.max_count && lengths[count] <= shape.max_length)
+            read += lengths[count++];
+          if (read > best_read)
+          {
+            best = &shape;
+            best_count = count;
+            best_read = read;
+          }
+        }
+        if (!best)
+          continue;
+
+        Utf8Shuffle shuffle{};
+        shuffle.kind = best->kind;
+        shuffle.count = static_cast<uint8_t>(best_count);
+        for (auto& lane : shuffle.shuffle)
+          lane = 0x80;
+        // The sequences of count lengths follow all shorter ones, and each
+        // is a number in base max_length.
+        size_t id = best->base, power = 1;
+        for (size_t k = 1; k < best_count; k++)
+        {
+          power *= best->max_length;
+          id += power;
+        }
+        power = 1;
+        const size_t lane_size = best->kind == Utf8ShuffleKind::Upto2Bytes ? 2 : 4;
+        for (size_t k = 0, pos = 0; k < best_count; pos += lengths[k++], power *= best->max_length)
+        {
+          // Last byte first, the lead in the highest byte used.
+          for (size_t b = 0; b < lengths[k]; b++)
+            shuffle.shuffle[lane_size * k + b] = static_cast<uint8_t>(pos + lengths[k] - 1 - b);
+          id += (lengths[k] - 1) * power;
+        }
+        tables.index[ends] = {static_cast<uint16_t>(id), static_cast<uint8_t>(best_read)};
+        tables.shuffles[id] = shuffle;
+      }
+      return tables;
+    }
+
+    constexpr Utf8ShuffleTables kUtf8ShuffleTables = makeUtf8ShuffleTables();
+
+    template <typename Unit>
+    BORON_TARGET("sse4.1")
+    void storeUnits(Unit* out, __m128i units16)
+    {
+      if constexpr (sizeof(Unit) == 2)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), units16);
+      else
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvtepu16_epi32(units16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtepu16_epi32(_mm_srli_si128(units16, 8)));
+      }
+    }
+
+    // Converts the characters shuffle moves out of input and returns the end
+    // of the units written. Up to eight units are stored.
+    template <typename Unit>
+    BORON_TARGET("sse4.1")
+    Unit* convertUtf8Window(__m128i input, const Utf8Shuffle& shuffle, Unit* out)
+    {
+      const auto lanes = _mm_shuffle_epi8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.shuffle)));
+      switch (shuffle.kind)
+      {
+      case Utf8ShuffleKind::Upto2Bytes:
+        // A continuation has bit 6 clear, so the low seven bits serve for
+        // ASCII and for the last byte of a pair alike.
+        storeUnits(out, _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x7F)),
+                                     _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x1F00)), 2)));
+        break;
+      case Utf8ShuffleKind::Upto3Bytes:
+      {
+        const auto code_points =
+          _mm_or_si128(_mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x7F)),
+                                    _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x3F00)), 2)),
+                       _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x0F0000)), 4));
+        if constexpr (sizeof(Unit) == 2)
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi32(code_points, code_points));
+        else
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out), code_points);
+        break;
+      }
+      case Utf8ShuffleKind::Upto4Bytes:
+      {
+        // Every byte loses its length marker, looked up by high nibble.
+        static constexpr uint8_t kPayloadMask[16] = {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F,
+                                                     0x3F, 0x3F, 0x3F, 0x3F, 0x1F, 0x1F, 0x0F, 0x07};
+        const auto mask = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(kPayloadMask)),
+          _mm_and_si128(_mm_srli_epi16(lanes, 4), _mm_set1_epi8(0x0F)));
+        const auto payload = _mm_and_si128(lanes, mask);
+        const auto code_points = _mm_or_si128(
+          _mm_or_si128(_mm_and_si128(payload, _mm_set1_epi32(0x7F)),
+                       _mm_and_si128(_mm_srli_epi32(payload, 2), _mm_set1_epi32(0xFC0))),
+          _mm_or_si128(_mm_and_si128(_mm_srli_epi32(payload, 4), _mm_set1_epi32(0x3F000)),
+                       _mm_and_si128(_mm_srli_epi32(payload, 6), _mm_set1_epi32(0x1C0000))));
+        if constexpr (sizeof(Unit) == 2)
+        {
+          // Surrogate pairs, high half first, or the code point alone. Each
+          // lane is stored as two units, of which the second may be kept.
+          alignas(16) uint32_t units[4];
+          const auto offset = _mm_sub_epi32(code_points, _mm_set1_epi32(0x10000));
+          const auto pairs = _mm_or_si128(
+            _mm_add_epi32(_mm_srli_epi32(offset, 10), _mm_set1_epi32(0xD800)),
+            _mm_slli_epi32(_mm_or_si128(_mm_and_si128(offset, _mm_set1_epi32(0x3FF)), _mm_set1_epi32(0xDC00)), 16));
+          const auto wide = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0xFFFF));
+          _mm_store_si128(reinterpret_cast<__m128i*>(units), _mm_blendv_epi8(code_points, pairs, wide));
+          for (size_t k = 0; k < shuffle.count; k++)
+          {
+            memcpy(out, &units[k], 4);
+            out += 1 + (units[k] > 0xFFFF);
+          }
+          return out;
+        }
+        else
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out), code_points);
+        break;
+      }
+      }
+      return out + shuffle.count;
+    }
+
+    template <typename Unit>
+    BORON_TARGET("sse4.1")
+    Blocks utf8ToWideSse41(const byte* in, size_t size, Unit* out)
+    {
+      // The shuffles trust the input to be well-formed.
+      if (size < 96 || !Detail::dispatched<selectValidateUtf8>()(in, size))
+        return {};
+      const auto begin = out;
+      size_t i = 0;
+      // A step stores sixteen units for sixteen bytes of ASCII, or up to
+      // eight for fewer characters. It starts at least 48 bytes before the
+      // end, so at least twelve more characters are to come and the output
+      // has room for the excess.
+      while (size - i >= 96)
+      {
+        const auto chunk = in + i;
+        uint64_t high = 0, continuations = 0;
+        for (size_t k = 0; k < 64; k += 16)
+        {
+          const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + k));
+          high |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(input))) << k;
+          continuations |= static_cast<uint64_t>(static_cast<uint32_t>(
+                             _mm_movemask_epi8(_mm_cmplt_epi8(input, _mm_set1_epi8(char(0xC0)))))) << k;
+        }
+        // A byte ends a character when the next one starts another.
+        const auto ends = ~continuations >> 1;
+        size_t pos = 0;
+        while (pos <= 48)
+        {
+          const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + pos));
+          if ((high >> pos & 0xFFFF) == 0)
+          {
+            storeUnits(out, _mm_cvtepu8_epi16(input));
+            storeUnits(out + 8, _mm_cvtepu8_epi16(_mm_srli_si128(input, 8)));
+            pos += 16;
+            out += 16;
+            continue;
+          }
+          const auto index = kUtf8ShuffleTables.index[ends >> pos & ((1u << kShuffleWindow) - 1)];
+          if (index.read == 0)
+            return {i + pos, static_cast<size_t>(out - begin)};
+          out = convertUtf8Window(input, kUtf8ShuffleTables.shuffles[index.shuffle], out);
+          pos += index.read;
+        }
+        i += pos;
+      }
+      return {i, static_cast<size_t>(out - begin)};
+    }
+#endif
+
+    template <typename Unit>
+    WideBlocksFn<Unit> selectUtf8ToWideBlocks()
+    {
+#if BORON_ARCH_X86
+      if (Detail::cpuFeatures().sse41)
+        return utf8ToWideSse41<Unit>;
+#endif
+      return utf8ToWideBlocksScalar<Unit>;
+    }
+
+    template <typename Unit>
+    TranscodeResult utf8ToWide(ByteArrayView utf8, Unit* out)
+    {
+      const auto in = utf8.data();
+      const auto size = utf8.size();
+      const auto begin = out;
+      const auto blocks = Detail::dispatched<selectUtf8ToWideBlocks<Unit>>()(in, size, out);
+      size_t i = blocks.read;
+      out += blocks.written;
+      while (i < size)
+      {
+        if (size - i >= kAsciiBlock && isAsciiBlock(in + i))
+        {
+          for (size_t k = 0; k < kAsciiBlock; k++)
+            out[k] = in[i + k];
+          out += kAsciiBlock;
+          i += kAsciiBlock;
+          continue;
+        }
+        if (size - i >= 8)
+        {
+          // The ASCII before the next wide character, up to eight bytes.
+          const auto high = loadEndian<uint64_t, std::endian::little>(in + i) & kHighBits;
+          const auto ascii = high ? static_cast<size_t>(std::countr_zero(high)) / 8 : 8;
+          for (size_t k = 0; k < ascii; k++)
+            out[k] = in[i + k];
+          out += ascii;
+          i += ascii;
+          if (ascii == 8)
+            continue;
+        }
+        char32_t cp;
+        const auto n = decodeUtf8(in + i, size - i, cp);
+        if (n == 0)
+          return {static_cast<size_t>(out - begin), i};
+        if (sizeof(Unit) == 2 && cp >= 0x10000)
+        {
+          *out++ = static_cast<Unit>(0xD800 + ((cp - 0x10000) >> 10));
+          *out++ = static_cast<Unit>(0xDC00 + (cp & 0x3FF));
+        }
+        else
+          *out++ = static_cast<Unit>(cp);
+        i += n;
+      }
+      return {static_cast<size_t>(out - begin), ByteArray::kNpos};
+    }
+
+    // Whether the kAsciiBlock units at p are all below 0x80.
+    template <typename Unit>
+    bool isAsciiBlock(const Unit* p)
+    {
+      Unit bits = 0;
+      for (size_t k = 0; k < kAsciiBlock; k++)
+        bits |= p[k];
+      return bits < 0x80;
+    }
+
+    template <typename Unit>
+    void narrowBlock(const Unit* in, byte* out)
+    {
+      for (size_t k = 0; k < kAsciiBlock; k++)
+        out[k] = static_cast<byte>(in[k]);
+    }
+
+    constexpr bool isSurrogate(char32_t c) { return c - 0xD800 < 0x800; }
+
+    // Units of the character at in, stored in c, or 0 for an unpaired
+    // surrogate.
+    size_t decodeUtf16(const char16_t* in, size_t size, char32_t& c)
+    {
+      c = in[0];
+      if (!isSurrogate(c))
+        return 1;
+      // A high surrogate followed by a low one.
+      if (c >= 0xDC00 || size == 1 || in[1] < 0xDC00 || in[1] > 0xDFFF)
+        return 0;
+      c = 0x10000 + ((c - 0xD800) << 10 | (in[1] - 0xDC00));
+      return 2;
+    }
+
+    template <typename Unit>
+    using NarrowBlocksFn = Blocks (*)(const Unit* in, size_t size, byte* out);
+
+    template <typename Unit>
+    Blocks toUtf8BlocksScalar(const Unit*, size_t, byte*)
+    {
+      return {};
+    }
+
+#if BORON_ARCH_X86
+    // The other direction of the same paper. Code points are spread to
+    // 32-bit lanes, each lane holding the UTF-8 bytes of its code point in
+    // order, and a shuffle selected by the four lengths packs them.
+    struct Utf8Pack
+    {
+      uint8_t shuffle[16];
+      uint8_t count;
+    };
+
+    // Indexed by the lengths less one, two bits per lane, first lane lowest.
+    constexpr auto kUtf8LanePacks = [] {
+      std::array<Utf8Pack, 256> packs{};
+      for (size_t key = 0; key < packs.size(); key++)
+      {
+        auto& pack = packs[key];
+        for (auto& lane : pack.shuffle)
+          lane = 0x80;
+        for (size_t k = 0; k < 4; k++)
+        {
+          for (size_t b = 0; b <= (key >> 2 * k & 3); b++)
+            pack.shuffle[pack.count++] = static_cast<uint8_t>(4 * k + b);
+        }
+      }
+      return packs;
+    }();
+
+    // The same for eight code points below U+0800 in 16-bit lanes, indexed by
+    // which of them take two bytes.
+    constexpr auto kUtf8PairPacks = [] {
+      std::array<Utf8Pack, 256> packs{};
+      for (size_t key = 0; key < packs.size(); key++)
+      {
+        auto& pack = packs[key];
+        for (auto& lane : pack.shuffle)
+          lane = 0x80;
+        for (size_t k = 0; k < 8; k++)
+        {
+          for (size_t b = 0; b <= (key >> k & 1); b++)
+            pack.shuffle[pack.count++] = static_cast<uint8_t>(2 * k + b);
+        }
+      }
+      return packs;
+    }();
+
+    // The four bits of a lane mask moved to the low bit of every two.
+    constexpr auto kSpreadLanes = [] {
+      std::array<uint8_t, 16> spread{};
+      for (size_t bits = 0; bits < spread.size(); bits++)
+      {
+        for (size_t k = 0; k < 4; k++)
+          spread[bits] |= static_cast<uint8_t>((bits >> k & 1) << 2 * k);
+      }
+      return spread;
+    }();
+
+    // The UTF-8 bytes of the four valid code points in code_points, each in
+    // its lane, and the key of their lengths in kUtf8LanePacks.
+    struct Utf8Lanes
+    {
+      __m128i lanes;
+      size_t key;
+    };
+
+    BORON_TARGET("sse4.1")
+    Utf8Lanes utf8Lanes(__m128i code_points)
+    {
+      const auto low6 = _mm_set1_epi32(0x3F);
+      const auto c0 = _mm_and_si128(code_points, low6);
+      const auto c1 = _mm_and_si128(_mm_srli_epi32(code_points, 6), low6);
+      const auto c2 = _mm_and_si128(_mm_srli_epi32(code_points, 12), low6);
+      const auto two =
+        _mm_or_si128(_mm_set1_epi32(0x80C0), _mm_or_si128(_mm_srli_epi32(code_points, 6), _mm_slli_epi32(c0, 8)));
+      const auto three = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0x8080E0), _mm_srli_epi32(code_points, 12)),
+                                      _mm_or_si128(_mm_slli_epi32(c1, 8), _mm_slli_epi32(c0, 16)));
+      const auto four = _mm_or_si128(
+        _mm_or_si128(_mm_set1_epi32(static_cast<int>(0x808080F0)), _mm_srli_epi32(code_points, 18)),
+        _mm_or_si128(_mm_slli_epi32(c2, 8), _mm_or_si128(_mm_slli_epi32(c1, 16), _mm_slli_epi32(c0, 24))));
+
+      const auto two_bytes = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0x7F));
+      const auto three_bytes = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0x7FF));
+      const auto four_bytes = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0xFFFF));
+      auto lanes = _mm_blendv_epi8(code_points, two, two_bytes);
+      lanes = _mm_blendv_epi8(lanes, three, three_bytes);
+      lanes = _mm_blendv_epi8(lanes, four, four_bytes);
+      const size_t key = kSpreadLanes[_mm_movemask_ps(_mm_castsi128_ps(two_bytes))] +
+                         kSpreadLanes[_mm_movemask_ps(_mm_castsi128_ps(three_bytes))] +
+                         kSpreadLanes[_mm_movemask_ps(_mm_castsi128_ps(four_bytes))];
+      return {lanes, key};
+    }
+
+    // Packs the lanes and returns the end of the bytes written. Sixteen bytes
+    // are stored.
+    BORON_TARGET("sse4.1")
+    byte* storeUtf8Lanes(Utf8Lanes utf8, byte* out)
+    {
+      const auto& pack = kUtf8LanePacks[utf8.key];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                       _mm_shuffle_epi8(utf8.lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pack.shuffle))));
+      return out + pack.count;
+    }
+
+    // Four UTF-16 units in 32-bit lanes, with the unit before each in
+    // previous, and every surrogate paired. A pair takes four bytes, so the
+    // high surrogate stands for the first two and the low one for the last
+    // two, which keeps one lane per unit.
+    BORON_TARGET("sse4.1")
+    Utf8Lanes utf16Lanes(__m128i units, __m128i previous)
+    {
+      auto utf8 = utf8Lanes(units);
+      const auto top5 = _mm_set1_epi32(0xF800);
+      const auto top6 = _mm_set1_epi32(0xFC00);
+      const auto surrogates = _mm_cmpeq_epi32(_mm_and_si128(units, top5), _mm_set1_epi32(0xD800));
+      const auto highs = _mm_cmpeq_epi32(_mm_and_si128(units, top6), _mm_set1_epi32(0xD800));
+
+      // The code point of a pair is t << 10 | (low - 0xDC00) with t = high -
+      // 0xD7C0: the top three bits of t follow the lead 11110, the next six
+      // make the first continuation and the last two begin the second, which
+      // the low surrogate completes.
+      const auto t = _mm_sub_epi32(units, _mm_set1_epi32(0xD7C0));
+      const auto high_bytes = _mm_or_si128(
+        _mm_or_si128(_mm_set1_epi32(0x80F0), _mm_srli_epi32(t, 8)),
+        _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(t, 2), _mm_set1_epi32(0x3F)), 8));
+      const auto low_bytes = _mm_or_si128(
+        _mm_or_si128(_mm_set1_epi32(0x8080), _mm_slli_epi32(_mm_and_si128(previous, _mm_set1_epi32(3)), 4)),
+        _mm_or_si128(_mm_and_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0xF)),
+                     _mm_slli_epi32(_mm_and_si128(units, _mm_set1_epi32(0x3F)), 8)));
+      utf8.lanes = _mm_blendv_epi8(utf8.lanes, _mm_blendv_epi8(low_bytes, high_bytes, highs), surrogates);
+
+      // Two bytes for either half, where utf8Lanes() counted three.
+      const auto surrogate_bits = static_cast<size_t>(_mm_movemask_ps(_mm_castsi128_ps(surrogates)));
+      utf8.key -= kSpreadLanes[surrogate_bits];
+      return utf8;
+    }
+
+    // Blocks of sixteen ASCII units, of eight below U+0800 or of eight with
+    // every surrogate paired take no branch per unit. A step stores at most
+    // thirteen bytes past what it writes, and at least sixteen units are left
+    // after it, for which out has room.
+    BORON_TARGET("sse4.1")
+    Blocks utf16ToUtf8Sse41(const char16_t* in, size_t size, byte* out)
+    {
+      const auto begin = out;
+      size_t i = 0;
+      while (size - i >= 24)
+      {
+        const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const auto next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+        if (_mm_testz_si128(_mm_or_si128(input, next), _mm_set1_epi16(static_cast<short>(0xFF80))))
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(input, next));
+          out += 16;
+          i += 16;
+          continue;
+        }
+        if (_mm_testz_si128(input, _mm_set1_epi16(static_cast<short>(0xF800))))
+        {
+          // A lead of 110 and the top five bits, then 10 and the low six.
+          const auto ascii = _mm_cmplt_epi16(input, _mm_set1_epi16(0x80));
+          const auto two = _mm_or_si128(
+            _mm_set1_epi16(static_cast<short>(0x80C0)),
+            _mm_or_si128(_mm_srli_epi16(input, 6), _mm_slli_epi16(_mm_and_si128(input, _mm_set1_epi16(0x3F)), 8)));
+          const auto lanes = _mm_blendv_epi8(two, input, ascii);
+          const auto key = ~_mm_movemask_epi8(_mm_packs_epi16(ascii, ascii)) & 0xFF;
+          const auto& pack = kUtf8PairPacks[key];
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                           _mm_shuffle_epi8(lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pack.shuffle))));
+          out += pack.count;
+          i += 8;
+          continue;
+        }
+
+        // Every low surrogate must follow a high one. A high surrogate last
+        // in the block is left for the next step, so the first unit of a
+        // block is never the low half of a pair.
+        const auto top6 = _mm_set1_epi16(static_cast<short>(0xFC00));
+        const auto highs = _mm_cmpeq_epi16(_mm_and_si128(input, top6), _mm_set1_epi16(static_cast<short>(0xD800)));
+        const auto lows = _mm_cmpeq_epi16(_mm_and_si128(input, top6), _mm_set1_epi16(static_cast<short>(0xDC00)));
+        const auto high_bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(highs, highs))) & 0xFF;
+        const auto low_bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(lows, lows))) & 0xFF;
+        if (low_bits != (high_bits << 1 & 0xFF))
+          break;
+        const auto previous = _mm_slli_si128(input, 2);
+        out = storeUtf8Lanes(utf16Lanes(_mm_cvtepu16_epi32(input), _mm_cvtepu16_epi32(previous)), out);
+        out = storeUtf8Lanes(utf16Lanes(_mm_cvtepu16_epi32(_mm_srli_si128(input, 8)),
+                                        _mm_cvtepu16_epi32(_mm_srli_si128(previous, 8))),
+                             out);
+        const auto split = high_bits >> 7;
+        out -= 2 * split;
+        i += 8 - split;
+      }
+      return {i, static_cast<size_t>(out - begin)};
+    }
+
+    // Stops before the first block with a code point that is too large or a
+    // surrogate, which the scalar loop then finds. A step of four stores at
+    // most twelve bytes past what it writes, for the twelve units at least
+    // that follow.
+    BORON_TARGET("sse4.1")
+    Blocks utf32ToUtf8Sse41(const char32_t* in, size_t size, byte* out)
+    {
+      const auto begin = out;
+      size_t i = 0;
+      while (size - i >= 16)
+      {
+        const auto p = reinterpret_cast<const __m128i*>(in + i);
+        const auto a = _mm_loadu_si128(p);
+        const auto b = _mm_loadu_si128(p + 1);
+        const auto c = _mm_loadu_si128(p + 2);
+        const auto d = _mm_loadu_si128(p + 3);
+        if (_mm_testz_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)),
+                            _mm_set1_epi32(static_cast<int>(0xFFFFFF80))))
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                           _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d)));
+          out += 16;
+          i += 16;
+          continue;
+        }
+        const auto max = _mm_set1_epi32(0x10FFFF);
+        const auto too_large = _mm_xor_si128(_mm_cmpeq_epi32(_mm_max_epu32(a, max), max), _mm_set1_epi32(-1));
+        const auto surrogates =
+          _mm_cmpeq_epi32(_mm_and_si128(a, _mm_set1_epi32(static_cast<int>(0xFFFFF800))), _mm_set1_epi32(0xD800));
+        const auto invalid = _mm_or_si128(too_large, surrogates);
+        if (!_mm_testz_si128(invalid, invalid))
+          break;
+        out = storeUtf8Lanes(utf8Lanes(a), out);
+        i += 4;
+      }
+      return {i, static_cast<size_t>(out - begin)};
+    }
+#endif
+
+    NarrowBlocksFn<char16_t> selectUtf16ToUtf8Blocks()
+    {
+#if BORON_ARCH_X86
+      if (Detail::cpuFeatures().sse41)
+        return utf16ToUtf8Sse41;
+#endif
+      return toUtf8BlocksScalar<char16_t>;
+    }
+
+    NarrowBlocksFn<char32_t> selectUtf32ToUtf8Blocks()
+    {
+#if BORON_ARCH_X86
+      if (Detail::cpuFeatures().sse41)
+        return utf32ToUtf8Sse41;
+#endif
+      return toUtf8BlocksScalar<char32_t>;
+    }
+  } // namespace
+
+  bool isValidUtf8(ByteArrayView data) noexcept
+  {
+    return Detail::dispatched<selectValidateUtf8>()(data.data(), data.size());
+  }
+
+  size_t utf16LengthOfUtf8(ByteArrayView utf8) noexcept
+  {
+    // Every byte but a continuation starts a unit, and four-byte leads start
+    // a surrogate pair.
+    size_t length = 0;
+    for (const auto b : utf8)
+      length += static_cast<size_t>(!Detail::isUtf8Continuation(b)) + (b >= 0xF0);
+    return length;
+  }
+
+  size_t utf32LengthOfUtf8(ByteArrayView utf8) noexcept
+  {
+    size_t length = 0;
+    for (const auto b : utf8)
+      length += !Detail::isUtf8Continuation(b);
+    return length;
+  }
+
+  size_t utf8LengthOfUtf16(std::u16string_view utf16) noexcept
+  {
+    // Each half of a surrogate pair stands for two of its four bytes.
+    size_t length = 0;
+    for (const char32_t c : utf16)
+      length += 1 + (c >= 0x80) + (c >= 0x800) - isSurrogate(c);
+    return length;
+  }
+
+  size_t utf8LengthOfUtf32(std::u32string_view utf32) noexcept
+  {
+    size_t length = 0;
+    for (const auto c : utf32)
+      length += 1 + (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
+    return length;
+  }
+
+  TranscodeResult utf8ToUtf16(ByteArrayView utf8, char16_t* out) noexcept
+  {
+    return utf8ToWide(utf8, out);
+  }
+
+  TranscodeResult utf8ToUtf32(ByteArrayView utf8, char32_t* out) noexcept
+  {
+    return utf8ToWide(utf8, out);
+  }
+
+  TranscodeResult utf16ToUtf8(std::u16string_view utf16, byte* out) noexcept
+  {
+    const auto in = utf16.data();
+    const auto size = utf16.size();
+    const auto begin = out;
+    const auto blocks = Detail::dispatched<selectUtf16ToUtf8Blocks>()(in, size, out);
+    size_t i = blocks.read;
+    out += blocks.written;
+    while (i < size)
+    {
+      if (size - i >= kAsciiBlock && isAsciiBlock(in + i))
+      {
+        narrowBlock(in + i, out);
+        out += kAsciiBlock;
+        i += kAsciiBlock;
+        continue;
+      }
+      char32_t c;
+      const auto n = decodeUtf16(in + i, size - i, c);
+      if (n == 0)
+        return {static_cast<size_t>(out - begin), i};
+      out += encodeUtf8(c, out);
+      i += n;
+    }
+    return {static_cast<size_t>(out - begin), ByteArray::kNpos};
+  }
+
+  TranscodeResult utf32ToUtf8(std::u32string_view utf32, byte* out) noexcept
+  {
+    const auto in = utf32.data();
+    const auto size = utf32.size();
+    const auto begin = out;
+    const auto blocks = Detail::dispatched<selectUtf32ToUtf8Blocks>()(in, size, out);
+    size_t i = blocks.read;
+    out += blocks.written;
+    while (i < size)
+    {
+      if (size - i >= kAsciiBlock && isAsciiBlock(in + i))
+      {
+        narrowBlock(in + i, out);
+        out += kAsciiBlock;
+        i += kAsciiBlock;
+        continue;
+      }
+      const auto c = in[i];
+      if (c > 0x10FFFF || isSurrogate(c))
+        return {static_cast<size_t>(out - begin), i};
+      out += encodeUtf8(c, out);
+      ++i;
+    }
+    return {static_cast<size_t>(out - begin), ByteArray::kNpos};
+  }
+} // namespace Boron
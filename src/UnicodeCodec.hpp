@@ -0,0 +1,99 @@
+#ifndef BORON_SRC_UNICODECODEC_HPP_
+#define BORON_SRC_UNICODECODEC_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  constexpr char32_t kReplacementCharacter = 0xFFFD;
+
+  // Range of the byte after lead in a well-formed sequence, from Table 3-7 of
+  // the Unicode standard. It excludes overlong forms, surrogates and code
+  // points above U+10FFFF.
+  constexpr byte utf8SecondMin(byte lead) { return lead == 0xE0 ? 0xA0 : lead == 0xF0 ? 0x90 : 0x80; }
+  constexpr byte utf8SecondMax(byte lead) { return lead == 0xED ? 0x9F : lead == 0xF4 ? 0x8F : 0xBF; }
+
+  // Bytes in the sequence lead starts, 0 if it cannot start one.
+  constexpr size_t utf8SequenceLength(byte lead)
+  {
+    if (lead < 0x80)
+      return 1;
+    if (lead < 0xC2)
+      return 0;
+    if (lead < 0xE0)
+      return 2;
+    if (lead < 0xF0)
+      return 3;
+    return lead < 0xF5 ? 4 : 0;
+  }
+
+  // Decodes the sequence at the start of in and returns its length, or 0 if
+  // it is malformed or truncated.
+  inline size_t decodeUtf8(const byte* in, size_t size, char32_t& cp)
+  {
+    const auto lead = in[0];
+    const auto length = utf8SequenceLength(lead);
+    if (length == 1)
+    {
+      cp = lead;
+      return 1;
+    }
+    if (length == 0 || size < length || in[1] < utf8SecondMin(lead) || in[1] > utf8SecondMax(lead))
+      return 0;
+    char32_t result = lead & (0x7F >> length);
+    for (size_t i = 1; i < length; i++)
+    {
+      if ((in[i] & 0xC0) != 0x80)
+        return 0;
+      result = result << 6 | (in[i] & 0x3F);
+    }
+    cp = result;
+    return length;
+  }
+
+  // Length of the maximal subpart of the malformed sequence at the start of
+  // in, the bytes that one U+FFFD replaces.
+  inline size_t malformedUtf8Length(const byte* in, size_t size)
+  {
+    const auto lead = in[0];
+    const auto length = utf8SequenceLength(lead);
+    if (length == 0 || size < 2 || in[1] < utf8SecondMin(lead) || in[1] > utf8SecondMax(lead))
+      return 1;
+    size_t i = 2;
+    while (i < length && i < size && (in[i] & 0xC0) == 0x80)
+      ++i;
+    return i;
+  }
+
+  // Writes cp, which must not be a surrogate, and returns the bytes written.
+  inline size_t encodeUtf8(char32_t cp, byte* out)
+  {
+    if (cp < 0x80)
+    {
+      out[0] = static_cast<byte>(cp);
+      return 1;
+    }
+    if (cp < 0x800)
+    {
+      out[0] = static_cast<byte>(0xC0 | cp >> 6);
+      out[1] = static_cast<byte>(0x80 | (cp & 0x3F));
+      return 2;
+    }
+    if (cp < 0x10000)
+    {
+      out[0] = static_cast<byte>(0xE0 | cp >> 12);
+      out[1] = static_cast<byte>(0x80 | (cp >> 6 & 0x3F));
+      out[2] = static_cast<byte>(0x80 | (cp & 0x3F));
+      return 3;
+    }
+    out[0] = static_cast<byte>(0xF0 | cp >> 18);
+    out[1] = static_cast<byte>(0x80 | (cp >> 12 & 0x3F));
+    out[2] = static_cast<byte>(0x80 | (cp >> 6 & 0x3F));
+    out[3] = static_cast<byte>(0x80 | (cp & 0x3F));
+    return 4;
+  }
+
+  constexpr bool isUtf8Continuation(byte b) { return (b & 0xC0) == 0x80; }
+} // namespace Boron::Detail
+
+#endif
@@ -0,0 +1,158 @@
+#include "Boron/Varint.hpp"
+#include "Boron/Endian.hpp"
+#include "CpuFeatures.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron
+{
+  namespace
+  {
+    using DecodeFn = DecodeVarintsResult (*)(const byte* in, size_t size, uint64_t* out, size_t capacity);
+
+    // Gathers the low seven bits of each byte of x into the low 56 bits.
+    uint64_t compactSevenBitGroups(uint64_t x)
+    {
+      x &= 0x7F7F7F7F7F7F7F7F;
+      x = (x & 0x007F007F007F007F) | (x & 0x7F007F007F007F00) >> 1;
+      x = (x & 0x00003FFF00003FFF) | (x & 0x3FFF00003FFF0000) >> 2;
+      return (x & 0x000000000FFFFFFF) | (x & 0x0FFFFFFF00000000) >> 4;
+    }
+
+    // Up to eight bytes are handled with one load: the first clear top bit
+    // gives the length and the groups are gathered without a loop.
+    size_t decodeOne(const byte* in, size_t size, uint64_t& value)
+    {
+      if (size >= 8)
+      {
+        const auto x = loadEndian<uint64_t, std::endian::little>(in);
+        const auto ends = ~x & 0x8080808080808080;
+        if (ends)
+        {
+          const auto bits = std::countr_zero(ends) + 1;
+          value = compactSevenBitGroups(x & ~uint64_t{0} >> (64 - bits));
+          return static_cast<size_t>(bits) / 8;
+        }
+      }
+      return decodeVarint(in, size, value);
+    }
+
+    DecodeVarintsResult decodeVarintsScalar(const byte* in, size_t size, uint64_t* out, size_t capacity)
+    {
+      DecodeVarintsResult result;
+      while (result.count < capacity && result.consumed < size)
+      {
+        const auto n = decodeOne(in + result.consumed, size - result.consumed, out[result.count]);
+        if (!n)
+          break;
+        result.consumed += n;
+        result.count++;
+      }
+      return result;
+    }
+
+#if BORON_ARCH_X86
+    // Masked VByte reduced to what fits a small table: the continuation bits
+    // of eight input bytes select a shuffle that moves each varint of one or
+    // two bytes into a 16-bit lane, along with how many varints that is and
+    // how many bytes they take. count is 0 when the first varint is longer.
+    struct ShortVarintPattern
+    {
+      std::array<uint8_t, 16> shuffle;
+      uint8_t count;
+      uint8_t consumed;
+    };
+
+    constexpr auto kShortVarintPatterns = [] {
+      std::array<ShortVarintPattern, 256> patterns{};
+      for (unsigned mask = 0; mask < 256; mask++)
+      {
+        auto& pattern = patterns[mask];
+        pattern.shuffle.fill(0x80);
+        unsigned pos = 0;
+        while (pos < 8)
+        {
+          const auto length = (mask >> pos & 1) ? 2u : 1u;
+          if (pos + length > 8 || (length == 2 && (mask >> (pos + 1) & 1)))
+            break;
+          pattern.shuffle[2 * pattern.count] = static_cast<uint8_t>(pos);
+          if (length == 2)
+            pattern.shuffle[2 * pattern.count + 1] = static_cast<uint8_t>(pos + 1);
+          pattern.count++;
+          pos += length;
+        }
+        pattern.consumed = static_cast<uint8_t>(pos);
+      }
+      return patterns;
+    }();
+
+    BORON_TARGET("ssse3")
+    DecodeVarintsResult decodeVarintsSsse3(const byte* in, size_t size, uint64_t* out, size_t capacity)
+    {
+      DecodeVarintsResult result;
+      // Sixteen readable bytes keep decodeOne() on its single load path, and
+      // room for eight values lets the stores ignore the count.
+      while (result.consumed + 16 <= size && capacity - result.count >= 8)
+      {
+        const auto p = in + result.consumed;
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto& pattern = kShortVarintPatterns[_mm_movemask_epi8(block) & 0xFF];
+        if (!pattern.count)
+        {
+          // Longer varints one by one, for as long as they start in the
+          // first half of the block, before loading the next block.
+          const auto block_end = result.consumed + 8;
+          while (result.consumed < block_end && result.count < capacity)
+          {
+            const auto n = decodeOne(in + result.consumed, size - result.consumed, out[result.count]);
+            if (!n)
+              return result;
+            result.consumed += n;
+            result.count++;
+          }
+          continue;
+        }
+        auto lanes = _mm_shuffle_epi8(block, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.shuffle.data())));
+        lanes = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x007F)),
+                             _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x7F00)), 1));
+        const auto zero = _mm_setzero_si128();
+        const auto low = _mm_unpacklo_epi16(lanes, zero);
+        const auto high = _mm_unpackhi_epi16(lanes, zero);
+        const auto dst = reinterpret_cast<__m128i*>(out + result.count);
+        _mm_storeu_si128(dst, _mm_unpacklo_epi32(low, zero));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi32(low, zero));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi32(high, zero));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi32(high, zero));
+        result.consumed += pattern.consumed;
+        result.count += pattern.count;
+      }
+      const auto tail = decodeVarintsScalar(in + result.consumed, size - result.consumed, out + result.count,
+                                            capacity - result.count);
+      result.consumed += tail.consumed;
+      result.count += tail.count;
+      return result;
+    }
+#endif
+
+    DecodeFn selectVarintKernel()
+    {
+#if BORON_ARCH_X86
+      if (Detail::cpuFeatures().ssse3)
+        return decodeVarintsSsse3;
+#endif
+      return decodeVarintsScalar;
+    }
+  } // namespace
+
+  DecodeVarintsResult decodeVarints(ByteArrayView input, std::span<uint64_t> out)
+  {
+    return Detail::dispatched<selectVarintKernel>()(input.data(), input.size(), out.data(), out.size());
+  }
+} // namespace Boron
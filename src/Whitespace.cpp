@@ -0,0 +1,144 @@
+#include "Whitespace.hpp"
+#include "CpuFeatures.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if BORON_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace Boron::Detail
+{
+  namespace
+  {
+    constexpr auto kIsWhitespace = [] {
+      std::array<bool, 256> table{};
+      for (const byte c : {'\0', '\t', '\n', '\v', '\f', '\r', ' '})
+        table[c] = true;
+      return table;
+    }();
+
+    // Simplifying rewrites every whitespace byte as ' ' and drops it when
+    // the byte before was whitespace too, with after_space carrying that
+    // across calls. Kernels write to out no further than they have read from
+    // in, so out may be in, and return the number of bytes written.
+    using SimplifyFn = size_t (*)(const byte* in, size_t size, byte* out, bool& after_space);
+
+    size_t simplifyScalar(const byte* in, size_t size, byte* out, bool& after_space)
+    {
+      // A ' ' for a run is written as soon as the run starts and is
+      // overwritten in place by the rest of it, so there are no branches.
+      size_t written = 0;
+      for (size_t i = 0; i < size; i++)
+      {
+        const bool space = kIsWhitespace[in[i]];
+        out[written] = space ? ' ' : in[i];
+        written += !(space && after_space);
+        after_space = space;
+      }
+      return written;
+    }
+
+#if BORON_ARCH_X86
+    // For every mask of bytes to keep out of eight, the pshufb control that
+    // packs them to the front, and their number.
+    struct CompactTable
+    {
+      std::array<std::array<byte, 8>, 256> shuffles;
+      std::array<byte, 256> counts;
+    };
+
+    constexpr auto kCompactTable = [] {
+      CompactTable table{};
+      for (int keep = 0; keep < 256; keep++)
+      {
+        byte count = 0;
+        for (byte i = 0; i < 8; i++)
+        {
+          if (keep >> i & 1)
+            table.shuffles[keep][count++] = i;
+        }
+        table.counts[keep] = count;
+      }
+      return table;
+    }();
+
+    // '\t' to '\r' move to the bottom of the signed range, where one compare
+    // finds them; ' ' and NUL take one compare each.
+    BORON_TARGET("ssse3")
+    __m128i whitespaceSsse3(__m128i v)
+    {
+      const auto controls =
+        _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - '\t'))), _mm_set1_epi8(-0x80 + 5));
+      const auto spaces = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_setzero_si128()));
+      return _mm_or_si128(controls, spaces);
+    }
+
+    // Each half of a 16-byte block is packed with pshufb and stored as
+    // eight bytes. A store may run past the bytes kept, but not past the
+    // block just loaded.
+    BORON_TARGET("ssse3")
+    size_t simplifySsse3(const byte* in, size_t size, byte* out, bool& after_space)
+    {
+      size_t written = 0;
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16)
+      {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const auto space = whitespaceSsse3(v);
+        const auto bits = static_cast<uint32_t>(_mm_movemask_epi8(space));
+        const auto drop = bits & (bits << 1 | static_cast<uint32_t>(after_space));
+        const auto keep = ~drop & 0xFFFF;
+        after_space = bits >> 15;
+
+        const auto low = keep & 0xFF;
+        const auto high = keep >> 8;
+        const auto control = _mm_unpacklo_epi64(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kCompactTable.shuffles[low].data())),
+          _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(kCompactTable.shuffles[high].data())),
+                       _mm_set1_epi8(8)));
+        const auto spaced = _mm_or_si128(_mm_andnot_si128(space, v), _mm_and_si128(space, _mm_set1_epi8(' ')));
+        const auto packed = _mm_shuffle_epi8(spaced, control);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + written), packed);
+        written += kCompactTable.counts[low];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + written), _mm_srli_si128(packed, 8));
+        written += kCompactTable.counts[high];
+      }
+      return written + simplifyScalar(in + i, size - i, out + written, after_space);
+    }
+#endif
+
+    SimplifyFn selectSimplify()
+    {
+#if BORON_ARCH_X86
+      if (cpuFeatures().ssse3)
+        return simplifySsse3;
+#endif
+      return simplifyScalar;
+    }
+  } // namespace
+
+  ByteArrayView trimWhitespace(ByteArrayView data)
+  {
+    // Usually only a few bytes at either end are looked at.
+    auto l = data.begin(), r = data.end();
+    while (l < r && kIsWhitespace[*l])
+      ++l;
+    while (l < r && kIsWhitespace[*(r - 1)])
+      --r;
+    return data.sliced(l - data.begin(), r - l);
+  }
+
+  size_t simplifyWhitespace(ByteArrayView data, byte* out)
+  {
+    // Starting as if after whitespace drops the leading run; the trailing
+    // one leaves a ' ' behind.
+    bool after_space = true;
+    auto written = dispatched<selectSimplify>()(data.data(), data.size(), out, after_space);
+    if (after_space && written != 0)
+      --written;
+    return written;
+  }
+} // namespace Boron::Detail
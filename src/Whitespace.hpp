@@ -0,0 +1,18 @@
+#ifndef BORON_SRC_WHITESPACE_HPP_
+#define BORON_SRC_WHITESPACE_HPP_
+
+#include "Boron/ByteArray.hpp"
+
+namespace Boron::Detail
+{
+  // What trimmed() and simplified() strip: the six ASCII spaces of
+  // std::isspace in the C locale, and NUL, whatever the current locale.
+  ByteArrayView trimWhitespace(ByteArrayView data);
+
+  // Writes data trimmed, with every inner run of whitespace replaced by a
+  // single ' ', to out and returns the size written. out may be data.data():
+  // no byte is written before it has been read.
+  size_t simplifyWhitespace(ByteArrayView data, byte* out);
+} // namespace Boron::Detail
+
+#endif
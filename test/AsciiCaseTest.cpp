@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+
+using Boron::ByteArray;
+using Boron::ByteArrayView;
+using Boron::CaseSensitivity;
+
+namespace
+{
+  // Letters dominate, with every other byte, including those above 0x7F
+  // whose low seven bits look like letters, mixed in.
+  ByteArray randomText(size_t size, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    ByteArray result(size, 0);
+    for (auto& b : result)
+    {
+      const auto r = rng();
+      b = r % 4 ? static_cast<uint8_t>((r & 0x20) | ('A' + (r >> 8) % 26)) : static_cast<uint8_t>(r >> 8);
+    }
+    return result;
+  }
+
+  uint8_t lower(uint8_t b)
+  {
+    return b >= 'A' && b <= 'Z' ? b + 32 : b;
+  }
+
+  uint8_t upper(uint8_t b)
+  {
+    return b >= 'a' && b <= 'z' ? b - 32 : b;
+  }
+
+  ByteArray reference(const ByteArray& a, uint8_t (*convert)(uint8_t))
+  {
+    ByteArray result = a;
+    for (auto& b : result)
+      b = convert(b);
+    return result;
+  }
+
+  ByteArray bytes(const char* s)
+  {
+    return ByteArray::fromStdString(s);
+  }
+
+  int referenceCompare(const ByteArray& a, const ByteArray& b)
+  {
+    return reference(a, lower).compare(reference(b, lower));
+  }
+} // namespace
+
+TEST(AsciiCase, Conversion)
+{
+  // Every byte value, then lengths around each vector width.
+  ByteArray all(256, 0);
+  for (int i = 0; i < 256; i++)
+    all[i] = static_cast<uint8_t>(i);
+  EXPECT_EQ(all.toLower(), reference(all, lower));
+  EXPECT_EQ(all.toUpper(), reference(all, upper));
+
+  for (size_t size = 0; size < 100; size++)
+  {
+    const auto text = randomText(size, static_cast<uint32_t>(size));
+    EXPECT_EQ(text.toLower(), reference(text, lower)) << size;
+    EXPECT_EQ(text.toUpper(), reference(text, upper)) << size;
+    EXPECT_EQ(ByteArray(text).toLower(), reference(text, lower)) << size;
+    EXPECT_EQ(text.toLower().isLower(), true);
+    EXPECT_EQ(text.toUpper().isUpper(), true);
+  }
+  EXPECT_TRUE(ByteArray().isLower());
+  EXPECT_TRUE(ByteArray::fromStdString("123 \xC1\xDA").isUpper());
+  EXPECT_FALSE(ByteArray::fromStdString("abcdefghijklmnopqrstuvwxyz0123456789abcdefX").isLower());
+}
+
+TEST(AsciiCase, ConversionReusesBuffer)
+{
+  // Long enough to live on the heap.
+  auto text = ByteArray::fromStdString(std::string(100, 'a') + "Z");
+  const auto data = text.constData();
+
+  // Nothing to convert: shared, not copied.
+  const auto digits = ByteArray::fromStdString(std::string(100, '7'));
+  EXPECT_TRUE(digits.toLower().isSharedWith(digits));
+  EXPECT_TRUE(digits.toUpper().isSharedWith(digits));
+
+  // An rvalue with a buffer of its own converts in place.
+  auto lowered = std::move(text).toLower();
+  EXPECT_EQ(lowered.constData(), data);
+  EXPECT_EQ(lowered, ByteArray::fromStdString(std::string(100, 'a') + "z"));
+
+  // A shared one must not change its siblings.
+  const auto copy = lowered;
+  const auto upper = std::move(lowered).toUpper();
+  EXPECT_EQ(copy.constData(), data);
+  EXPECT_EQ(copy, ByteArray::fromStdString(std::string(100, 'a') + "z"));
+  EXPECT_EQ(upper, ByteArray::fromStdString(std::string(100, 'A') + "Z"));
+}
+
+TEST(AsciiCase, ConversionKeepsResource)
+{
+  std::pmr::monotonic_buffer_resource arena;
+  const ByteArray bound(ByteArray::fromStdString(std::string(100, 'a') + "Z"), &arena);
+  EXPECT_EQ(bound.toLower().resource(), &arena);
+  EXPECT_EQ(bound.toUpper().resource(), &arena);
+  // Shared, so the rvalue is copied rather than converted in place.
+  EXPECT_EQ(bound.sliced(0).toUpper().resource(), &arena);
+}
+
+TEST(AsciiCase, Compare)
+{
+  const auto a = ByteArray::fromStdString("Hello, World");
+  EXPECT_EQ(a.compare(bytes("hello, world"), CaseSensitivity::CaseInsensitive), 0);
+  EXPECT_EQ(a.compare(bytes("hello, world")), -1);
+  EXPECT_EQ(a.compare(bytes("HELLO"), CaseSensitivity::CaseInsensitive), 1);
+  EXPECT_EQ(a.compare(bytes("hello, worlds"), CaseSensitivity::CaseInsensitive), -1);
+  // '[' sorts after 'Z' but before 'a'; folded it stays before 'z'.
+  EXPECT_EQ(ByteArrayView(bytes("[")).compare(bytes("z"), CaseSensitivity::CaseInsensitive), -1);
+  EXPECT_EQ(ByteArrayView(bytes("[")).compare(bytes("Z"), CaseSensitivity::CaseInsensitive), -1);
+  EXPECT_EQ(ByteArrayView(bytes("\xC1")).compare(bytes("\xE1"), CaseSensitivity::CaseInsensitive), -1);
+
+  std::mt19937 rng(3);
+  for (int round = 0; round < 2000; round++)
+  {
+    const auto text = randomText(rng() % 80, rng());
+    auto other = reference(text, rng() % 2 ? lower : upper);
+    if (!other.isEmpty() && rng() % 2)
+      other[rng() % other.size()] = static_cast<uint8_t>(rng());
+    if (rng() % 4 == 0)
+      other.truncate(rng() % (other.size() + 1));
+    EXPECT_EQ(text.compare(other, CaseSensitivity::CaseInsensitive), referenceCompare(text, other));
+    EXPECT_EQ(text.startsWith(other, CaseSensitivity::CaseInsensitive),
+              text.toLower().startsWith(other.toLower()));
+    EXPECT_EQ(text.endsWith(other, CaseSensitivity::CaseInsensitive), text.toLower().endsWith(other.toLower()));
+  }
+
+  EXPECT_TRUE(a.startsWith(bytes("HELLO"), CaseSensitivity::CaseInsensitive));
+  EXPECT_FALSE(a.startsWith(bytes("HELLO")));
+  EXPECT_TRUE(a.endsWith(bytes("WORLD"), CaseSensitivity::CaseInsensitive));
+  EXPECT_TRUE(a.endsWith(bytes("")));
+  EXPECT_FALSE(ByteArrayView(bytes("ab")).startsWith(bytes("abc"), CaseSensitivity::CaseInsensitive));
+}
+
+TEST(AsciiCase, IndexOf)
+{
+  const auto text = ByteArray::fromStdString("The Quick Brown Fox Jumps Over The Lazy Dog, again and AGAIN");
+  EXPECT_EQ(text.indexOf(bytes("the"), 0, CaseSensitivity::CaseInsensitive), 0u);
+  EXPECT_EQ(text.indexOf(bytes("the"), 1, CaseSensitivity::CaseInsensitive), 31u);
+  EXPECT_EQ(text.indexOf(bytes("again"), 50, CaseSensitivity::CaseInsensitive), 55u);
+  EXPECT_EQ(text.indexOf(bytes("X"), 0, CaseSensitivity::CaseInsensitive), 18u);
+  EXPECT_EQ(text.indexOf(bytes(""), 7, CaseSensitivity::CaseInsensitive), 7u);
+  EXPECT_EQ(text.indexOf(bytes("cat"), 0, CaseSensitivity::CaseInsensitive), ByteArray::kNpos);
+  EXPECT_EQ(text.indexOf(bytes("AGAIN!"), 0, CaseSensitivity::CaseInsensitive), ByteArray::kNpos);
+
+  // Against a search of the lowered copies, over haystacks longer than a
+  // vector and needles sharing first and last bytes with much of it.
+  std::mt19937 rng(4);
+  for (int round = 0; round < 500; round++)
+  {
+    const auto haystack = randomText(rng() % 300, rng());
+    ByteArray needle;
+    if (!haystack.isEmpty() && rng() % 2)
+    {
+      const size_t pos = rng() % haystack.size();
+      needle = reference(haystack.mid(pos, 1 + rng() % 40), rng() % 2 ? lower : upper);
+    }
+    else
+      needle = randomText(1 + rng() % 3, rng());
+    const size_t from = rng() % (haystack.size() + 2);
+    EXPECT_EQ(haystack.indexOf(needle, from, CaseSensitivity::CaseInsensitive),
+              haystack.toLower().indexOf(needle.toLower(), from));
+  }
+}
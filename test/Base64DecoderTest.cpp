@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Boron/Base64Decoder.hpp"
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+
+using Boron::Base64Decoder;
+using Boron::Base64DecodingStatus;
+using Boron::Base64Options;
+using Boron::operator""_sz;
+
+namespace
+{
+  // Feeds the input in the given pieces and returns the decoded bytes.
+  std::string decodeChunks(Base64Decoder& decoder, const std::string& input, const std::vector<size_t>& splits)
+  {
+    std::string result(Base64Decoder::maxDecodedSize(input.size()) + 3, '\0');
+    auto out = reinterpret_cast<uint8_t*>(result.data());
+    size_t from = 0;
+    for (const auto split : splits)
+    {
+      const auto chunk = Boron::ByteArray::fromStdString(input.substr(from, split - from));
+      out += decoder.feed(chunk, out);
+      from = split;
+    }
+    out += decoder.feed(Boron::ByteArray::fromStdString(input.substr(from)), out);
+    out += decoder.finish(out);
+    result.resize(out - reinterpret_cast<uint8_t*>(result.data()));
+    return result;
+  }
+} // namespace
+
+TEST(Base64Decoder, MaxDecodedSize)
+{
+  EXPECT_EQ(Base64Decoder::maxDecodedSize(0), 0);
+  EXPECT_EQ(Base64Decoder::maxDecodedSize(1), 3);
+  EXPECT_EQ(Base64Decoder::maxDecodedSize(4), 3);
+  EXPECT_EQ(Base64Decoder::maxDecodedSize(5), 6);
+}
+
+TEST(Base64Decoder, EverySplitPoint)
+{
+  std::string raw;
+  for (int i = 0; i < 100; i++)
+    raw += static_cast<char>(i * 89 + 3);
+  const auto encoded = Boron::ByteArray::fromStdString(raw).toBase64().toStdString() + "\r\n";
+
+  for (const auto options : {Base64Options::Base64Encoding, Base64Options::AbortOnBase64DecodingErrors})
+  {
+    // Strict decoding rejects the trailing line break.
+    const auto input = options & Base64Options::AbortOnBase64DecodingErrors
+      ? encoded.substr(0, encoded.size() - 2)
+      : encoded;
+    for (auto first = 0_sz; first <= input.size(); first++)
+    {
+      Base64Decoder decoder(options);
+      const auto second = std::min(input.size(), first + 7);
+      EXPECT_EQ(decodeChunks(decoder, input, {first, second}), raw) << first;
+      EXPECT_EQ(decoder.status(), Base64DecodingStatus::Ok);
+      EXPECT_EQ(decoder.position(), input.size());
+    }
+  }
+}
+
+TEST(Base64Decoder, OneCharacterAtATime)
+{
+  const std::string input = "Zm9v\nYmE=";
+  std::vector<size_t> splits;
+  for (auto i = 1_sz; i < input.size(); i++)
+    splits.push_back(i);
+  Base64Decoder decoder;
+  EXPECT_EQ(decodeChunks(decoder, input, splits), "fooba");
+}
+
+TEST(Base64Decoder, ErrorPosition)
+{
+  const std::string input = std::string(40, 'A') + "*AAA";
+  for (auto split = 0_sz; split <= input.size(); split++)
+  {
+    Base64Decoder decoder(Base64Options::AbortOnBase64DecodingErrors);
+    decodeChunks(decoder, input, {split});
+    EXPECT_EQ(decoder.status(), Base64DecodingStatus::IllegalCharacter);
+    EXPECT_EQ(decoder.errorPosition(), 40) << split;
+  }
+
+  Base64Decoder decoder(Base64Options::AbortOnBase64DecodingErrors);
+  decodeChunks(decoder, "QUJDRA", {3});
+  EXPECT_EQ(decoder.status(), Base64DecodingStatus::IllegalPadding);
+  EXPECT_EQ(decoder.errorPosition(), 6);
+
+  decoder.reset();
+  EXPECT_EQ(decoder.status(), Base64DecodingStatus::Ok);
+  EXPECT_EQ(decoder.errorPosition(), Boron::ByteArray::kNpos);
+  EXPECT_EQ(decodeChunks(decoder, "QUJDRA==", {5}), "ABCD");
+  EXPECT_EQ(decoder.status(), Base64DecodingStatus::Ok);
+}
+
+TEST(Base64Decoder, InputAfterErrorIsIgnored)
+{
+  Base64Decoder decoder(Base64Options::AbortOnBase64DecodingErrors);
+  uint8_t out[16];
+  EXPECT_EQ(decoder.feed(Boron::ByteArray::fromStdString("QU!D"), out), 0);
+  EXPECT_EQ(decoder.feed(Boron::ByteArray::fromStdString("QUJD"), out), 0);
+  EXPECT_EQ(decoder.finish(out), 0);
+  EXPECT_EQ(decoder.status(), Base64DecodingStatus::IllegalCharacter);
+  EXPECT_EQ(decoder.errorPosition(), 2);
+  EXPECT_EQ(decoder.position(), 8);
+}
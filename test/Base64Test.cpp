@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "TestHelpers.hpp"
+
+using Boron::operator""_sz;
+using Boron::Test::referenceBase64;
+
+TEST(ByteArray, Base64Rfc4648)
+{
+  const std::pair<std::string, std::string> vectors[] = {
+    {"", ""},
+    {"f", "Zg=="},
+    {"fo", "Zm8="},
+    {"foo", "Zm9v"},
+    {"foob", "Zm9vYg=="},
+    {"fooba", "Zm9vYmE="},
+    {"foobar", "Zm9vYmFy"},
+  };
+  for (const auto& [raw, encoded] : vectors)
+  {
+    const auto ba = Boron::ByteArray::fromStdString(raw);
+    EXPECT_EQ(ba.toBase64().toStdString(), encoded);
+    EXPECT_EQ(ba.base64Size(), encoded.size());
+    const auto strict = Boron::ByteArray::fromBase64Encoding(Boron::ByteArray::fromStdString(encoded),
+                                                             Boron::Base64Options::AbortOnBase64DecodingErrors);
+    EXPECT_TRUE(strict) << encoded;
+    EXPECT_EQ(strict.decoded, ba);
+  }
+  EXPECT_EQ(Boron::ByteArray::fromStdString("fo").toBase64(Boron::Base64Options::OmitTrailingEquals).toStdString(),
+            "Zm8");
+}
+
+TEST(ByteArray, Base64RoundTrip)
+{
+  using Boron::Base64Options;
+  const Base64Options variants[] = {
+    Base64Options::Base64Encoding,
+    Base64Options::Base64UrlEncoding,
+    Base64Options::Base64Encoding | Base64Options::OmitTrailingEquals,
+    Base64Options::Base64UrlEncoding | Base64Options::OmitTrailingEquals,
+  };
+  Boron::ByteArray ba;
+  for (auto size = 0_sz; size <= 1000; size++)
+  {
+    for (const auto options : variants)
+    {
+      const bool url = options & Base64Options::Base64UrlEncoding;
+      const bool pad = !(options & Base64Options::OmitTrailingEquals);
+      const auto encoded = ba.toBase64(options);
+      ASSERT_EQ(encoded.toStdString(), referenceBase64(ba, url, pad)) << size;
+      EXPECT_EQ(ba.base64Size(options), encoded.size());
+      EXPECT_EQ(Boron::ByteArray::fromBase64(encoded, options), ba) << size;
+      const auto strict =
+        Boron::ByteArray::fromBase64Encoding(encoded, options | Base64Options::AbortOnBase64DecodingErrors);
+      ASSERT_TRUE(strict) << size;
+      EXPECT_EQ(strict.decoded, ba);
+    }
+    // Every byte value shows up in the longer inputs.
+    ba.append(static_cast<uint8_t>(size * 151 + 7));
+  }
+}
+
+TEST(ByteArray, Base64WriteToBuffer)
+{
+  const auto ba = Boron::ByteArray::fromStdString("\xfb\xff");
+  char buffer[8];
+  memset(buffer, '#', sizeof(buffer));
+  EXPECT_EQ(ba.writeBase64(buffer), 4);
+  EXPECT_EQ(std::string(buffer, 5), "+/8=#");
+  EXPECT_EQ(ba.writeBase64(buffer, Boron::Base64Options::Base64UrlEncoding | Boron::Base64Options::OmitTrailingEquals),
+            3);
+  EXPECT_EQ(std::string(buffer, 3), "-_8");
+}
+
+TEST(ByteArray, Base64LenientDecoding)
+{
+  const auto decode = [](const std::string& encoded) {
+    return Boron::ByteArray::fromBase64(Boron::ByteArray::fromStdString(encoded)).toStdString();
+  };
+  // Separators are skipped, decoding stops at the padding, and so does a
+  // group cut short.
+  EXPECT_EQ(decode("Zm9v\r\nYmFy"), "foobar");
+  EXPECT_EQ(decode(" Z m 9 v Y m F y "), "foobar");
+  EXPECT_EQ(decode("Zm8=Zm9v"), "fo");
+  EXPECT_EQ(decode("Zm8"), "fo");
+  EXPECT_EQ(decode("Zm9vY"), "foo");
+  EXPECT_EQ(decode("Zm9v-_"), "foo");
+  EXPECT_EQ(decode("===="), "");
+}
+
+TEST(ByteArray, Base64StrictDecoding)
+{
+  using Boron::Base64DecodingStatus;
+  using Boron::Base64Options;
+  const auto decode = [](const std::string& encoded, Base64Options options = Base64Options::Base64Encoding) {
+    return Boron::ByteArray::fromBase64Encoding(Boron::ByteArray::fromStdString(encoded),
+                                                options | Base64Options::AbortOnBase64DecodingErrors);
+  };
+  EXPECT_EQ(decode("Zm9v YmFy").decodingStatus, Base64DecodingStatus::IllegalCharacter);
+  EXPECT_EQ(decode("Zm9v-_").decodingStatus, Base64DecodingStatus::IllegalCharacter);
+  EXPECT_TRUE(decode("Zm9v-_-_", Base64Options::Base64UrlEncoding));
+  EXPECT_EQ(decode("Zm9vY").decodingStatus, Base64DecodingStatus::IllegalInputLength);
+  EXPECT_EQ(decode("Zm8").decodingStatus, Base64DecodingStatus::IllegalPadding);
+  EXPECT_TRUE(decode("Zm8", Base64Options::OmitTrailingEquals));
+  EXPECT_EQ(decode("Zg=").decodingStatus, Base64DecodingStatus::IllegalPadding);
+  EXPECT_EQ(decode("Zm8==").decodingStatus, Base64DecodingStatus::IllegalPadding);
+  EXPECT_EQ(decode("Zm8=Zm9v").decodingStatus, Base64DecodingStatus::IllegalPadding);
+  EXPECT_EQ(decode("Z===").decodingStatus, Base64DecodingStatus::IllegalPadding);
+  EXPECT_EQ(decode("====").decodingStatus, Base64DecodingStatus::IllegalPadding);
+
+  // The first bad character is reported wherever it sits.
+  const auto valid = Boron::ByteArray(96, 'A').toBase64().toStdString();
+  for (auto bad = 0_sz; bad < valid.size(); bad++)
+  {
+    auto encoded = valid;
+    encoded[bad] = '*';
+    const auto result = decode(encoded);
+    ASSERT_FALSE(result) << bad;
+    EXPECT_EQ(result.decodingStatus, Base64DecodingStatus::IllegalCharacter);
+    EXPECT_TRUE(result.decoded.isEmpty());
+  }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#include "Boron/BinaryReader.hpp"
+#include "Boron/BinaryWriter.hpp"
+#include "Boron/ByteArray.hpp"
+
+using Boron::BinaryReader;
+using Boron::BinaryWriter;
+using Boron::ByteArray;
+
+TEST(BinaryReader, ByteOrder)
+{
+  const auto data = ByteArray::fromHex("0102030404030201FFFE");
+  BinaryReader reader(data);
+  EXPECT_EQ(reader.get<uint32_t>(), 0x01020304u);
+  EXPECT_EQ((reader.get<uint32_t, std::endian::little>()), 0x01020304u);
+  EXPECT_EQ(reader.get<int16_t>(), -2);
+  EXPECT_TRUE(reader.ok());
+  EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(BinaryReader, RoundTrip)
+{
+  ByteArray ba;
+  {
+    BinaryWriter writer(ba);
+    writer.write(int8_t(-5), uint16_t(65535), int32_t(std::numeric_limits<int32_t>::min()));
+    writer.write<std::endian::little>(uint64_t(0x0102030405060708), 3.5, -0.25f);
+    writer.putBytes(ByteArray::fromStdString("tail"));
+  }
+
+  BinaryReader reader(ba);
+  int8_t a = 0;
+  uint16_t b = 0;
+  int32_t c = 0;
+  ASSERT_TRUE(reader.read(a, b, c));
+  EXPECT_EQ(a, -5);
+  EXPECT_EQ(b, 65535);
+  EXPECT_EQ(c, std::numeric_limits<int32_t>::min());
+  uint64_t d = 0;
+  double e = 0;
+  float f = 0;
+  ASSERT_TRUE(reader.read<std::endian::little>(d, e, f));
+  EXPECT_EQ(d, 0x0102030405060708u);
+  EXPECT_EQ(e, 3.5);
+  EXPECT_EQ(f, -0.25f);
+  EXPECT_EQ(reader.getBytes(4).toByteArray().toStdString(), "tail");
+  EXPECT_TRUE(reader.atEnd());
+  EXPECT_TRUE(reader.ok());
+}
+
+TEST(BinaryReader, ReadPastEnd)
+{
+  const auto data = ByteArray::fromHex("010203");
+  BinaryReader reader(data);
+  uint16_t first = 0xFFFF;
+  uint16_t second = 0xFFFF;
+  // The batch does not fit, so nothing is read.
+  EXPECT_FALSE(reader.read(first, second));
+  EXPECT_EQ(first, 0xFFFF);
+  EXPECT_EQ(reader.position(), 0);
+  EXPECT_FALSE(reader.ok());
+
+  // Failure is sticky, even for reads that would fit.
+  EXPECT_EQ(reader.get<uint8_t>(), 0);
+  EXPECT_FALSE(reader.skip(1));
+  EXPECT_TRUE(reader.getBytes(1).isNull());
+  EXPECT_EQ(reader.remaining(), 3);
+
+  BinaryReader other(data);
+  EXPECT_TRUE(other.skip(2));
+  EXPECT_EQ(other.get<uint8_t>(), 3);
+  EXPECT_EQ(other.get<uint8_t>(), 0);
+  EXPECT_FALSE(other.ok());
+}
+
+TEST(BinaryReader, Varints)
+{
+  ByteArray ba;
+  {
+    BinaryWriter writer(ba);
+    writer.putVarint(300).putZigZagVarint(-3).put<uint8_t>(9).putVarint(UINT64_MAX);
+    EXPECT_EQ(writer.size(), 14);
+  }
+  EXPECT_EQ(ba.toHex(), "AC020509FFFFFFFFFFFFFFFFFF01");
+
+  BinaryReader reader(ba);
+  EXPECT_EQ(reader.getVarint(), 300u);
+  EXPECT_EQ(reader.getZigZagVarint(), -3);
+  EXPECT_EQ(reader.get<uint8_t>(), 9);
+  EXPECT_EQ(reader.getVarint(), UINT64_MAX);
+  EXPECT_TRUE(reader.atEnd());
+  EXPECT_TRUE(reader.ok());
+
+  const auto truncated = ByteArray::fromHex("01FF");
+  BinaryReader other(truncated);
+  EXPECT_EQ(other.getVarint(), 1u);
+  EXPECT_EQ(other.getVarint(), 0u);
+  EXPECT_FALSE(other.ok());
+  EXPECT_EQ(other.position(), 1);
+}
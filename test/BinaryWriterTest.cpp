@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdint>
+#include <string>
+
+#include "Boron/BinaryWriter.hpp"
+#include "Boron/ByteArray.hpp"
+#include "Boron/Endian.hpp"
+
+using Boron::BinaryWriter;
+using Boron::ByteArray;
+
+namespace
+{
+  std::string hex(const ByteArray& ba)
+  {
+    return ba.toHex();
+  }
+} // namespace
+
+TEST(BinaryWriter, ByteOrder)
+{
+  ByteArray ba;
+  {
+    BinaryWriter writer(ba);
+    writer.put<uint32_t>(0x01020304);
+    writer.put<uint32_t, std::endian::little>(0x01020304);
+    writer.put<int16_t>(-2);
+    writer.put<uint8_t>(0xAB);
+    EXPECT_EQ(writer.size(), 11);
+  }
+  EXPECT_EQ(hex(ba), "0102030404030201FFFEAB");
+
+  ba.clear();
+  {
+    BinaryWriter writer(ba);
+    writer.put(1.0).put<float, std::endian::little>(-2.0f);
+  }
+  EXPECT_EQ(hex(ba), "3FF0000000000000000000C0");
+}
+
+TEST(BinaryWriter, WriteBatch)
+{
+  ByteArray ba;
+  {
+    BinaryWriter writer(ba);
+    writer.write(uint16_t(0x0102), int64_t(-1), uint8_t(7));
+    writer.write<std::endian::little>(uint16_t(0x0102), uint32_t(0x0A0B0C0D));
+  }
+  EXPECT_EQ(hex(ba), "0102FFFFFFFFFFFFFFFF0702010D0C0B0A");
+}
+
+TEST(BinaryWriter, AppendsToExistingContents)
+{
+  auto ba = ByteArray::fromStdString("hdr:");
+  const auto copy = ba;
+  {
+    BinaryWriter writer(ba);
+    writer.putBytes(ByteArray::fromStdString("xy")).put<uint16_t>(0x4142).putBytes({});
+    EXPECT_EQ(writer.size(), 8);
+    writer.flush();
+    EXPECT_EQ(ba.toStdString(), "hdr:xyAB");
+    writer.put<uint8_t>('!');
+  }
+  EXPECT_EQ(ba.toStdString(), "hdr:xyAB!");
+  EXPECT_EQ(copy.toStdString(), "hdr:");
+}
+
+TEST(BinaryWriter, GrowsGeometrically)
+{
+  ByteArray ba;
+  size_t reallocations = 0;
+  const uint8_t* data = nullptr;
+  {
+    BinaryWriter writer(ba);
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+      writer.put(i);
+      if (ba.constData() != data)
+      {
+        data = ba.constData();
+        reallocations++;
+      }
+    }
+  }
+  EXPECT_EQ(ba.size(), 400000);
+  EXPECT_LT(reallocations, 40);
+  EXPECT_EQ(ba.mid(4 * 12345, 4).toHex(), "00003039");
+}
+
+TEST(BinaryWriter, SetNumWithEndian)
+{
+  ByteArray ba;
+  EXPECT_EQ(ba.setNum(uint16_t(0x1234), std::endian::big).toHex(), "1234");
+  EXPECT_EQ(ba.setNum(uint16_t(0x1234), std::endian::little).toHex(), "3412");
+  EXPECT_EQ(ba.setNum(int32_t(-2), std::endian::big).toHex(), "FFFFFFFE");
+  EXPECT_EQ(ByteArray::number(uint64_t(1), std::endian::big).toHex(), "0000000000000001");
+  EXPECT_EQ(ByteArray::number(int8_t(-1), std::endian::little).toHex(), "FF");
+
+  static_assert(Boron::byteSwap(uint32_t(0x01020304)) == 0x04030201);
+  static_assert(Boron::byteSwap(uint16_t(0xABCD)) == 0xCDAB);
+  EXPECT_EQ(Boron::byteSwap(uint64_t(0x0102030405060708)), 0x0807060504030201u);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/ByteArrayMatcher.hpp"
+
+using Boron::ByteArrayMatcher;
+
+namespace
+{
+  Boron::ByteArray fromString(const std::string& s)
+  {
+    return Boron::ByteArray::fromStdString(s);
+  }
+
+  size_t naiveIndexOf(const std::string& haystack, const std::string& needle, size_t from = 0)
+  {
+    const auto pos = haystack.find(needle, from);
+    return pos == std::string::npos ? Boron::ByteArray::kNpos : pos;
+  }
+
+  constexpr ByteArrayMatcher::Strategy kAllStrategies[] = {
+    ByteArrayMatcher::Strategy::Simd,
+    ByteArrayMatcher::Strategy::TwoWay,
+    ByteArrayMatcher::Strategy::Horspool,
+  };
+} // namespace
+
+TEST(ByteArrayMatcher, DefaultStrategy)
+{
+  EXPECT_EQ(ByteArrayMatcher(fromString("GET")).strategy(), ByteArrayMatcher::Strategy::Simd);
+  EXPECT_EQ(ByteArrayMatcher(fromString("aaaaaaaab")).strategy(), ByteArrayMatcher::Strategy::TwoWay);
+  EXPECT_EQ(ByteArrayMatcher(fromString(std::string(100, 'x') + "0123456789")).strategy(),
+            ByteArrayMatcher::Strategy::Horspool);
+}
+
+TEST(ByteArrayMatcher, IndexIn)
+{
+  const std::string haystack = "the quick brown fox jumps over the lazy dog";
+  for (auto strategy : kAllStrategies)
+  {
+    for (const std::string needle : {"the", "fox", "dog", "lazy dog", "cat", "", "t", "the quick brown fox"})
+    {
+      const ByteArrayMatcher matcher(fromString(needle), strategy);
+      EXPECT_EQ(matcher.indexIn(fromString(haystack)), naiveIndexOf(haystack, needle)) << needle;
+      EXPECT_EQ(matcher.indexIn(fromString(haystack), 5), naiveIndexOf(haystack, needle, 5)) << needle;
+    }
+  }
+}
+
+TEST(ByteArrayMatcher, PeriodicPatterns)
+{
+  // Small alphabets exercise the periodic branch of Two-Way and short Horspool shifts.
+  std::string haystack;
+  for (auto i = 0; i < 2000; i++)
+    haystack.push_back("ab"[(i * i + i / 7) % 3 == 0]);
+  for (auto strategy : kAllStrategies)
+  {
+    for (const std::string needle : {"abab", "aaab", "babba", "abaababaab", "bbbbbbbb", "aabbaabbaabbaabbaabbaabbaabb"})
+    {
+      const ByteArrayMatcher matcher(fromString(needle), strategy);
+      for (auto from : {0, 1, 17, 999, 1990})
+      {
+        EXPECT_EQ(matcher.indexIn(fromString(haystack), from), naiveIndexOf(haystack, needle, from))
+          << needle << " from " << from;
+      }
+    }
+  }
+}
+
+TEST(ByteArrayMatcher, CountIn)
+{
+  const auto haystack = fromString("aaaa-aa-aaa");
+  for (auto strategy : kAllStrategies)
+  {
+    const ByteArrayMatcher matcher(fromString("aa"), strategy);
+    EXPECT_EQ(matcher.countIn(haystack), haystack.count(fromString("aa")));
+    EXPECT_EQ(matcher.countIn(haystack), 4);
+  }
+  EXPECT_EQ(ByteArrayMatcher(fromString("")).countIn(haystack), haystack.size() + 1);
+}
+
+TEST(ByteArrayMatcher, ForEachMatch)
+{
+  const auto haystack = fromString("x--x--x--x");
+  const ByteArrayMatcher matcher(fromString("x"));
+  std::vector<size_t> positions;
+  matcher.forEachMatch(haystack, [&positions](size_t pos) { positions.push_back(pos); });
+  EXPECT_EQ(positions, (std::vector<size_t>{0, 3, 6, 9}));
+
+  positions.clear();
+  matcher.forEachMatch(haystack, [&positions](size_t pos)
+  {
+    positions.push_back(pos);
+    return positions.size() < 2;
+  });
+  EXPECT_EQ(positions, (std::vector<size_t>{0, 3}));
+}
@@ -3,6 +3,16 @@
 #include "Boron/ByteArray.hpp"
 #include "Boron/Common.hpp"
 
+#include <array>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Boron::operator""_sz;
+
 TEST(ByteArrayView, DefaultConstructor)
 {
   const Boron::ByteArrayView view;
@@ -87,7 +97,7 @@ TEST(ByteArray, Constructor)
   auto ba = Boron::ByteArray(4, 0x01);
   EXPECT_EQ(ba.size(), 4);
   EXPECT_EQ(ba[2], 0x01);
-  EXPECT_DEATH(auto _ = ba.at(4), ".*");
+  EXPECT_DEATH([[maybe_unused]] auto _ = ba.at(4), ".*");
 }
 
 TEST(ByteArray, ConstructorFromPointer)
@@ -148,12 +158,48 @@ TEST(ByteArray, Resize)
   ba.resize(3);
   EXPECT_EQ(ba.size(), 3);
   EXPECT_EQ(ba[2], 0x01);
-  EXPECT_DEATH(auto _ = ba.at(3), ".*");
+  EXPECT_DEATH([[maybe_unused]] auto _ = ba.at(3), ".*");
   ba.resize(5, 0x02);
   EXPECT_EQ(ba.size(), 5);
   EXPECT_EQ(ba[4], 0x02);
 }
 
+TEST(ByteArray, ResizeForOverwrite)
+{
+  auto ba = Boron::ByteArray(4, 0x01);
+  ba.resizeForOverwrite(100);
+  EXPECT_EQ(ba.size(), 100);
+  EXPECT_EQ(ba[3], 0x01);
+  ba.resizeForOverwrite(2);
+  EXPECT_EQ(ba.size(), 2);
+
+  // Growing a shared array detaches it and keeps the other owner intact.
+  const auto shared = Boron::ByteArray(40, 'x');
+  auto copy = shared;
+  copy.resizeForOverwrite(41);
+  EXPECT_FALSE(copy.isSharedWith(shared));
+  EXPECT_EQ(copy[39], 'x');
+  EXPECT_EQ(shared.size(), 40);
+}
+
+TEST(ByteArray, ResizeAndOverwrite)
+{
+  Boron::ByteArray ba;
+  ba.resize_and_overwrite(64, [](uint8_t* out, size_t n) {
+    EXPECT_EQ(n, 64);
+    for (auto i = 0_sz; i < 10; i++)
+      out[i] = static_cast<uint8_t>('0' + i);
+    return 10;
+  });
+  EXPECT_EQ(ba.toStdString(), "0123456789");
+
+  ba.resize_and_overwrite(ba.size() + 3, [](uint8_t* out, size_t n) {
+    memcpy(out + n - 3, "abc", 3);
+    return n;
+  });
+  EXPECT_EQ(ba.toStdString(), "0123456789abc");
+}
+
 TEST(ByteArray, Fill)
 {
   auto ba = Boron::ByteArray(4, 0x01);
@@ -167,14 +213,119 @@ TEST(ByteArray, Fill)
 
 TEST(ByteArray, Capacity)
 {
+  // Short payloads are stored inline.
   auto ba = Boron::ByteArray(4, 0x01);
-  EXPECT_EQ(ba.capacity(), 4);
+  EXPECT_EQ(ba.capacity(), Boron::ByteArray::kInlineCapacity);
   ba.resize(6);
   EXPECT_GE(ba.capacity(), 6);
-  ba.reserve(10);
-  EXPECT_EQ(ba.capacity(), 10);
+  const auto large = Boron::ByteArray::kInlineCapacity + 10;
+  ba.reserve(large);
+  EXPECT_EQ(ba.capacity(), large);
+  EXPECT_EQ(ba.size(), 6);
+  EXPECT_EQ(ba[5], 0x00);
+  ba.squeeze();
+  EXPECT_EQ(ba.capacity(), Boron::ByteArray::kInlineCapacity);
+  EXPECT_EQ(ba[3], 0x01);
+  ba.resize(large + 1, 0x02);
+  ba.reserve(2 * large);
   ba.squeeze();
-  EXPECT_EQ(ba.capacity(), 6);
+  EXPECT_EQ(ba.capacity(), large + 1);
+  EXPECT_EQ(ba[large], 0x02);
+}
+
+TEST(ByteArray, InlineStorage)
+{
+  static_assert(sizeof(Boron::ByteArray) == 3 * sizeof(void*));
+  const std::string text = "0123456789abcdefghijklmnopqrstuvwxyz";
+  for (auto length = 0_sz; length <= text.size(); length++)
+  {
+    // Grows across the inline/heap boundary byte by byte.
+    Boron::ByteArray ba;
+    for (auto i = 0_sz; i < length; i++)
+      ba.append(static_cast<uint8_t>(text[i]));
+    EXPECT_EQ(ba.toStdString(), text.substr(0, length));
+    auto copy = ba;
+    auto moved = std::move(ba);
+    EXPECT_EQ(copy, moved);
+    EXPECT_TRUE(ba.isEmpty());
+    copy.insert(0, copy);
+    EXPECT_EQ(copy.toStdString(), text.substr(0, length) + text.substr(0, length));
+    copy.remove(0, length);
+    EXPECT_EQ(copy, moved);
+  }
+}
+
+TEST(ByteArray, ImplicitSharing)
+{
+  const auto original = Boron::ByteArray(100, 'x');
+  auto copy = original;
+  EXPECT_TRUE(copy.isSharedWith(original));
+  EXPECT_FALSE(copy.isDetached());
+  EXPECT_EQ(copy.constData(), original.constData());
+
+  // Writing detaches the writer only.
+  copy[0] = 'y';
+  EXPECT_FALSE(copy.isSharedWith(original));
+  EXPECT_TRUE(copy.isDetached());
+  EXPECT_TRUE(original.isDetached());
+  EXPECT_EQ(original[0], 'x');
+  EXPECT_EQ(copy[0], 'y');
+
+  // Appending to a shared array must not write into the shared buffer.
+  auto appended = original;
+  appended.append('z');
+  EXPECT_EQ(original.size(), 100);
+  EXPECT_EQ(appended.size(), 101);
+  EXPECT_EQ(appended.back(), 'z');
+
+  auto truncated = original;
+  truncated.resize(10);
+  EXPECT_TRUE(truncated.isSharedWith(original));
+  truncated.clear();
+  EXPECT_TRUE(original.isDetached());
+  EXPECT_EQ(original, Boron::ByteArray(100, 'x'));
+}
+
+TEST(ByteArray, SharedSlices)
+{
+  std::string text;
+  for (auto i = 0; i < 64; i++)
+    text += static_cast<char>('a' + i % 26);
+  const auto ba = Boron::ByteArray::fromStdString(text);
+
+  auto slice = ba.sliced(8, 40);
+  EXPECT_TRUE(slice.isSharedWith(ba));
+  EXPECT_EQ(slice.constData(), ba.constData() + 8);
+  EXPECT_EQ(slice.toStdString(), text.substr(8, 40));
+
+  // Short slices are copied inline instead of pinning the buffer.
+  const auto small = ba.sliced(8, Boron::ByteArray::kInlineCapacity);
+  EXPECT_FALSE(small.isSharedWith(ba));
+  EXPECT_EQ(small.toStdString(), text.substr(8, Boron::ByteArray::kInlineCapacity));
+
+  slice.insert(0, ba.first(4));
+  EXPECT_FALSE(slice.isSharedWith(ba));
+  EXPECT_EQ(slice.toStdString(), text.substr(0, 4) + text.substr(8, 40));
+  EXPECT_EQ(ba.toStdString(), text);
+
+  // An rvalue slice keeps its buffer, dropping a prefix does not move bytes.
+  auto owned = ba;
+  owned.detach();
+  const auto payload = owned.constData();
+  const auto tail = std::move(owned).sliced(30);
+  EXPECT_EQ(tail.constData(), payload + 30);
+  EXPECT_EQ(tail.toStdString(), text.substr(30));
+}
+
+TEST(ByteArray, Mid)
+{
+  const auto ba = Boron::ByteArray::fromStdString("Hello, World!");
+  EXPECT_EQ(ba.mid(7).toStdString(), "World!");
+  EXPECT_EQ(ba.mid(7, 5).toStdString(), "World");
+  EXPECT_EQ(ba.mid(7, 100).toStdString(), "World!");
+  EXPECT_TRUE(ba.mid(13).isEmpty());
+  EXPECT_TRUE(ba.mid(100, 2).isEmpty());
+  EXPECT_EQ(Boron::ByteArray(ba).mid(0, 5).toStdString(), "Hello");
 }
 
 TEST(ByteArray, IndexOf)
@@ -189,6 +340,76 @@ TEST(ByteArray, IndexOf)
   EXPECT_EQ(ba.indexOf(needle2), 1);
 }
 
+TEST(ByteArray, IndexOfLongHaystack)
+{
+  // Long enough to cover the vectorized blocks as well as their scalar tails.
+  std::vector<Boron::byte> data(1000);
+  for (auto i = 0_sz; i < data.size(); i++)
+    data[i] = static_cast<Boron::byte>('a' + (i * 7 + i / 13) % 5);
+  const auto ba = Boron::ByteArray(data.data(), data.size());
+  for (auto needle_size : {2_sz, 3_sz, 7_sz, 16_sz, 33_sz, 65_sz})
+  {
+    for (auto pos : {0_sz, 1_sz, 15_sz, 63_sz, 500_sz, 1000 - needle_size})
+    {
+      const auto needle = ba.sliced(pos, needle_size);
+      const auto expected = std::search(data.begin(), data.end(), needle.begin(), needle.end()) - data.begin();
+      EXPECT_EQ(ba.indexOf(needle), expected);
+      const auto expected_from = std::search(data.begin() + pos, data.end(), needle.begin(), needle.end());
+      EXPECT_EQ(ba.indexOf(needle, pos), expected_from - data.begin());
+    }
+  }
+  constexpr const Boron::byte missing[] = {'a', 'b', 'z'};
+  EXPECT_EQ(ba.indexOf(Boron::ByteArrayView(missing, sizeof(missing))), -1);
+  EXPECT_EQ(ba.indexOf(ba.sliced(0, 10), 995), -1);
+}
+
+TEST(ByteArray, IndexOfByteLongHaystack)
+{
+  std::vector<Boron::byte> data(300, 0x01);
+  const auto ba = Boron::ByteArray(data.data(), data.size());
+  EXPECT_EQ(ba.indexOf(0x02), -1);
+  for (auto pos : {0_sz, 15_sz, 16_sz, 31_sz, 64_sz, 130_sz, 299_sz})
+  {
+    auto copy = ba;
+    copy[pos] = 0x02;
+    EXPECT_EQ(copy.indexOf(0x02), pos);
+    EXPECT_EQ(copy.indexOf(0x02, pos), pos);
+    EXPECT_EQ(copy.indexOf(0x02, pos + 1), -1);
+    EXPECT_EQ(copy.lastIndexOf(0x02), pos);
+    EXPECT_EQ(copy.lastIndexOf(0x02, pos), pos);
+    EXPECT_EQ(copy.lastIndexOf(0x02, pos - 1), pos == 0 ? pos : -1);
+  }
+}
+
+TEST(ByteArray, LastIndexOf)
+{
+  constexpr const Boron::byte data[] = {0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x04};
+  auto ba = Boron::ByteArray(data, sizeof(data));
+  EXPECT_EQ(ba.lastIndexOf(0x02), 4);
+  EXPECT_EQ(ba.lastIndexOf(0x02, 3), 1);
+  EXPECT_EQ(ba.lastIndexOf(0x02, 0), -1);
+  EXPECT_EQ(ba.lastIndexOf(0x05), -1);
+  auto needle = Boron::ByteArray(data, 3);
+  EXPECT_EQ(ba.lastIndexOf(needle), 3);
+  EXPECT_EQ(ba.lastIndexOf(needle, 2), 0);
+  EXPECT_EQ(ba.lastIndexOf(needle, 100), 3);
+  EXPECT_EQ(ba.lastIndexOf(Boron::ByteArray(data + 4, 3)), 4);
+  EXPECT_EQ(ba.lastIndexOf(Boron::ByteArray(data + 4, 3), 3), -1);
+  EXPECT_EQ(ba.lastIndexOf(Boron::ByteArrayView()), 7);
+  EXPECT_EQ(ba.lastIndexOf(Boron::ByteArray(8, 0x01)), -1);
+
+  std::vector<Boron::byte> long_data(1000);
+  for (auto i = 0_sz; i < long_data.size(); i++)
+    long_data[i] = static_cast<Boron::byte>('a' + (i * 7 + i / 13) % 5);
+  const auto long_ba = Boron::ByteArray(long_data.data(), long_data.size());
+  for (auto pos : {0_sz, 1_sz, 63_sz, 500_sz, 990_sz})
+  {
+    const auto long_needle = long_ba.sliced(pos, 10);
+    const auto expected = std::find_end(long_data.begin(), long_data.end(), long_needle.begin(), long_needle.end());
+    EXPECT_EQ(long_ba.lastIndexOf(long_needle), expected - long_data.begin());
+  }
+}
+
 TEST(ByteArray, Contains)
 {
   constexpr const Boron::byte data[] = {0x01, 0x02, 0x03, 0x04};
@@ -210,6 +431,13 @@ TEST(ByteArray, Count)
   EXPECT_EQ(ba.count(needle), 1);
   auto needle2 = Boron::ByteArray(data + 1, 2);
   EXPECT_EQ(ba.count(needle2), 2);
+
+  std::vector<Boron::byte> long_data(1000);
+  for (auto i = 0_sz; i < long_data.size(); i++)
+    long_data[i] = static_cast<Boron::byte>(i % 7 == 0 || i % 11 == 0 ? '\n' : 'x');
+  const auto long_ba = Boron::ByteArray(long_data.data(), long_data.size());
+  EXPECT_EQ(long_ba.count('\n'), std::count(long_data.begin(), long_data.end(), '\n'));
+  EXPECT_EQ(long_ba.count('y'), 0);
 }
 
 TEST(ByteArray, Compare)
@@ -267,6 +495,175 @@ TEST(ByteArray, Trimmed)
   EXPECT_EQ(ba.size(), 0);
 }
 
+TEST(ByteArray, TrimmedInPlace)
+{
+  // Long enough to live on the heap.
+  const auto text = std::string(40, ' ') + "\t" + std::string(60, 'x') + " \r\n";
+  auto ba = Boron::ByteArray::fromStdString(text);
+  const auto data = ba.constData();
+
+  const auto copy = ba.trimmed();
+  EXPECT_EQ(copy, Boron::ByteArray::fromStdString(std::string(60, 'x')));
+  EXPECT_TRUE(copy.isSharedWith(ba));
+
+  const auto view = Boron::ByteArrayView(ba).trimmed();
+  EXPECT_EQ(view.data(), data + 41);
+  EXPECT_EQ(view.size(), 60u);
+
+  const auto moved = std::move(ba).trimmed();
+  EXPECT_EQ(moved.constData(), data + 41);
+  EXPECT_EQ(moved.size(), 60u);
+
+  // Locale-independent, and nothing above 0x7F is whitespace.
+  EXPECT_EQ(Boron::ByteArray::fromStdString("\xA0 a\x85\v").trimmed(), Boron::ByteArray::fromStdString("\xA0 a\x85"));
+  EXPECT_TRUE(Boron::ByteArray::fromStdString(" \f\n ").trimmed().isEmpty());
+  EXPECT_TRUE(Boron::ByteArrayView().trimmed().empty());
+}
+
+TEST(ByteArray, Simplified)
+{
+  EXPECT_EQ(Boron::ByteArray::fromStdString("  lots\t of\nwhitespace\r\n ").simplified(),
+            Boron::ByteArray::fromStdString("lots of whitespace"));
+  EXPECT_TRUE(Boron::ByteArray::fromStdString(" \t ").simplified().isEmpty());
+  EXPECT_TRUE(Boron::ByteArray().simplified().isEmpty());
+
+  // Against a reference, over runs that cross the 64-byte blocks.
+  std::mt19937 rng(9);
+  const char alphabet[] = {'a', 'b', ' ', ' ', '\t', '\n', '\0', '\xA0'};
+  for (int round = 0; round < 300; round++)
+  {
+    std::string text(rng() % 300, 'a');
+    for (auto& c : text)
+      c = rng() % 4 ? alphabet[rng() % 2] : alphabet[rng() % sizeof(alphabet)];
+    std::string expected;
+    bool owed = false;
+    for (const auto c : text)
+    {
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\0')
+      {
+        owed = true;
+        continue;
+      }
+      if (owed && !expected.empty())
+        expected += ' ';
+      owed = false;
+      expected += c;
+    }
+    const auto ba = Boron::ByteArray::fromStdString(text);
+    EXPECT_EQ(ba.simplified().toStdString(), expected);
+
+    // The rvalue rewrites its own buffer, and leaves a shared one alone.
+    auto own = ba;
+    own.detach();
+    const auto data = own.constData();
+    const auto simplified = std::move(own).simplified();
+    EXPECT_EQ(simplified.toStdString(), expected);
+    if (ba.size() > Boron::ByteArray::kInlineCapacity)
+    {
+      EXPECT_EQ(simplified.constData(), data);
+    }
+    auto shared = ba;
+    EXPECT_EQ(std::move(shared).simplified().toStdString(), expected);
+    EXPECT_EQ(ba.toStdString(), text);
+  }
+}
+
+TEST(ByteArray, Justified)
+{
+  const auto ba = Boron::ByteArray::fromStdString("abc");
+  EXPECT_EQ(ba.leftJustified(6).toStdString(), "abc   ");
+  EXPECT_EQ(ba.rightJustified(6, '0').toStdString(), "000abc");
+  EXPECT_EQ(ba.leftJustified(2).toStdString(), "abc");
+  EXPECT_EQ(ba.leftJustified(2, ' ', true).toStdString(), "ab");
+  EXPECT_EQ(ba.rightJustified(2, ' ', true).toStdString(), "ab");
+  EXPECT_EQ(ba.rightJustified(3).toStdString(), "abc");
+  EXPECT_EQ(Boron::ByteArray().rightJustified(2, '*').toStdString(), "**");
+}
+
+TEST(ByteArray, ReplaceAll)
+{
+  const auto bytes = [](const char* s) { return Boron::ByteArray::fromStdString(s); };
+  auto ba = bytes("Hello {{name}}, bye {{name}}");
+  ba.replace(bytes("{{name}}"), bytes("Bo"));
+  EXPECT_EQ(ba.toStdString(), "Hello Bo, bye Bo");
+  ba.replace(bytes("Bo"), bytes("Boron"));
+  EXPECT_EQ(ba.toStdString(), "Hello Boron, bye Boron");
+  ba.replace(bytes("missing"), bytes("x"));
+  EXPECT_EQ(ba.toStdString(), "Hello Boron, bye Boron");
+  ba.replace(bytes(""), bytes("x"));
+  EXPECT_EQ(ba.toStdString(), "Hello Boron, bye Boron");
+  ba.replace('o', bytes(""));
+  EXPECT_EQ(ba.toStdString(), "Hell Brn, bye Brn");
+
+  // Left to right, without overlaps.
+  auto as = bytes("aaaaa");
+  as.replace(bytes("aa"), bytes("b"));
+  EXPECT_EQ(as.toStdString(), "bba");
+
+  // Patterns taken from the array itself.
+  auto self = bytes("abcabcab");
+  self.replace(Boron::ByteArrayView(self).sliced(0, 2), Boron::ByteArrayView(self).sliced(2, 3));
+  EXPECT_EQ(self.toStdString(), "cabccabccab");
+
+  // Against a reference, shrinking, growing, in place and on shared buffers.
+  std::mt19937 rng(10);
+  for (int round = 0; round < 500; round++)
+  {
+    std::string text(rng() % 200, 'a');
+    for (auto& c : text)
+      c = static_cast<char>('a' + rng() % 3);
+    const std::string before(1 + rng() % 3, static_cast<char>('a' + rng() % 3));
+    const std::string after(rng() % 5, 'x');
+    std::string expected;
+    for (size_t pos = 0;;)
+    {
+      const auto next = text.find(before, pos);
+      expected += text.substr(pos, next - pos);
+      if (next == std::string::npos)
+        break;
+      expected += after;
+      pos = next + before.size();
+    }
+    auto ba = Boron::ByteArray::fromStdString(text);
+    const auto shared = rng() % 2 ? ba : Boron::ByteArray();
+    ba.replace(Boron::ByteArray::fromStdString(before), Boron::ByteArray::fromStdString(after));
+    EXPECT_EQ(ba.toStdString(), expected);
+    if (!shared.isEmpty())
+    {
+      EXPECT_EQ(shared.toStdString(), text);
+    }
+  }
+}
+
+TEST(ByteArray, ReplaceByteAndTranslate)
+{
+  std::mt19937 rng(11);
+  std::array<uint8_t, 256> table{};
+  for (auto& entry : table)
+    entry = static_cast<uint8_t>(rng());
+  for (size_t size = 0; size < 100; size++)
+  {
+    Boron::ByteArray ba(size, 0);
+    for (auto& b : ba)
+      b = static_cast<uint8_t>(rng() % 4 ? rng() % 3 : rng());
+    auto replaced = ba;
+    replaced.replace(uint8_t(1), uint8_t(0xFF));
+    auto translated = ba;
+    translated.translate(table);
+    for (size_t i = 0; i < size; i++)
+    {
+      EXPECT_EQ(replaced[i], ba[i] == 1 ? 0xFF : ba[i]);
+      EXPECT_EQ(translated[i], table[ba[i]]);
+    }
+  }
+
+  // Nothing to replace leaves a shared buffer alone.
+  const auto original = Boron::ByteArray(100, 'x');
+  auto copy = original;
+  copy.replace(uint8_t('y'), uint8_t('z'));
+  EXPECT_TRUE(copy.isSharedWith(original));
+}
+
 TEST(ByteArray, Prepend)
 {
   constexpr const Boron::byte data1[] = {0x01, 0x02, 0x03};
@@ -330,6 +727,65 @@ TEST(ByteArray, Split)
   EXPECT_EQ(split[2].size(), 1);
 }
 
+TEST(ByteArray, SplitView)
+{
+  constexpr const Boron::byte data[] = {0x01, 0x02, 0x00, 0x01, 0x02, 0x03, 0x00, 0x00, 0x00, 0x01};
+  auto ba = Boron::ByteArray(data, sizeof(data));
+  auto views = ba.splitView(0x00);
+  ASSERT_EQ(views.size(), 3);
+  EXPECT_EQ(views[0].data(), ba.data());
+  EXPECT_EQ(views[1].data(), ba.data() + 3);
+  EXPECT_EQ(views[1].size(), 3);
+  EXPECT_EQ(views[2].data(), ba.data() + 9);
+  auto all = ba.splitView(0x00, Boron::SplitBehavior::KeepEmptyParts);
+  ASSERT_EQ(all.size(), 5);
+  EXPECT_TRUE(all[2].empty());
+  EXPECT_TRUE(all[3].empty());
+  EXPECT_EQ(all[4].size(), 1);
+}
+
+TEST(ByteArray, SplitRange)
+{
+  static_assert(std::ranges::forward_range<Boron::ByteArraySplitRange>);
+  const auto csv = Boron::ByteArray::fromStdString("a,,bc,");
+  std::vector<std::string> fields;
+  for (auto field : Boron::ByteArrayView(csv).splitRange(',', Boron::SplitBehavior::KeepEmptyParts))
+    fields.push_back(field.toByteArray().toStdString());
+  EXPECT_EQ(fields, (std::vector<std::string>{"a", "", "bc", ""}));
+  fields.clear();
+  for (auto field : csv.splitRange(','))
+    fields.push_back(field.toByteArray().toStdString());
+  EXPECT_EQ(fields, (std::vector<std::string>{"a", "bc"}));
+  EXPECT_EQ(std::ranges::distance(Boron::ByteArrayView().splitRange(',')), 0);
+  EXPECT_EQ(std::ranges::distance(Boron::ByteArrayView().splitRange(',', Boron::SplitBehavior::KeepEmptyParts)), 1);
+}
+
+TEST(ByteArray, SplitIteratorOutlivesRange)
+{
+  const auto csv = Boron::ByteArray::fromStdString("a,bc");
+  auto it = csv.splitRange(',').begin();
+  EXPECT_EQ((*it).toByteArray().toStdString(), "a");
+  ++it;
+  EXPECT_EQ((*it).toByteArray().toStdString(), "bc");
+  ++it;
+  EXPECT_TRUE(it == std::default_sentinel);
+}
+
+TEST(ByteArray, SplitMultiByteSeparator)
+{
+  const auto text = Boron::ByteArray::fromStdString("key: value\r\n\r\nnext: line\r\nlast");
+  const auto crlf = Boron::ByteArray::fromStdString("\r\n");
+  const auto parts = text.split(crlf);
+  ASSERT_EQ(parts.size(), 3);
+  EXPECT_EQ(parts[0].toStdString(), "key: value");
+  EXPECT_EQ(parts[1].toStdString(), "next: line");
+  EXPECT_EQ(parts[2].toStdString(), "last");
+  EXPECT_EQ(text.splitView(crlf, Boron::SplitBehavior::KeepEmptyParts).size(), 4);
+  const auto whole = text.splitView(Boron::ByteArrayView());
+  ASSERT_EQ(whole.size(), 1);
+  EXPECT_EQ(whole[0].size(), text.size());
+}
+
 TEST(ByteArray, Repeated)
 {
   constexpr const Boron::byte data[] = {0x01, 0x02, 0x03};
@@ -337,6 +793,12 @@ TEST(ByteArray, Repeated)
   auto repeated = ba.repeated(3);
   EXPECT_EQ(repeated.size(), 9);
   EXPECT_EQ(repeated[8], 0x03);
+  EXPECT_TRUE(ba.repeated(0).isEmpty());
+  EXPECT_TRUE(Boron::ByteArray().repeated(5).isEmpty());
+  const auto many = ba.repeated(1001);
+  ASSERT_EQ(many.size(), 3003);
+  for (auto i = 0_sz; i < many.size(); i++)
+    ASSERT_EQ(many[i], data[i % 3]);
 }
 
 TEST(ByteArray, StdString)
@@ -360,6 +822,156 @@ TEST(ByteArray, HexEncodeAndDecode)
   EXPECT_EQ(raw_ba, raw_ba2);
   auto hex2 = ba2.toHex(':');
   EXPECT_EQ(hex2, "59:6F:69:6D:69:79:61:21");
-  auto death = "96F696D69796121";
-  EXPECT_DEATH(ba = Boron::ByteArray::fromHex(death), ".*");
+  EXPECT_EQ(Boron::ByteArray::fromHex("96F696D69796121"), Boron::ByteArray());
+}
+
+TEST(ByteArray, HexLongInputs)
+{
+  // Sizes around the vector widths exercise every kernel and its tail.
+  for (auto size : {0_sz, 1_sz, 15_sz, 16_sz, 17_sz, 31_sz, 32_sz, 33_sz, 63_sz, 64_sz, 100_sz, 1000_sz})
+  {
+    Boron::ByteArray ba;
+    std::string expected;
+    for (auto i = 0_sz; i < size; i++)
+    {
+      const auto c = static_cast<uint8_t>(i * 37 + 11);
+      ba.append(c);
+      expected += "0123456789ABCDEF"[c >> 4];
+      expected += "0123456789ABCDEF"[c & 0x0F];
+    }
+    const auto hex = ba.toHex();
+    EXPECT_EQ(hex, expected);
+    EXPECT_EQ(ba.hexSize(), hex.size());
+    EXPECT_EQ(Boron::ByteArray::fromHex(hex), ba);
+
+    std::string lower = hex;
+    for (auto& c : lower)
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    EXPECT_EQ(Boron::ByteArray::fromHex(lower), ba);
+  }
+}
+
+TEST(ByteArray, HexWriteToBuffer)
+{
+  const auto ba = Boron::ByteArray::fromStdString("\x01\xAB\xff");
+  char buffer[16];
+  memset(buffer, '#', sizeof(buffer));
+  EXPECT_EQ(ba.writeHex(buffer, '-'), 8);
+  EXPECT_EQ(std::string(buffer, 9), "01-AB-FF#");
+  EXPECT_EQ(ba.hexSize('-'), 8);
+  EXPECT_EQ(Boron::ByteArray().toHex(':'), "");
+
+  uint8_t decoded[3];
+  EXPECT_EQ(Boron::ByteArray::decodeHex(Boron::ByteArray::fromStdString("01abFF"), decoded),
+            Boron::HexDecodingStatus::Ok);
+  EXPECT_EQ(Boron::ByteArray(decoded, 3), ba);
+}
+
+TEST(ByteArray, HexDecodingErrors)
+{
+  const auto odd = Boron::ByteArray::fromHexEncoding(Boron::ByteArray::fromStdString("abc"));
+  EXPECT_FALSE(odd);
+  EXPECT_EQ(odd.decodingStatus, Boron::HexDecodingStatus::IllegalLength);
+  EXPECT_EQ(odd.errorPosition, 3);
+
+  // Every position of a long input, so both the vector blocks and the tail
+  // report the first offending character.
+  const auto valid = std::string(100, 'a');
+  for (auto bad = 0_sz; bad < valid.size(); bad++)
+  {
+    for (const char c : {'g', 'G', '/', ':', '@', '`', '\0', '\xff'})
+    {
+      auto hex = Boron::ByteArray::fromStdString(valid);
+      hex[bad] = static_cast<uint8_t>(c);
+      if (bad + 1 < hex.size())
+        hex[bad + 1] = 'z';
+      const auto result = Boron::ByteArray::fromHexEncoding(hex);
+      ASSERT_FALSE(result) << bad;
+      EXPECT_EQ(result.decodingStatus, Boron::HexDecodingStatus::IllegalCharacter);
+      EXPECT_EQ(result.errorPosition, bad);
+      EXPECT_TRUE(result.decoded.isEmpty());
+    }
+  }
+  EXPECT_TRUE(Boron::ByteArray::fromHex("0x").isEmpty());
+
+  const auto ok = Boron::ByteArray::fromHexEncoding(Boron::ByteArray::fromStdString(valid));
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(ok.errorPosition, Boron::ByteArray::kNpos);
+  EXPECT_EQ(ok.decoded, Boron::ByteArray(50, 0xAA));
+}
+
+TEST(ByteArray, Hash)
+{
+  using Boron::ByteArray;
+  using Boron::ByteArrayView;
+
+  std::mt19937 rng(5);
+  std::vector<uint8_t> bytes(300);
+  for (auto& b : bytes)
+    b = static_cast<uint8_t>(rng());
+
+  // Every length takes a different path; no two prefixes or offsets collide,
+  // and the value depends only on the contents, not on the alignment.
+  std::unordered_set<size_t> seen;
+  for (size_t size = 0; size <= 200; size++)
+  {
+    const ByteArrayView view(bytes.data(), size);
+    const ByteArray copy(view.data(), view.size());
+    EXPECT_EQ(Boron::hash(view), Boron::hash(copy)) << size;
+    EXPECT_EQ(std::hash<ByteArrayView>()(view), std::hash<ByteArray>()(copy)) << size;
+    EXPECT_TRUE(seen.insert(Boron::hash(view)).second) << size;
+    if (size)
+    {
+      EXPECT_TRUE(seen.insert(Boron::hash(ByteArrayView(bytes.data() + 1, size))).second) << size;
+    }
+    EXPECT_NE(Boron::hash(view, 1), Boron::hash(view)) << size;
+  }
+
+  // Zero bytes count.
+  const uint8_t zeros[3] = {};
+  EXPECT_NE(Boron::hash(ByteArrayView(zeros, 1)), Boron::hash(ByteArrayView(zeros, 2)));
+  EXPECT_NE(Boron::hash(ByteArrayView(zeros, 0)), Boron::hash(ByteArrayView(zeros, 1)));
+  EXPECT_EQ(Boron::hash(ByteArray()), Boron::hash(ByteArrayView(zeros, 0)));
+
+  // Flipping any single bit changes the hash.
+  for (const size_t size : {3, 8, 16, 40, 100})
+  {
+    auto copy = bytes;
+    const auto original = Boron::hash(ByteArrayView(copy.data(), size));
+    for (size_t bit = 0; bit < 8 * size; bit++)
+    {
+      copy[bit / 8] ^= static_cast<uint8_t>(1 << bit % 8);
+      EXPECT_NE(Boron::hash(ByteArrayView(copy.data(), size)), original) << size << " " << bit;
+      copy[bit / 8] ^= static_cast<uint8_t>(1 << bit % 8);
+    }
+  }
+}
+
+TEST(ByteArray, HeterogeneousLookup)
+{
+  using Boron::ByteArray;
+  using Boron::ByteArrayView;
+
+  std::unordered_map<ByteArray, int, Boron::ByteArrayHash, Boron::ByteArrayEqual> map;
+  map.emplace(ByteArray::fromStdString("alpha"), 1);
+  map.emplace(ByteArray::fromStdString("beta"), 2);
+  map[ByteArray()] = 3;
+
+  const uint8_t buffer[] = "xxbetaxx";
+  const ByteArrayView view(buffer + 2, 4);
+  const auto it = map.find(view);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->second, 2);
+  EXPECT_FALSE(map.contains(ByteArrayView(buffer + 2, 2)));
+  EXPECT_EQ(map.count(ByteArrayView()), 1u);
+
+  // The std::hash specializations make the defaults work too.
+  std::unordered_set<ByteArray> set{ByteArray::fromStdString("a"), ByteArray::fromStdString("b")};
+  EXPECT_TRUE(set.contains(ByteArray::fromStdString("b")));
+
+  using Result = ByteArray::FromBase64Result;
+  EXPECT_EQ(Boron::hash(Result{ByteArray::fromStdString("x"), Boron::Base64DecodingStatus::Ok}),
+            Boron::hash(ByteArray::fromStdString("x")));
+  EXPECT_EQ(Boron::hash(Result{ByteArray::fromStdString("x"), Boron::Base64DecodingStatus::IllegalPadding}),
+            Boron::hash(Result{ByteArray(), Boron::Base64DecodingStatus::IllegalPadding}));
 }
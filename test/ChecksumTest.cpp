@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Checksum.hpp"
+
+using Boron::ByteArray;
+using Boron::ByteArrayView;
+
+namespace
+{
+  // Bit at a time references.
+  uint32_t referenceCrc(uint32_t reflected_polynomial, ByteArrayView data)
+  {
+    uint32_t crc = 0xFFFFFFFF;
+    for (const auto b : data)
+    {
+      crc ^= b;
+      for (int bit = 0; bit < 8; bit++)
+        crc = crc >> 1 ^ (crc & 1 ? reflected_polynomial : 0);
+    }
+    return ~crc;
+  }
+
+  uint32_t referenceAdler32(ByteArrayView data)
+  {
+    uint32_t s1 = 1;
+    uint32_t s2 = 0;
+    for (const auto b : data)
+    {
+      s1 = (s1 + b) % 65521;
+      s2 = (s2 + s1) % 65521;
+    }
+    return s2 << 16 | s1;
+  }
+
+  std::vector<uint8_t> randomBytes(size_t size, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(size);
+    for (auto& b : bytes)
+      b = static_cast<uint8_t>(rng());
+    return bytes;
+  }
+} // namespace
+
+TEST(Checksum, KnownValues)
+{
+  const auto check = ByteArray::fromStdString("123456789");
+  EXPECT_EQ(check.crc32(), 0xCBF43926u);
+  EXPECT_EQ(check.crc32c(), 0xE3069283u);
+  EXPECT_EQ(check.adler32(), 0x091E01DEu);
+  EXPECT_EQ(ByteArray::fromStdString("Wikipedia").adler32(), 0x11E60398u);
+
+  EXPECT_EQ(ByteArray().crc32(), 0u);
+  EXPECT_EQ(ByteArray().crc32c(), 0u);
+  EXPECT_EQ(ByteArray().adler32(), 1u);
+  // 32 bytes of zeros, from RFC 3720.
+  EXPECT_EQ(ByteArray(32, 0).crc32c(), 0x8A9136AAu);
+  EXPECT_EQ(ByteArray(32, 0xFF).crc32c(), 0x62A8AB43u);
+}
+
+TEST(Checksum, MatchesReference)
+{
+  // Every length around the block sizes of the kernels, at two alignments.
+  const auto bytes = randomBytes(1200, 1);
+  for (size_t offset = 0; offset < 2; offset++)
+  {
+    for (size_t size = 0; size + offset <= bytes.size(); size += size < 300 ? 1 : 97)
+    {
+      const ByteArrayView view(bytes.data() + offset, size);
+      EXPECT_EQ(view.crc32(), referenceCrc(0xEDB88320, view)) << size;
+      EXPECT_EQ(view.crc32c(), referenceCrc(0x82F63B78, view)) << size;
+      EXPECT_EQ(view.adler32(), referenceAdler32(view)) << size;
+    }
+  }
+
+  // Long runs of 0xFF push the Adler-32 sums closest to overflowing.
+  const ByteArray ones(100000, 0xFF);
+  EXPECT_EQ(ones.adler32(), referenceAdler32(ones));
+  const auto large = randomBytes(1 << 20, 2);
+  EXPECT_EQ(ByteArrayView(large).crc32(), referenceCrc(0xEDB88320, large));
+  EXPECT_EQ(ByteArrayView(large).adler32(), referenceAdler32(large));
+}
+
+TEST(Checksum, Incremental)
+{
+  const auto bytes = randomBytes(20000, 3);
+  const ByteArrayView whole(bytes);
+  std::mt19937 rng(4);
+  for (int round = 0; round < 20; round++)
+  {
+    Boron::Crc32 crc32;
+    Boron::Crc32c crc32c;
+    Boron::Adler32 adler32;
+    size_t pos = 0;
+    while (pos < bytes.size())
+    {
+      const auto n = std::min<size_t>(rng() % (round < 10 ? 100 : 8000), bytes.size() - pos);
+      const auto chunk = whole.sliced(pos, n);
+      crc32.update(chunk);
+      crc32c.update(chunk);
+      adler32.update(chunk);
+      pos += n;
+    }
+    EXPECT_EQ(crc32.value(), whole.crc32());
+    EXPECT_EQ(crc32c.value(), whole.crc32c());
+    EXPECT_EQ(adler32.value(), whole.adler32());
+  }
+
+  // Continuing from a previous value, and starting over.
+  const auto first = whole.sliced(0, 5000);
+  const auto rest = whole.sliced(5000, whole.size() - 5000);
+  EXPECT_EQ(Boron::Crc32(first.crc32()).update(rest).value(), whole.crc32());
+  EXPECT_EQ(Boron::Crc32c(first.crc32c()).update(rest).value(), whole.crc32c());
+  EXPECT_EQ(Boron::Adler32(first.adler32()).update(rest).value(), whole.adler32());
+
+  Boron::Crc32c crc;
+  crc.update(rest);
+  crc.reset();
+  EXPECT_EQ(crc.update(first).value(), first.crc32c());
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Compression.hpp"
+
+using Boron::ByteArray;
+using Boron::ByteArrayView;
+using Boron::UncompressStatus;
+
+namespace
+{
+  ByteArray randomBytes(size_t size, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    ByteArray result;
+    for (size_t i = 0; i < size; i++)
+      result.append(static_cast<uint8_t>(rng()));
+    return result;
+  }
+
+  // Words from a small vocabulary, which compresses about as well as text.
+  ByteArray wordySample(size_t size, uint32_t seed)
+  {
+    static const char* const kWords[] = {"block ", "cache ", "the ", "of ", "payload ", "compress ",
+                                         "frame ", "Boron ", "array ", "and ", "\n", "0123 "};
+    std::mt19937 rng(seed);
+    std::string text;
+    while (text.size() < size)
+      text += kWords[rng() % std::size(kWords)];
+    text.resize(size);
+    return ByteArray::fromStdString(text);
+  }
+} // namespace
+
+TEST(Compression, Empty)
+{
+  EXPECT_TRUE(Boron::compress(ByteArrayView()).isEmpty());
+  EXPECT_TRUE(Boron::uncompress(ByteArrayView()).isEmpty());
+  EXPECT_EQ(Boron::uncompressedSize(ByteArrayView()), 0u);
+}
+
+TEST(Compression, RoundTrip)
+{
+  // Sizes around the end-of-block rules of the format and the block size.
+  for (size_t size : {1, 4, 5, 12, 13, 14, 15, 16, 17, 64, 255, 270, 1000, 65536, 70000, 262143, 262144, 262145,
+                      600000})
+  {
+    for (const auto& data : {randomBytes(size, 1), wordySample(size, 2), ByteArray(size, 'x')})
+    {
+      const auto compressed = Boron::compress(data);
+      EXPECT_EQ(Boron::uncompressedSize(compressed), size);
+      EXPECT_EQ(Boron::uncompress(compressed), data) << size;
+    }
+  }
+}
+
+TEST(Compression, ShortPeriods)
+{
+  // Matches with offsets below eight overlap their own output.
+  for (size_t period = 1; period <= 9; period++)
+  {
+    ByteArray data;
+    for (size_t i = 0; i < 5000; i++)
+      data.append(static_cast<uint8_t>('a' + i % period));
+    const auto compressed = Boron::compress(data);
+    EXPECT_LT(compressed.size(), 100u) << period;
+    EXPECT_EQ(Boron::uncompress(compressed), data) << period;
+  }
+}
+
+TEST(Compression, Ratio)
+{
+  const auto text = wordySample(1 << 20, 3);
+  EXPECT_LT(Boron::compress(text).size(), text.size() / 2);
+
+  // Incompressible blocks are stored, with two or three bytes of header.
+  const auto noise = randomBytes(1 << 20, 4);
+  EXPECT_LE(Boron::compress(noise).size(), noise.size() + 4 * 6);
+}
+
+TEST(Compression, UncompressInto)
+{
+  const auto data = wordySample(100000, 5);
+  const auto compressed = Boron::compress(data);
+  ByteArray out;
+  out.reserve(200000);
+  out.append(ByteArrayView(data.constData(), 10));
+  const auto buffer = out.constData();
+  EXPECT_EQ(Boron::uncompress(compressed, out), UncompressStatus::Ok);
+  EXPECT_EQ(out, data);
+  EXPECT_EQ(out.constData(), buffer);
+
+  EXPECT_EQ(Boron::uncompress(ByteArrayView(compressed.constData(), compressed.size() - 1), out),
+            UncompressStatus::TruncatedData);
+  EXPECT_TRUE(out.isEmpty());
+}
+
+TEST(Compression, CorruptData)
+{
+  const auto compressed = Boron::compress(wordySample(5000, 6));
+  // A block size of zero, and one above the block size.
+  const uint8_t zero_block[] = {0x00, 0x01, 0x00};
+  EXPECT_EQ(Boron::uncompressedSize(ByteArrayView(zero_block, 3)), ByteArray::kNpos);
+  const uint8_t huge_block[] = {0x81, 0x80, 0x10, 0x00};
+  ByteArray out;
+  EXPECT_EQ(Boron::uncompress(ByteArrayView(huge_block, 4), out), UncompressStatus::CorruptData);
+
+  // Flipped bytes must be rejected or decode to something, never crash.
+  std::mt19937 rng(7);
+  for (int round = 0; round < 2000; round++)
+  {
+    auto damaged = compressed;
+    for (int i = 0; i < 3; i++)
+      damaged[rng() % damaged.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+    if (Boron::uncompress(damaged, out) != UncompressStatus::Ok)
+    {
+      EXPECT_TRUE(out.isEmpty());
+    }
+  }
+}
+
+TEST(Compression, Streaming)
+{
+  ByteArray data = wordySample(700000, 8);
+  data.append(randomBytes(50000, 9));
+  const auto expected = Boron::compress(data);
+  std::mt19937 rng(10);
+  for (int round = 0; round < 10; round++)
+  {
+    const size_t max_chunk = round < 5 ? 1000 : 400000;
+    Boron::Compressor compressor;
+    ByteArray compressed;
+    for (size_t pos = 0; pos < data.size();)
+    {
+      const auto n = std::min<size_t>(rng() % max_chunk, data.size() - pos);
+      compressor.feed(ByteArrayView(data.constData() + pos, n), compressed);
+      pos += n;
+    }
+    compressor.finish(compressed);
+    EXPECT_EQ(compressor.pendingSize(), 0u);
+    EXPECT_EQ(compressed, expected);
+
+    Boron::Decompressor decompressor;
+    ByteArray decompressed;
+    for (size_t pos = 0; pos < compressed.size();)
+    {
+      const auto n = std::min<size_t>(rng() % (round % 2 ? 7 : max_chunk), compressed.size() - pos);
+      EXPECT_EQ(decompressor.feed(ByteArrayView(compressed.constData() + pos, n), decompressed),
+                UncompressStatus::Ok);
+      pos += n;
+    }
+    EXPECT_EQ(decompressor.finish(), UncompressStatus::Ok);
+    EXPECT_EQ(decompressed, data);
+  }
+}
+
+TEST(Compression, StreamingErrors)
+{
+  const auto compressed = Boron::compress(wordySample(1000, 11));
+  Boron::Decompressor decompressor;
+  ByteArray out;
+  EXPECT_EQ(decompressor.feed(ByteArrayView(compressed.constData(), compressed.size() - 1), out),
+            UncompressStatus::Ok);
+  EXPECT_TRUE(out.isEmpty());
+  EXPECT_EQ(decompressor.finish(), UncompressStatus::TruncatedData);
+
+  decompressor.reset();
+  const uint8_t zero_block[] = {0x00};
+  EXPECT_EQ(decompressor.feed(ByteArrayView(zero_block, 1), out), UncompressStatus::CorruptData);
+  EXPECT_EQ(decompressor.feed(compressed, out), UncompressStatus::CorruptData);
+  EXPECT_TRUE(out.isEmpty());
+
+  decompressor.reset();
+  EXPECT_EQ(decompressor.feed(compressed, out), UncompressStatus::Ok);
+  EXPECT_EQ(decompressor.finish(), UncompressStatus::Ok);
+  EXPECT_EQ(out.size(), 1000u);
+}
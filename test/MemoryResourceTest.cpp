@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+#include "Boron/ByteArray.hpp"
+#include "TestHelpers.hpp"
+
+using Boron::Test::CountingResource;
+
+TEST(ByteArray, MemoryResource)
+{
+  CountingResource counting;
+  {
+    const Boron::ByteArray ba(Boron::ByteArray::fromStdString("a,bb,ccc"), &counting);
+    EXPECT_EQ(ba.resource(), &counting);
+    EXPECT_EQ(ba.toStdString(), "a,bb,ccc");
+    EXPECT_EQ(counting.allocations, 1);
+
+    // Even short results stay bound to the resource.
+    const auto parts = ba.split(',');
+    ASSERT_EQ(parts.size(), 3);
+    for (const auto& part : parts)
+      EXPECT_EQ(part.resource(), &counting);
+    EXPECT_EQ(parts[2].toStdString(), "ccc");
+    EXPECT_EQ(ba.repeated(3).resource(), &counting);
+    EXPECT_EQ(ba.sliced(2, 2).resource(), &counting);
+
+    // Detaching a slice reallocates from the same resource.
+    auto slice = ba.sliced(0, 4);
+    slice.append('!');
+    EXPECT_EQ(slice.resource(), &counting);
+    EXPECT_EQ(slice.toStdString(), "a,bb!");
+
+    const Boron::ByteArray rebound(slice, std::pmr::new_delete_resource());
+    EXPECT_EQ(rebound.resource(), std::pmr::new_delete_resource());
+    EXPECT_EQ(rebound, slice);
+  }
+  EXPECT_EQ(counting.live, 0);
+
+  EXPECT_EQ(Boron::ByteArray().resource(), std::pmr::new_delete_resource());
+  EXPECT_EQ(Boron::ByteArray(100, 'x').split('y')[0].resource(), std::pmr::new_delete_resource());
+}
+
+TEST(ByteArray, MonotonicBufferResource)
+{
+  std::byte buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+  Boron::ByteArray ba(&arena);
+  for (auto i = 0; i < 200; i++)
+    ba.append(static_cast<uint8_t>('a' + i % 26));
+  EXPECT_EQ(ba.size(), 200);
+  const auto fields = ba.split('z');
+  EXPECT_EQ(fields.size(), 8);
+  EXPECT_EQ(fields[0].size(), 25);
+  EXPECT_GE(fields[0].constData(), reinterpret_cast<const uint8_t*>(buffer));
+  EXPECT_LT(fields[0].constData(), reinterpret_cast<const uint8_t*>(buffer + sizeof(buffer)));
+}
+
+TEST(ByteArray, MemoryResourceIsNotPropagated)
+{
+  CountingResource counting;
+  {
+    // Binding alone allocates nothing, moving keeps the binding.
+    Boron::ByteArray bound(&counting);
+    EXPECT_EQ(counting.allocations, 0);
+    EXPECT_EQ(bound.resource(), &counting);
+    EXPECT_EQ(bound.sliced(0, 0).resource(), &counting);
+    auto moved = std::move(bound);
+    EXPECT_EQ(moved.resource(), &counting);
+    EXPECT_EQ(counting.allocations, 0);
+    moved.append(Boron::ByteArray::fromStdString("bound"));
+    EXPECT_EQ(counting.allocations, 1);
+  }
+  EXPECT_EQ(counting.live, 0);
+
+  Boron::ByteArray copy;
+  {
+    std::pmr::monotonic_buffer_resource arena;
+    const Boron::ByteArray bound(Boron::ByteArray::fromStdString("outlives the arena"), &arena);
+    copy = bound;
+    EXPECT_EQ(copy.resource(), std::pmr::new_delete_resource());
+    EXPECT_FALSE(copy.isSharedWith(bound));
+  }
+  EXPECT_EQ(copy.toStdString(), "outlives the arena");
+  EXPECT_EQ(Boron::ByteArray(copy).resource(), std::pmr::new_delete_resource());
+
+  {
+    // Assignment keeps the resource of the target and shares only within it.
+    const auto unbound = Boron::ByteArray::fromStdString("assigned from the global heap");
+    Boron::ByteArray target(&counting);
+    target = unbound;
+    EXPECT_EQ(target.resource(), &counting);
+    EXPECT_FALSE(target.isSharedWith(unbound));
+    EXPECT_EQ(target, unbound);
+
+    const Boron::ByteArray same(Boron::ByteArray::fromStdString("same resource"), &counting);
+    target = same;
+    EXPECT_TRUE(target.isSharedWith(same));
+
+    Boron::ByteArray source = Boron::ByteArray::fromStdString("moved across resources");
+    target = std::move(source);
+    EXPECT_EQ(target.resource(), &counting);
+    EXPECT_EQ(target.toStdString(), "moved across resources");
+
+    Boron::ByteArray other = unbound;
+    other = target;
+    EXPECT_EQ(other.resource(), std::pmr::new_delete_resource());
+    EXPECT_EQ(other, target);
+  }
+  EXPECT_EQ(counting.live, 0);
+}
+
+TEST(ByteArray, SimplifiedAndJustifiedKeepResource)
+{
+  CountingResource counting;
+  {
+    const Boron::ByteArray ba(Boron::ByteArray::fromStdString(" a  b " + std::string(40, 'c')), &counting);
+    EXPECT_EQ(ba.simplified().resource(), &counting);
+    EXPECT_EQ(ba.leftJustified(60).resource(), &counting);
+    EXPECT_EQ(ba.rightJustified(60).resource(), &counting);
+    auto own = ba.sliced(0);
+    own.detach();
+    EXPECT_EQ(std::move(own).simplified().resource(), &counting);
+  }
+  EXPECT_EQ(counting.live, 0);
+}
+
+TEST(ByteArray, ReplaceAllKeepsResource)
+{
+  CountingResource counting;
+  {
+    // Long enough to live on the heap, in place and through a new buffer.
+    Boron::ByteArray shrunk(Boron::ByteArray::fromStdString(std::string(40, 'a') + "{{x}}"), &counting);
+    shrunk.replace(Boron::ByteArray::fromStdString("{{x}}"), Boron::ByteArray::fromStdString("y"));
+    EXPECT_EQ(shrunk.toStdString(), std::string(40, 'a') + "y");
+    EXPECT_EQ(shrunk.resource(), &counting);
+
+    Boron::ByteArray grown(Boron::ByteArray::fromStdString(std::string(40, 'a') + "{{x}}"), &counting);
+    grown.replace(Boron::ByteArray::fromStdString("{{x}}"), Boron::ByteArray::fromStdString(std::string(30, 'y')));
+    EXPECT_EQ(grown.toStdString(), std::string(40, 'a') + std::string(30, 'y'));
+    EXPECT_EQ(grown.resource(), &counting);
+
+    const auto shared = grown;
+    grown.replace(Boron::ByteArray::fromStdString("yy"), Boron::ByteArray::fromStdString("z"));
+    EXPECT_EQ(grown.toStdString(), std::string(40, 'a') + std::string(15, 'z'));
+    EXPECT_EQ(grown.resource(), &counting);
+  }
+  EXPECT_EQ(counting.live, 0);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/MultiPatternMatcher.hpp"
+
+using Boron::MultiPatternMatcher;
+
+namespace
+{
+  std::vector<Boron::ByteArray> toByteArrays(const std::vector<std::string>& strings)
+  {
+    std::vector<Boron::ByteArray> result;
+    for (const auto& s : strings)
+      result.push_back(Boron::ByteArray::fromStdString(s));
+    return result;
+  }
+
+  std::vector<MultiPatternMatcher::Match> naiveFindAll(const std::string& haystack,
+                                                       const std::vector<std::string>& patterns)
+  {
+    std::vector<MultiPatternMatcher::Match> matches;
+    for (size_t id = 0; id < patterns.size(); id++)
+    {
+      if (patterns[id].empty())
+        continue;
+      for (auto pos = haystack.find(patterns[id]); pos != std::string::npos; pos = haystack.find(patterns[id], pos + 1))
+        matches.push_back({id, pos});
+    }
+    return matches;
+  }
+
+  void sortMatches(std::vector<MultiPatternMatcher::Match>& matches)
+  {
+    std::sort(matches.begin(), matches.end(), [](const auto& a, const auto& b)
+    {
+      return std::tie(a.offset, a.pattern) < std::tie(b.offset, b.pattern);
+    });
+  }
+} // namespace
+
+TEST(MultiPatternMatcher, ClassicExample)
+{
+  const std::vector<std::string> patterns = {"he", "she", "his", "hers"};
+  const MultiPatternMatcher matcher(toByteArrays(patterns));
+  const auto matches = matcher.findAll(Boron::ByteArray::fromStdString("ushers"));
+  // Ordered by end position, longest first.
+  const std::vector<MultiPatternMatcher::Match> expected = {{1, 1}, {0, 2}, {3, 2}};
+  EXPECT_EQ(matches, expected);
+  EXPECT_TRUE(matcher.containsAny(Boron::ByteArray::fromStdString("this")));
+  EXPECT_FALSE(matcher.containsAny(Boron::ByteArray::fromStdString("xyz")));
+}
+
+TEST(MultiPatternMatcher, AgainstNaive)
+{
+  std::string haystack;
+  for (auto i = 0; i < 5000; i++)
+    haystack.push_back("abcab\n"[(i * 31 + i / 5) % 6]);
+  std::vector<std::string> patterns = {"", "a", "ab", "abc", "bca", "cab", "b\nc", "aaa", "cabab", "zz", "ab"};
+  for (auto i = 0; i < 200; i++)
+    patterns.push_back(haystack.substr((i * 97) % 4900, 2 + i % 9));
+  const MultiPatternMatcher matcher(toByteArrays(patterns));
+  auto matches = matcher.findAll(Boron::ByteArray::fromStdString(haystack));
+  auto expected = naiveFindAll(haystack, patterns);
+  sortMatches(matches);
+  sortMatches(expected);
+  EXPECT_EQ(matches, expected);
+}
+
+TEST(MultiPatternMatcher, DenseTableOverflow)
+{
+  // Enough distinct bytes and states that most of the automaton is sparse.
+  std::vector<std::string> patterns;
+  for (auto i = 0; i < 3000; i++)
+  {
+    std::string p;
+    for (auto j = 0; j < 6; j++)
+      p.push_back(static_cast<char>((i * 7 + j * 13 + i / 11) & 0xFF));
+    patterns.push_back(p);
+  }
+  std::string haystack;
+  for (auto i = 0; i < 100; i++)
+    haystack += patterns[(i * 37) % patterns.size()] + patterns[i];
+  const MultiPatternMatcher matcher(toByteArrays(patterns));
+  EXPECT_GT(matcher.stateCount(), 1000);
+  auto matches = matcher.findAll(Boron::ByteArray::fromStdString(haystack));
+  auto expected = naiveFindAll(haystack, patterns);
+  sortMatches(matches);
+  sortMatches(expected);
+  EXPECT_EQ(matches, expected);
+}
+
+TEST(MultiPatternMatcher, Streaming)
+{
+  const std::vector<std::string> patterns = {"needle", "haystack", "le in"};
+  const MultiPatternMatcher matcher(toByteArrays(patterns));
+  const std::string text = "a needle in a haystack, another needle";
+  const auto whole = matcher.findAll(Boron::ByteArray::fromStdString(text));
+  for (size_t chunk = 1; chunk <= 7; chunk++)
+  {
+    MultiPatternMatcher::Stream stream(matcher);
+    std::vector<MultiPatternMatcher::Match> matches;
+    for (size_t pos = 0; pos < text.size(); pos += chunk)
+    {
+      stream.feed(Boron::ByteArray::fromStdString(text.substr(pos, chunk)),
+                  [&matches](const MultiPatternMatcher::Match& match) { matches.push_back(match); });
+    }
+    EXPECT_EQ(stream.position(), text.size());
+    EXPECT_EQ(matches, whole) << "chunk size " << chunk;
+  }
+}
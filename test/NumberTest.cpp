@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+
+using Boron::operator""_sz;
+
+TEST(ByteArrayView, ToInteger)
+{
+  const auto view = [](const char* text) { return Boron::ByteArrayView(reinterpret_cast<const uint8_t*>(text)); };
+  bool ok = false;
+  EXPECT_EQ(view("42").toInt(&ok), 42);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view(" \t-17\n").toInt(&ok), -17);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("+8").toInt(), 8);
+  EXPECT_EQ(view("ff").toInt(&ok, 16), 255);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("0xFF").toInt(&ok, 16), 255);
+  EXPECT_EQ(view("-0x10").toInt(&ok, 0), -16);
+  EXPECT_EQ(view("0b101").toInt(&ok, 0), 5);
+  EXPECT_EQ(view("017").toInt(&ok, 0), 15);
+  EXPECT_EQ(view("0").toInt(&ok, 0), 0);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("zz").toInt(&ok, 36), 35 * 36 + 35);
+  EXPECT_TRUE(ok);
+
+  for (const char* bad : {"", " ", "-", "+-1", "1 2", "12a", "0x", "1_000", "\xff"})
+  {
+    EXPECT_EQ(view(bad).toInt(&ok), 0) << bad;
+    EXPECT_FALSE(ok) << bad;
+  }
+  EXPECT_EQ(view("08").toInt(&ok, 0), 0);
+  EXPECT_FALSE(ok);
+  EXPECT_EQ(view("12").toInt(&ok, 1), 0);
+  EXPECT_FALSE(ok);
+  EXPECT_EQ(view("-1").toUInt(&ok), 0);
+  EXPECT_FALSE(ok);
+}
+
+TEST(ByteArrayView, ToIntegerLimits)
+{
+  const auto parse = [](const std::string& text, auto member) {
+    const auto ba = Boron::ByteArray::fromStdString(text);
+    bool ok = false;
+    const auto value = (Boron::ByteArrayView(ba).*member)(&ok, 10);
+    return ok ? std::optional<decltype(value)>(value) : std::nullopt;
+  };
+  EXPECT_EQ(parse("32767", &Boron::ByteArrayView::toShort), 32767);
+  EXPECT_EQ(parse("-32768", &Boron::ByteArrayView::toShort), -32768);
+  EXPECT_EQ(parse("32768", &Boron::ByteArrayView::toShort), std::nullopt);
+  EXPECT_EQ(parse("65535", &Boron::ByteArrayView::toUShort), 65535);
+  EXPECT_EQ(parse("65536", &Boron::ByteArrayView::toUShort), std::nullopt);
+  EXPECT_EQ(parse("-2147483648", &Boron::ByteArrayView::toInt), std::numeric_limits<int>::min());
+  EXPECT_EQ(parse("2147483648", &Boron::ByteArrayView::toInt), std::nullopt);
+  EXPECT_EQ(parse("4294967295", &Boron::ByteArrayView::toUInt), 4294967295u);
+  EXPECT_EQ(parse("9223372036854775807", &Boron::ByteArrayView::toLongLong),
+            std::numeric_limits<long long>::max());
+  EXPECT_EQ(parse("-9223372036854775808", &Boron::ByteArrayView::toLongLong),
+            std::numeric_limits<long long>::min());
+  EXPECT_EQ(parse("9223372036854775808", &Boron::ByteArrayView::toLongLong), std::nullopt);
+  EXPECT_EQ(parse("-9223372036854775809", &Boron::ByteArrayView::toLongLong), std::nullopt);
+  EXPECT_EQ(parse("18446744073709551615", &Boron::ByteArrayView::toULongLong),
+            std::numeric_limits<unsigned long long>::max());
+  EXPECT_EQ(parse("18446744073709551616", &Boron::ByteArrayView::toULongLong), std::nullopt);
+  EXPECT_EQ(parse("99999999999999999999", &Boron::ByteArrayView::toULongLong), std::nullopt);
+  // Leading zeros do not count towards overflow.
+  EXPECT_EQ(parse(std::string(40, '0') + "18446744073709551615", &Boron::ByteArrayView::toULongLong),
+            std::numeric_limits<unsigned long long>::max());
+
+  // Every length and every position of a bad digit, inside and after the
+  // eight-digit blocks.
+  std::string digits;
+  unsigned long long expected = 0;
+  for (int length = 1; length <= 19; length++)
+  {
+    digits += static_cast<char>('0' + length % 10);
+    expected = expected * 10 + length % 10;
+    EXPECT_EQ(parse(digits, &Boron::ByteArrayView::toULongLong), expected) << digits;
+    for (auto bad = 0_sz; bad < digits.size(); bad++)
+    {
+      for (const char c : {'/', ':', 'a', ' '})
+      {
+        auto text = digits;
+        text[bad] = c;
+        if (c == ' ' && (bad == 0 || bad + 1 == text.size()))
+          continue;
+        EXPECT_EQ(parse(text, &Boron::ByteArrayView::toULongLong), std::nullopt) << text;
+      }
+    }
+  }
+}
+
+TEST(ByteArrayView, ToFloatingPoint)
+{
+  const auto view = [](const char* text) { return Boron::ByteArrayView(reinterpret_cast<const uint8_t*>(text)); };
+  bool ok = false;
+  EXPECT_EQ(view("3.25").toDouble(&ok), 3.25);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view(" -1e3 ").toDouble(&ok), -1000.0);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("+.5").toDouble(&ok), 0.5);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("0.1").toDouble(), 0.1);
+  EXPECT_EQ(view("0.1").toFloat(&ok), 0.1f);
+  EXPECT_TRUE(ok);
+  EXPECT_TRUE(std::isinf(view("-inf").toDouble(&ok)));
+  EXPECT_TRUE(ok);
+  EXPECT_TRUE(std::isnan(view("nan").toDouble(&ok)));
+  EXPECT_TRUE(ok);
+
+  for (const char* bad : {"", "+", "1.5x", "1,5", "--1", "+-1", "0x10", "1e400"})
+  {
+    EXPECT_EQ(view(bad).toDouble(&ok), 0.0) << bad;
+    EXPECT_FALSE(ok) << bad;
+  }
+  EXPECT_EQ(view("1e50").toDouble(&ok), 1e50);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(view("1e50").toFloat(&ok), 0.0f);
+  EXPECT_FALSE(ok);
+
+  // Shortest round trips of normal doubles parse back exactly. Subnormals
+  // are left out: older C++ runtimes report them as out of range.
+  uint64_t bits = 0x3FF0000000000001;
+  for (int i = 0; i < 1000; i++)
+  {
+    bits = bits * 6364136223846793005 + 1442695040888963407;
+    const auto value = std::bit_cast<double>(bits >> 2 | 0x0010000000000000);
+    char buffer[32];
+    const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    const Boron::ByteArrayView text(reinterpret_cast<const uint8_t*>(buffer), end - buffer);
+    EXPECT_EQ(text.toDouble(&ok), value) << std::string(buffer, end);
+    EXPECT_TRUE(ok);
+  }
+}
+
+TEST(ByteArray, ToNumber)
+{
+  bool ok = false;
+  EXPECT_EQ(Boron::ByteArray::fromStdString("1234567890123").toLongLong(&ok), 1234567890123);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(Boron::ByteArray::fromStdString("-7").toShort(), -7);
+  EXPECT_EQ(Boron::ByteArray::fromStdString("777").toUInt(&ok, 8), 511u);
+  EXPECT_EQ(Boron::ByteArray::fromStdString("2.5").toFloat(), 2.5f);
+  EXPECT_EQ(Boron::ByteArray::fromStdString("2.5e-3").toDouble(), 2.5e-3);
+  EXPECT_EQ(Boron::ByteArray().toInt(&ok), 0);
+  EXPECT_FALSE(ok);
+}
+
+TEST(ByteArray, NumberInteger)
+{
+  EXPECT_EQ(Boron::ByteArray::number(0).toStdString(), "0");
+  EXPECT_EQ(Boron::ByteArray::number(-1).toStdString(), "-1");
+  EXPECT_EQ(Boron::ByteArray::number(255, 16).toStdString(), "ff");
+  EXPECT_EQ(Boron::ByteArray::number(-255, 16).toStdString(), "-ff");
+  EXPECT_EQ(Boron::ByteArray::number(5u, 2).toStdString(), "101");
+  EXPECT_EQ(Boron::ByteArray::number(35, 36).toStdString(), "z");
+  EXPECT_EQ(Boron::ByteArray::number(8, 8).toStdString(), "10");
+  EXPECT_EQ(Boron::ByteArray::number(std::numeric_limits<long long>::min()).toStdString(), "-9223372036854775808");
+  EXPECT_EQ(Boron::ByteArray::number(std::numeric_limits<unsigned long long>::max()).toStdString(),
+            "18446744073709551615");
+  EXPECT_EQ(Boron::ByteArray::number(std::numeric_limits<unsigned long long>::max(), 2).toStdString(),
+            std::string(64, '1'));
+  EXPECT_EQ(Boron::ByteArray::number(std::numeric_limits<short>::min(), 16).toStdString(), "-8000");
+
+  // Every digit count, either side of each power of ten.
+  uint64_t power = 1;
+  for (int digits = 1; digits <= 20; digits++)
+  {
+    for (const auto value : {power, power - 1, power + 1, power * 9 + 8})
+    {
+      EXPECT_EQ(Boron::ByteArray::number(value).toStdString(), std::to_string(value));
+      EXPECT_EQ(Boron::ByteArray::number(value, 7).toULongLong(nullptr, 7), value);
+    }
+    power *= 10;
+  }
+
+  Boron::ByteArray ba = Boron::ByteArray::fromStdString("stale");
+  EXPECT_EQ(ba.setNum(-42).toStdString(), "-42");
+  EXPECT_EQ(ba.setNum(uint8_t(200), 16).toStdString(), "c8");
+
+  for (const int base : {-10, 0, 1, 37, 100})
+  {
+    EXPECT_TRUE(Boron::ByteArray::number(42, base).isEmpty());
+    EXPECT_TRUE(ba.setNum(42, base).isEmpty());
+    EXPECT_EQ(ba.append('x').appendNumber(42, base).toStdString(), "x");
+  }
+}
+
+TEST(ByteArray, NumberFloatingPoint)
+{
+  const auto number = [](double n, char format = 'g', int precision = 6) {
+    return Boron::ByteArray::number(n, format, precision).toStdString();
+  };
+  EXPECT_EQ(number(1.5), "1.5");
+  EXPECT_EQ(number(1234567.0), "1.23457e+06");
+  EXPECT_EQ(number(0.0001), "0.0001");
+  EXPECT_EQ(number(0.1, 'f', 3), "0.100");
+  EXPECT_EQ(number(-2.5, 'e', 2), "-2.50e+00");
+  EXPECT_EQ(number(1e-10, 'E', 1), "1.0E-10");
+  EXPECT_EQ(number(1e20, 'G'), "1E+20");
+  EXPECT_EQ(number(std::numeric_limits<double>::infinity()), "inf");
+  EXPECT_EQ(number(-std::numeric_limits<double>::infinity(), 'G'), "-INF");
+
+  // Infinities keep their sign in every format; NaN never shows one.
+  const auto inf = std::numeric_limits<double>::infinity();
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  for (const char format : {'g', 'e', 'f'})
+  {
+    for (const int precision : {6, 0, Boron::ByteArray::kFloatingPointShortest})
+    {
+      EXPECT_EQ(number(inf, format, precision), "inf");
+      EXPECT_EQ(number(-inf, format, precision), "-inf");
+      EXPECT_EQ(number(nan, format, precision), "nan");
+      EXPECT_EQ(number(-nan, format, precision), "nan");
+    }
+  }
+  EXPECT_EQ(number(-nan, 'E'), "NAN");
+  EXPECT_EQ(number(-inf, 'E'), "-INF");
+  Boron::ByteArray single;
+  EXPECT_EQ(single.setNum(-std::numeric_limits<float>::quiet_NaN()).toStdString(), "nan");
+  EXPECT_EQ(single.setNum(-std::numeric_limits<float>::infinity(), 'f').toStdString(), "-inf");
+  EXPECT_EQ(number(0.1, 'g', Boron::ByteArray::kFloatingPointShortest), "0.1");
+  EXPECT_EQ(number(1e300, 'f', -1).size(), 301);
+  EXPECT_EQ(number(std::numeric_limits<double>::denorm_min(), 'f', -1).size(), 326);
+  EXPECT_EQ(number(std::numeric_limits<double>::max(), 'f', 2).size(), 312);
+
+  // The shortest form reads back exactly, for doubles and floats alike.
+  uint64_t bits = 0x3FF0000000000001;
+  for (int i = 0; i < 1000; i++)
+  {
+    bits = bits * 6364136223846793005 + 1442695040888963407;
+    const auto value = std::bit_cast<double>(bits >> 2 | 0x0010000000000000);
+    for (const char format : {'e', 'f', 'g'})
+    {
+      const auto text = Boron::ByteArray::number(value, format, Boron::ByteArray::kFloatingPointShortest);
+      EXPECT_EQ(text.toDouble(), value) << text.toStdString();
+    }
+    const auto single = static_cast<float>(value);
+    if (std::isfinite(single) && std::isnormal(single))
+    {
+      Boron::ByteArray ba;
+      ba.setNum(single, 'g', Boron::ByteArray::kFloatingPointShortest);
+      EXPECT_EQ(ba.toFloat(), single) << ba.toStdString();
+      EXPECT_LE(ba.size(), 15);
+    }
+  }
+}
+
+TEST(ByteArray, AppendNumber)
+{
+  Boron::ByteArray ba;
+  ba.reserve(1024);
+  const auto data = ba.constData();
+  for (int i = -50; i < 50; i++)
+  {
+    ba.appendNumber(i);
+    ba.append(',');
+  }
+  ba.appendNumber(0.25).append(',').appendNumber(1.0f / 3, 'f', 2);
+  EXPECT_EQ(ba.constData(), data);
+
+  std::string expected;
+  for (int i = -50; i < 50; i++)
+    expected += std::to_string(i) + ",";
+  EXPECT_EQ(ba.toStdString(), expected + "0.25,0.33");
+
+  // Copies are left alone.
+  const auto copy = ba;
+  ba.appendNumber(7);
+  EXPECT_EQ(copy.toStdString(), expected + "0.25,0.33");
+  EXPECT_EQ(ba.toStdString(), expected + "0.25,0.337");
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+#include "Boron/PercentEncoder.hpp"
+
+using Boron::PercentEncoder;
+using Boron::operator""_sz;
+
+namespace
+{
+  Boron::ByteArray fromString(const std::string& s)
+  {
+    return Boron::ByteArray::fromStdString(s);
+  }
+
+  std::string naiveEncode(const PercentEncoder& encoder, const Boron::ByteArray& input)
+  {
+    std::string result;
+    for (const auto c : input)
+    {
+      if (!encoder.escapes(c))
+      {
+        result += static_cast<char>(c);
+        continue;
+      }
+      char escape[4];
+      std::snprintf(escape, sizeof(escape), "%c%02X", encoder.percent(), c);
+      result += escape;
+    }
+    return result;
+  }
+} // namespace
+
+TEST(PercentEncoder, DefaultSet)
+{
+  const PercentEncoder encoder;
+  for (int c = 0; c < 256; c++)
+  {
+    const bool unreserved = std::isalnum(c) || c == '-' || c == '.' || c == '_' || c == '~';
+    EXPECT_EQ(encoder.escapes(static_cast<uint8_t>(c)), !unreserved) << c;
+  }
+  EXPECT_EQ(encoder.encode(fromString("a b/c~")), "a%20b%2Fc~");
+}
+
+TEST(PercentEncoder, ExcludeAndInclude)
+{
+  const PercentEncoder encoder(fromString("/ "), fromString("a~"));
+  EXPECT_FALSE(encoder.escapes('/'));
+  EXPECT_FALSE(encoder.escapes(' '));
+  EXPECT_TRUE(encoder.escapes('a'));
+  EXPECT_TRUE(encoder.escapes('~'));
+  EXPECT_TRUE(encoder.escapes('%'));
+  EXPECT_EQ(encoder.encode(fromString("a /b%")), "%61 /b%25");
+
+  // The percent character is escaped even when excluded.
+  const PercentEncoder custom(fromString("+"), {}, '+');
+  EXPECT_TRUE(custom.escapes('+'));
+  EXPECT_TRUE(custom.escapes('%'));
+  EXPECT_FALSE(custom.escapes('b'));
+  EXPECT_EQ(custom.encode(fromString("a+b c")), "a+2Bb+20c");
+}
+
+TEST(PercentEncoder, AgainstNaive)
+{
+  // Every byte value at every position of the vector blocks and the tails.
+  const PercentEncoder encoders[] = {
+    PercentEncoder(),
+    PercentEncoder(fromString("/?:@&=+$,")),
+    PercentEncoder({}, fromString("abcxyz\x80\xff")),
+  };
+  for (const auto& encoder : encoders)
+  {
+    for (auto size : {0_sz, 1_sz, 15_sz, 16_sz, 17_sz, 31_sz, 32_sz, 33_sz, 100_sz, 1000_sz})
+    {
+      for (int salt = 0; salt < 8; salt++)
+      {
+        Boron::ByteArray input;
+        for (auto i = 0_sz; i < size; i++)
+          input.append(static_cast<uint8_t>(i % 7 == 0 ? i * 131 + salt : 'a' + (i + salt) % 26));
+        const auto expected = naiveEncode(encoder, input);
+        EXPECT_EQ(encoder.encode(input), expected);
+        EXPECT_EQ(encoder.encodedSize(input), expected.size());
+      }
+    }
+  }
+}
+
+TEST(PercentEncoder, EncodeToBuffer)
+{
+  const PercentEncoder encoder;
+  char buffer[16];
+  std::fill(std::begin(buffer), std::end(buffer), '#');
+  EXPECT_EQ(encoder.encodeTo(fromString("x y"), buffer), 5);
+  EXPECT_EQ(std::string(buffer, 6), "x%20y#");
+  EXPECT_EQ(encoder.encodeTo({}, buffer), 0);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+
+TEST(ByteArray, PercentEncoding)
+{
+  const auto text = Boron::ByteArray::fromStdString("{a fishy string?}");
+  EXPECT_EQ(text.toPercentEncoding(), "%7Ba%20fishy%20string%3F%7D");
+  EXPECT_EQ(text.toPercentEncoding(Boron::ByteArray::fromStdString("{}"), Boron::ByteArray::fromStdString("s")),
+            "{a%20fi%73hy%20%73tring%3F}");
+  EXPECT_EQ(Boron::ByteArray::fromStdString("50%").toPercentEncoding({}, {}, '#'), "50#25");
+  EXPECT_EQ(Boron::ByteArray().toPercentEncoding(), "");
+
+  Boron::ByteArray binary;
+  for (int c = 0; c < 256; c++)
+    binary.append(static_cast<uint8_t>(c));
+  const auto encoded = Boron::ByteArray::fromStdString(binary.toPercentEncoding());
+  EXPECT_EQ(encoded.percentDecoded(), binary);
+  EXPECT_EQ(Boron::ByteArray::fromPercentEncoding(encoded), binary);
+}
+
+TEST(ByteArray, PercentDecoding)
+{
+  const auto decode = [](const std::string& encoded, uint8_t percent = '%') {
+    return Boron::ByteArray::fromStdString(encoded).percentDecoded(percent).toStdString();
+  };
+  EXPECT_EQ(decode("Qt%20is%20great%33"), "Qt is great3");
+  EXPECT_EQ(decode("%7b%7D"), "{}");
+  EXPECT_EQ(decode("plain"), "plain");
+  EXPECT_EQ(decode(""), "");
+  // Anything but two hex digits leaves the percent alone.
+  EXPECT_EQ(decode("100%"), "100%");
+  EXPECT_EQ(decode("%4"), "%4");
+  EXPECT_EQ(decode("%zz%41"), "%zzA");
+  EXPECT_EQ(decode("%%41"), "%A");
+  EXPECT_EQ(decode("a#20b%20", '#'), "a b%20");
+
+  std::pmr::monotonic_buffer_resource arena;
+  const Boron::ByteArray bound(Boron::ByteArray::fromStdString("a%20b"), &arena);
+  EXPECT_EQ(bound.percentDecoded().resource(), &arena);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/String.hpp"
+#include "Boron/Unicode.hpp"
+
+using Boron::ByteArray;
+using Boron::String;
+
+namespace
+{
+  // Random code points with the given share of ASCII, in percent.
+  std::u32string randomCodePoints(size_t count, int ascii_percent, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    std::u32string result;
+    while (result.size() < count)
+    {
+      char32_t cp;
+      if (static_cast<int>(rng() % 100) < ascii_percent)
+        cp = rng() % 0x80;
+      else
+      {
+        cp = 0x80 + rng() % (0x110000 - 0x80);
+        if (cp >= 0xD800 && cp <= 0xDFFF)
+          continue;
+      }
+      result.push_back(cp);
+    }
+    return result;
+  }
+
+  ByteArray toUtf8(std::u32string_view s)
+  {
+    ByteArray result;
+    result.resize_and_overwrite(Boron::utf8LengthOfUtf32(s), [&](uint8_t* out, size_t) {
+      return Boron::utf32ToUtf8(s, out).written;
+    });
+    return result;
+  }
+} // namespace
+
+TEST(String, Empty)
+{
+  const String s;
+  EXPECT_TRUE(s.isEmpty());
+  EXPECT_EQ(s.length(), 0u);
+  EXPECT_EQ(s.utf8Offset(0), 0u);
+  EXPECT_TRUE(s.mid(0).isEmpty());
+  EXPECT_EQ(s, ByteArray().toString());
+}
+
+TEST(String, IndexMatchesCodePoints)
+{
+  // Lengths around the index stride, and text from all ASCII to none.
+  for (int ascii : {0, 50, 90, 100})
+  {
+    for (size_t count : {1, 7, 63, 64, 65, 200, 1000})
+    {
+      const auto code_points = randomCodePoints(count, ascii, static_cast<uint32_t>(count * 7 + ascii));
+      const auto utf8 = toUtf8(code_points);
+      const auto s = utf8.toString();
+      ASSERT_EQ(s.length(), count);
+      size_t offset = 0;
+      for (size_t i = 0; i < count; i++)
+      {
+        EXPECT_EQ(s.at(i), code_points[i]) << i;
+        EXPECT_EQ(s.utf8Offset(i), offset) << i;
+        offset += toUtf8(code_points.substr(i, 1)).size();
+      }
+      EXPECT_EQ(s.utf8Offset(count), utf8.size());
+    }
+  }
+}
+
+TEST(String, Mid)
+{
+  const auto code_points = randomCodePoints(300, 30, 5);
+  const auto s = toUtf8(code_points).toString();
+  std::mt19937 rng(6);
+  for (int round = 0; round < 500; round++)
+  {
+    const size_t index = rng() % 320;
+    const size_t len = rng() % 200;
+    const auto expected = index >= code_points.size() ? std::u32string()
+                                                      : code_points.substr(index, len);
+    const auto part = s.mid(index, len);
+    EXPECT_EQ(part.utf8(), toUtf8(expected)) << index << ' ' << len;
+    EXPECT_EQ(part.length(), expected.size());
+    if (!expected.empty())
+    {
+      EXPECT_EQ(part.at(expected.size() - 1), expected.back());
+    }
+  }
+  EXPECT_EQ(s.mid(10), toUtf8(code_points.substr(10)).toString());
+  EXPECT_EQ(String(s).mid(290, 100), toUtf8(code_points.substr(290)).toString());
+}
+
+TEST(String, SharesBuffer)
+{
+  // Long enough to live on the heap.
+  auto bytes = toUtf8(randomCodePoints(100, 50, 7));
+  const auto data = bytes.constData();
+  String s(std::move(bytes));
+  EXPECT_EQ(s.utf8().constData(), data);
+
+  const String copy = s;
+  EXPECT_EQ(copy.utf8().constData(), data);
+  EXPECT_EQ(copy.length(), 100u);
+  const auto tail = s.mid(10);
+  EXPECT_GE(tail.utf8().constData(), data);
+  EXPECT_LT(tail.utf8().constData(), data + s.utf8().size());
+
+  auto back = std::move(s).utf8();
+  EXPECT_EQ(back.constData(), data);
+  EXPECT_TRUE(s.isEmpty());
+  EXPECT_EQ(std::move(back).toString().utf8().constData(), data);
+}
+
+TEST(String, ReplacesMalformed)
+{
+  const String s(ByteArray::fromStdString("a\xE2\x82z\xC0"));
+  EXPECT_EQ(s.utf8(), ByteArray::fromStdString("a\xEF\xBF\xBDz\xEF\xBF\xBD"));
+  EXPECT_EQ(s.length(), 4u);
+  EXPECT_EQ(s.at(1), U'\xFFFD');
+  EXPECT_TRUE(s.utf8().isValidUtf8());
+}
+
+TEST(String, ConversionsAndComparison)
+{
+  const auto s = String::fromStdString("gr\xC3\xBC\xC3\x9F \xF0\x9F\x98\x80");
+  EXPECT_EQ(s.length(), 6u);
+  EXPECT_EQ(s.at(5), U'\U0001F600');
+  EXPECT_EQ(s.toUtf16(), u"grüß \U0001F600");
+  EXPECT_EQ(String::fromUtf16(s.toUtf16()), s);
+  EXPECT_EQ(s.toStdString(), "gr\xC3\xBC\xC3\x9F \xF0\x9F\x98\x80");
+
+  auto joined = String::fromStdString("ab");
+  EXPECT_EQ(joined.length(), 2u);
+  joined += s;
+  EXPECT_EQ(joined.length(), 8u);
+  EXPECT_EQ(joined.at(7), U'\U0001F600');
+
+  // Code point order.
+  EXPECT_LT(String::fromStdString("\xEF\xBF\xBD"), String::fromStdString("\xF0\x90\x80\x80"));
+  std::unordered_set<String> set{s, joined};
+  EXPECT_TRUE(set.contains(String::fromStdString("ab") += s));
+}
+
+TEST(String, ConcurrentIndexing)
+{
+  const auto code_points = randomCodePoints(5000, 20, 8);
+  const auto s = toUtf8(code_points).toString();
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4);
+  for (size_t t = 0; t < mismatches.size(); t++)
+  {
+    threads.emplace_back([&, t] {
+      const auto copy = s;
+      for (size_t i = t; i < code_points.size(); i += 37)
+        mismatches[t] += copy.at(i) != code_points[i] || s.at(i) != code_points[i];
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  for (const auto m : mismatches)
+    EXPECT_EQ(m, 0);
+}
@@ -0,0 +1,62 @@
+#ifndef BORON_TEST_TESTHELPERS_HPP_
+#define BORON_TEST_TESTHELPERS_HPP_
+
+#include <memory_resource>
+#include <string>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Common.hpp"
+
+namespace Boron::Test
+{
+  // Forwards to the global heap and counts what passes through.
+  class CountingResource : public std::pmr::memory_resource
+  {
+  public:
+    size_t allocations = 0;
+    size_t live = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      ++allocations;
+      ++live;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      --live;
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+  };
+
+  // Straightforward bit-at-a-time encoder to check the vectorized one against.
+  inline std::string referenceBase64(const Boron::ByteArray& data, bool url, bool pad)
+  {
+    const std::string alphabet = std::string("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") +
+      (url ? "-_" : "+/");
+    std::string result;
+    uint32_t bits = 0;
+    int count = 0;
+    for (auto i = 0_sz; i < data.size(); i++)
+    {
+      bits = bits << 8 | data.at(i);
+      count += 8;
+      while (count >= 6)
+      {
+        count -= 6;
+        result += alphabet[bits >> count & 0x3F];
+      }
+    }
+    if (count)
+      result += alphabet[bits << (6 - count) & 0x3F];
+    while (pad && result.size() % 4)
+      result += '=';
+    return result;
+  }
+} // namespace Boron::Test
+
+#endif
@@ -0,0 +1,350 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Unicode.hpp"
+
+using Boron::ByteArray;
+using Boron::ByteArrayView;
+
+namespace
+{
+  ByteArray bytes(std::initializer_list<uint8_t> list)
+  {
+    ByteArray result;
+    for (const auto b : list)
+      result.append(b);
+    return result;
+  }
+
+  // Code point at a time reference for well-formedness, straight from Table
+  // 3-7 of the Unicode standard.
+  bool referenceIsValid(ByteArrayView data)
+  {
+    size_t i = 0;
+    while (i < data.size())
+    {
+      const auto b = data[i];
+      size_t n;
+      uint8_t lo = 0x80;
+      uint8_t hi = 0xBF;
+      if (b < 0x80)
+        n = 1;
+      else if (b >= 0xC2 && b <= 0xDF)
+        n = 2;
+      else if (b >= 0xE0 && b <= 0xEF)
+      {
+        n = 3;
+        lo = b == 0xE0 ? 0xA0 : 0x80;
+        hi = b == 0xED ? 0x9F : 0xBF;
+      }
+      else if (b >= 0xF0 && b <= 0xF4)
+      {
+        n = 4;
+        lo = b == 0xF0 ? 0x90 : 0x80;
+        hi = b == 0xF4 ? 0x8F : 0xBF;
+      }
+      else
+        return false;
+      if (i + n > data.size())
+        return false;
+      for (size_t k = 1; k < n; k++)
+      {
+        const auto c = data[i + k];
+        if (k == 1 ? c < lo || c > hi : c < 0x80 || c > 0xBF)
+          return false;
+      }
+      i += n;
+    }
+    return true;
+  }
+
+  // Random well-formed text with the given share of ASCII, in percent.
+  std::u32string randomCodePoints(size_t count, int ascii_percent, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    std::u32string result;
+    while (result.size() < count)
+    {
+      char32_t cp;
+      if (static_cast<int>(rng() % 100) < ascii_percent)
+        cp = rng() % 0x80;
+      else
+      {
+        switch (rng() % 3)
+        {
+        case 0:
+          cp = 0x80 + rng() % (0x800 - 0x80);
+          break;
+        case 1:
+          cp = 0x800 + rng() % (0x10000 - 0x800);
+          break;
+        default:
+          cp = 0x10000 + rng() % (0x110000 - 0x10000);
+          break;
+        }
+        if (cp >= 0xD800 && cp <= 0xDFFF)
+          continue;
+      }
+      result.push_back(cp);
+    }
+    return result;
+  }
+
+  ByteArray toUtf8(const std::u32string& s)
+  {
+    ByteArray result;
+    result.resize_and_overwrite(Boron::utf8LengthOfUtf32(s), [&](uint8_t* out, size_t) {
+      return Boron::utf32ToUtf8(s, out).written;
+    });
+    return result;
+  }
+
+  // Code point at a time reference for the encoders.
+  ByteArray referenceUtf8(const std::u32string& s)
+  {
+    ByteArray result;
+    for (const uint32_t c : s)
+    {
+      if (c < 0x80)
+        result.append(static_cast<uint8_t>(c));
+      else if (c < 0x800)
+        result.append(bytes({static_cast<uint8_t>(0xC0 | c >> 6), static_cast<uint8_t>(0x80 | (c & 0x3F))}));
+      else if (c < 0x10000)
+        result.append(bytes({static_cast<uint8_t>(0xE0 | c >> 12), static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F)),
+                             static_cast<uint8_t>(0x80 | (c & 0x3F))}));
+      else
+        result.append(bytes({static_cast<uint8_t>(0xF0 | c >> 18), static_cast<uint8_t>(0x80 | (c >> 12 & 0x3F)),
+                             static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F)), static_cast<uint8_t>(0x80 | (c & 0x3F))}));
+    }
+    return result;
+  }
+
+  std::u16string referenceUtf16(const std::u32string& s)
+  {
+    std::u16string result;
+    for (const auto c : s)
+    {
+      if (c < 0x10000)
+        result.push_back(static_cast<char16_t>(c));
+      else
+      {
+        result.push_back(static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10)));
+        result.push_back(static_cast<char16_t>(0xDC00 + (c & 0x3FF)));
+      }
+    }
+    return result;
+  }
+
+  // Random code points below limit, other than surrogates, with the given
+  // share of ASCII in percent.
+  std::u32string randomCodePointsBelow(size_t count, char32_t limit, int ascii_percent, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+    std::u32string result;
+    while (result.size() < count)
+    {
+      const char32_t cp = static_cast<int>(rng() % 100) < ascii_percent ? rng() % 0x80 : rng() % limit;
+      if (cp < 0xD800 || cp > 0xDFFF)
+        result.push_back(cp);
+    }
+    return result;
+  }
+} // namespace
+
+TEST(Unicode, IsValidUtf8)
+{
+  EXPECT_TRUE(ByteArray().isValidUtf8());
+  EXPECT_TRUE(ByteArray::fromStdString("plain ASCII").isValidUtf8());
+  EXPECT_TRUE(ByteArray::fromStdString("gr\xC3\xBC\xC3\x9F \xE2\x82\xAC \xF0\x9F\x98\x80").isValidUtf8());
+
+  // Overlong forms, surrogates, too large, stray and missing continuations.
+  for (const auto& bad : {bytes({0xC0, 0x80}), bytes({0xC1, 0xBF}), bytes({0xE0, 0x9F, 0xBF}),
+                          bytes({0xF0, 0x8F, 0xBF, 0xBF}), bytes({0xED, 0xA0, 0x80}), bytes({0xED, 0xBF, 0xBF}),
+                          bytes({0xF4, 0x90, 0x80, 0x80}), bytes({0xF5, 0x80, 0x80, 0x80}), bytes({0xFF}),
+                          bytes({0x80}), bytes({0xC3}), bytes({0xE2, 0x82}), bytes({0xF0, 0x9F, 0x98}),
+                          bytes({0xC3, 0xC3, 0xBC}), bytes({0xE2, 0x82, 0xAC, 0xAC})})
+  {
+    EXPECT_FALSE(bad.isValidUtf8()) << bad.toHex(' ');
+    // At every offset of a longer buffer, so that both SIMD blocks and the
+    // padded tail see the error, and followed by ASCII or nothing.
+    for (size_t offset = 0; offset < 140; offset += 7)
+    {
+      ByteArray padded(offset, 'a');
+      padded.append(bad);
+      EXPECT_FALSE(padded.isValidUtf8()) << offset << ' ' << bad.toHex(' ');
+      padded.append(100, 'b');
+      EXPECT_FALSE(padded.isValidUtf8()) << offset << ' ' << bad.toHex(' ');
+    }
+  }
+  EXPECT_TRUE(bytes({0xF4, 0x8F, 0xBF, 0xBF}).isValidUtf8());
+  EXPECT_TRUE(bytes({0xED, 0x9F, 0xBF}).isValidUtf8());
+}
+
+TEST(Unicode, IsValidUtf8MatchesReference)
+{
+  // Valid text with single bytes damaged, and random bytes from a small
+  // alphabet of interesting values.
+  std::mt19937 rng(1);
+  const auto valid = toUtf8(randomCodePoints(300, 50, 2));
+  EXPECT_TRUE(valid.isValidUtf8());
+  for (int round = 0; round < 3000; round++)
+  {
+    auto damaged = valid;
+    damaged[rng() % damaged.size()] = static_cast<uint8_t>(rng());
+    EXPECT_EQ(damaged.isValidUtf8(), referenceIsValid(damaged)) << damaged.toHex(' ');
+  }
+  static const uint8_t kAlphabet[] = {0x00, 0x41, 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0,
+                                      0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF};
+  for (int round = 0; round < 20000; round++)
+  {
+    ByteArray data;
+    const auto size = rng() % 80;
+    for (size_t i = 0; i < size; i++)
+      data.append(kAlphabet[rng() % std::size(kAlphabet)]);
+    EXPECT_EQ(data.isValidUtf8(), referenceIsValid(data)) << data.toHex(' ');
+  }
+}
+
+TEST(Unicode, RoundTrip)
+{
+  for (int ascii : {0, 50, 95, 100})
+  {
+    for (size_t count : {0, 1, 15, 16, 17, 100, 5000})
+    {
+      const auto text = randomCodePoints(count, ascii, static_cast<uint32_t>(count + ascii));
+      const auto utf8 = toUtf8(text);
+      EXPECT_TRUE(utf8.isValidUtf8());
+      EXPECT_EQ(Boron::utf32LengthOfUtf8(utf8), count);
+
+      std::u32string utf32(Boron::utf32LengthOfUtf8(utf8), U'\0');
+      const auto to32 = Boron::utf8ToUtf32(utf8, utf32.data());
+      EXPECT_TRUE(to32);
+      EXPECT_EQ(to32.written, count);
+      EXPECT_EQ(utf32, text);
+
+      std::u16string utf16(Boron::utf16LengthOfUtf8(utf8), u'\0');
+      const auto to16 = Boron::utf8ToUtf16(utf8, utf16.data());
+      EXPECT_TRUE(to16);
+      EXPECT_EQ(to16.written, utf16.size());
+      EXPECT_EQ(utf8.toUtf16(), utf16);
+      EXPECT_EQ(Boron::utf8LengthOfUtf16(utf16), utf8.size());
+      EXPECT_EQ(ByteArray::fromUtf16(utf16), utf8);
+    }
+  }
+  EXPECT_EQ(ByteArray::fromStdString("\xF0\x9F\x98\x80").toUtf16(), u"\U0001F600");
+}
+
+TEST(Unicode, Errors)
+{
+  std::u16string utf16(16, u'\0');
+  const auto bad = ByteArray::fromStdString("ab\xE2\x82x");
+  const auto result = Boron::utf8ToUtf16(bad, utf16.data());
+  EXPECT_FALSE(result);
+  EXPECT_EQ(result.written, 2u);
+  EXPECT_EQ(result.errorPosition, 2u);
+
+  // Past a long well-formed prefix, which the block conversion would take.
+  auto long_bad = toUtf8(randomCodePoints(200, 50, 3));
+  const auto prefix_units = Boron::utf16LengthOfUtf8(long_bad);
+  const auto prefix_size = long_bad.size();
+  long_bad.append(bytes({0xF0, 0x9F, 'x'}));
+  long_bad.append(ByteArray(100, 'y'));
+  std::u16string long_out(long_bad.size(), u'\0');
+  const auto long_result = Boron::utf8ToUtf16(long_bad, long_out.data());
+  EXPECT_EQ(long_result.written, prefix_units);
+  EXPECT_EQ(long_result.errorPosition, prefix_size);
+
+  uint8_t out[64];
+  const std::u16string unpaired = u"ab\xD800" u"c";
+  const auto from16 = Boron::utf16ToUtf8(unpaired, out);
+  EXPECT_EQ(from16.errorPosition, 2u);
+  EXPECT_EQ(from16.written, 2u);
+  EXPECT_EQ(Boron::utf16ToUtf8(std::u16string(1, u'\xDC00'), out).errorPosition, 0u);
+
+  const std::u32string too_large = {U'a', 0x110000};
+  EXPECT_EQ(Boron::utf32ToUtf8(too_large, out).errorPosition, 1u);
+  const std::u32string surrogate = {0xDFFF};
+  EXPECT_EQ(Boron::utf32ToUtf8(surrogate, out).errorPosition, 0u);
+}
+
+TEST(Unicode, FromWideMatchesReference)
+{
+  // Runs below U+0800, U+10000 and beyond take different block paths.
+  for (const uint32_t limit : {0x800u, 0x10000u, 0x110000u})
+  {
+    for (int ascii : {0, 50, 95})
+    {
+      for (size_t count : {1, 23, 24, 25, 300})
+      {
+        const auto text = randomCodePointsBelow(count, limit, ascii, static_cast<uint32_t>(limit + count + ascii));
+        const auto expected = referenceUtf8(text);
+        const auto utf16 = referenceUtf16(text);
+        ASSERT_EQ(Boron::utf8LengthOfUtf16(utf16), expected.size());
+
+        ByteArray out(expected.size(), '\0');
+        const auto from32 = Boron::utf32ToUtf8(text, out.data());
+        EXPECT_TRUE(from32);
+        EXPECT_EQ(from32.written, expected.size());
+        EXPECT_EQ(out, expected) << limit << ' ' << ascii << ' ' << count;
+
+        out.fill('\0');
+        const auto from16 = Boron::utf16ToUtf8(utf16, out.data());
+        EXPECT_TRUE(from16);
+        EXPECT_EQ(from16.written, expected.size());
+        EXPECT_EQ(out, expected) << limit << ' ' << ascii << ' ' << count;
+      }
+    }
+  }
+}
+
+TEST(Unicode, FromWideErrorsAfterBlocks)
+{
+  // At every offset of a long well-formed prefix, which the block
+  // conversions would take, and followed by more text.
+  const auto text = randomCodePointsBelow(100, 0x110000, 50, 9);
+  const auto tail = randomCodePointsBelow(40, 0x110000, 50, 10);
+  for (size_t offset = 0; offset <= text.size(); offset++)
+  {
+    const auto prefix = text.substr(0, offset);
+    const auto prefix_size = referenceUtf8(prefix).size();
+
+    for (const char32_t bad : {0xD800u, 0xDFFFu, 0x110000u, 0xFFFFFFFFu})
+    {
+      const auto utf32 = prefix + bad + tail;
+      ByteArray out(utf32.size() * 4, '\0');
+      const auto result = Boron::utf32ToUtf8(utf32, out.data());
+      EXPECT_EQ(result.errorPosition, offset) << offset;
+      EXPECT_EQ(result.written, prefix_size) << offset;
+      EXPECT_EQ(out.first(prefix_size), referenceUtf8(prefix)) << offset;
+    }
+
+    const auto prefix16 = referenceUtf16(prefix);
+    for (const auto& bad : {std::u16string(1, u'\xDC00'), std::u16string(1, u'\xD800'), std::u16string(2, u'\xD800')})
+    {
+      const auto utf16 = prefix16 + bad + referenceUtf16(tail);
+      ByteArray out(utf16.size() * 3, '\0');
+      const auto result = Boron::utf16ToUtf8(utf16, out.data());
+      EXPECT_EQ(result.errorPosition, prefix16.size()) << offset;
+      EXPECT_EQ(result.written, prefix_size) << offset;
+      EXPECT_EQ(out.first(prefix_size), referenceUtf8(prefix)) << offset;
+    }
+  }
+}
+
+TEST(Unicode, Replacement)
+{
+  // One U+FFFD per maximal subpart, as the Unicode standard recommends.
+  EXPECT_EQ(ByteArray::fromStdString("a\xE2\x82z").toUtf16(), u"a�z");
+  EXPECT_EQ(ByteArray::fromStdString("a\xC0\x80z").toUtf16(), u"a��z");
+  EXPECT_EQ(ByteArray::fromStdString("\xED\xA0\x80").toUtf16(), u"���");
+  EXPECT_EQ(ByteArray::fromStdString("\xF0\x9F\x98").toUtf16(), u"�");
+  EXPECT_EQ(ByteArray::fromStdString("\x80\x80").toUtf16(), u"��");
+
+  const std::u16string unpaired = u"x\xDC00y\xD800";
+  EXPECT_EQ(ByteArray::fromUtf16(unpaired), ByteArray::fromStdString("x\xEF\xBF\xBDy\xEF\xBF\xBD"));
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Boron/ByteArray.hpp"
+#include "Boron/Varint.hpp"
+
+using Boron::ByteArray;
+using Boron::ByteArrayView;
+
+namespace
+{
+  // Values of every encoded length, weighted towards the short ones.
+  std::vector<uint64_t> mixedValues(size_t count, uint64_t seed)
+  {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> values(count);
+    for (auto& value : values)
+    {
+      const auto bits = rng() % 4 ? rng() % 15 : rng() % 65;
+      value = bits == 64 ? rng() : rng() & ((uint64_t{1} << bits) - 1);
+    }
+    return values;
+  }
+
+  ByteArray encodeAll(const std::vector<uint64_t>& values)
+  {
+    ByteArray encoded;
+    for (const auto value : values)
+      encoded.appendVarint(value);
+    return encoded;
+  }
+} // namespace
+
+TEST(Varint, Encoding)
+{
+  const std::pair<uint64_t, const char*> cases[] = {
+    {0, "00"},
+    {1, "01"},
+    {127, "7F"},
+    {128, "8001"},
+    {300, "AC02"},
+    {16383, "FF7F"},
+    {16384, "808001"},
+    {std::numeric_limits<uint64_t>::max(), "FFFFFFFFFFFFFFFFFF01"},
+  };
+  for (const auto& [value, hex] : cases)
+  {
+    ByteArray encoded;
+    encoded.appendVarint(value);
+    EXPECT_EQ(encoded.toHex(), hex) << value;
+    EXPECT_EQ(encoded.size(), Boron::varintSize(value));
+    size_t consumed = 0;
+    EXPECT_EQ(encoded.toVarint(&consumed), value);
+    EXPECT_EQ(consumed, encoded.size());
+  }
+}
+
+TEST(Varint, ZigZag)
+{
+  static_assert(Boron::zigZagEncode(0) == 0);
+  static_assert(Boron::zigZagEncode(-1) == 1);
+  static_assert(Boron::zigZagEncode(1) == 2);
+  static_assert(Boron::zigZagEncode(-2) == 3);
+  static_assert(Boron::zigZagEncode(std::numeric_limits<int64_t>::max()) == std::numeric_limits<uint64_t>::max() - 1);
+  static_assert(Boron::zigZagEncode(std::numeric_limits<int64_t>::min()) == std::numeric_limits<uint64_t>::max());
+
+  for (const int64_t value : {int64_t{0}, int64_t{-1}, int64_t{63}, int64_t{-64}, int64_t{-65},
+                              std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()})
+  {
+    EXPECT_EQ(Boron::zigZagDecode(Boron::zigZagEncode(value)), value);
+    ByteArray encoded;
+    encoded.appendZigZagVarint(value);
+    EXPECT_EQ(encoded.toZigZagVarint(), value);
+  }
+  EXPECT_EQ(ByteArray().appendZigZagVarint(-64).toHex(), "7F");
+  EXPECT_EQ(ByteArray().appendZigZagVarint(64).toHex(), "8001");
+}
+
+TEST(Varint, Malformed)
+{
+  // Truncated, eleven bytes long, and bits past 64.
+  for (const auto* hex : {"", "80", "FFFF", "8080808080808080808000", "FFFFFFFFFFFFFFFFFF02"})
+  {
+    const auto encoded = ByteArray::fromHex(hex);
+    size_t consumed = 1;
+    EXPECT_EQ(encoded.toVarint(&consumed), 0u) << hex;
+    EXPECT_EQ(consumed, 0u) << hex;
+  }
+  // Padding is accepted and trailing bytes are ignored.
+  size_t consumed = 0;
+  EXPECT_EQ(ByteArray::fromHex("8100FF").toVarint(&consumed), 1u);
+  EXPECT_EQ(consumed, 2u);
+}
+
+TEST(Varint, DecodeVarints)
+{
+  for (const size_t count : {0, 1, 7, 8, 9, 31, 1000})
+  {
+    const auto values = mixedValues(count, count);
+    const auto encoded = encodeAll(values);
+    std::vector<uint64_t> decoded(count + 3, 0xDEAD);
+    const auto result = Boron::decodeVarints(encoded, decoded);
+    ASSERT_EQ(result.count, count);
+    EXPECT_EQ(result.consumed, encoded.size());
+    decoded.resize(count);
+    EXPECT_EQ(decoded, values);
+  }
+}
+
+TEST(Varint, DecodeVarintsShortValues)
+{
+  // One and two byte varints only, so that the table path takes every block.
+  std::mt19937_64 rng(7);
+  std::vector<uint64_t> values(4096);
+  for (auto& value : values)
+    value = rng() % 2 ? rng() % 128 : rng() % 16384;
+  const auto encoded = encodeAll(values);
+  std::vector<uint64_t> decoded(values.size());
+  const auto result = Boron::decodeVarints(encoded, decoded);
+  EXPECT_EQ(result.count, values.size());
+  EXPECT_EQ(result.consumed, encoded.size());
+  EXPECT_EQ(decoded, values);
+}
+
+TEST(Varint, DecodeVarintsStopsAtCapacity)
+{
+  const auto values = mixedValues(100, 3);
+  const auto encoded = encodeAll(values);
+  for (const size_t capacity : {0, 1, 8, 50, 99})
+  {
+    std::vector<uint64_t> decoded(capacity + 8, 0xDEAD);
+    const auto result = Boron::decodeVarints(encoded, std::span(decoded).first(capacity));
+    ASSERT_EQ(result.count, capacity);
+    EXPECT_EQ(result.consumed, encodeAll({values.begin(), values.begin() + capacity}).size());
+    for (size_t i = 0; i < capacity; i++)
+      EXPECT_EQ(decoded[i], values[i]);
+    // Nothing past the span is written.
+    for (size_t i = capacity; i < decoded.size(); i++)
+      EXPECT_EQ(decoded[i], 0xDEADu);
+  }
+}
+
+TEST(Varint, DecodeVarintsStopsAtMalformed)
+{
+  const auto values = mixedValues(200, 11);
+  for (const size_t bad : {0, 5, 100, 199})
+  {
+    const auto prefix = encodeAll({values.begin(), values.begin() + bad});
+    auto encoded = prefix;
+    encoded.append(ByteArray::fromHex("FFFFFFFFFFFFFFFFFF7F"));
+    encoded.append(encodeAll(values));
+    std::vector<uint64_t> decoded(values.size() * 2);
+    const auto result = Boron::decodeVarints(encoded, decoded);
+    EXPECT_EQ(result.count, bad);
+    EXPECT_EQ(result.consumed, prefix.size());
+  }
+
+  // A varint cut off by the end of the input.
+  auto truncated = encodeAll(values);
+  truncated.append(ByteArray::fromHex("8080"));
+  std::vector<uint64_t> decoded(values.size() + 1);
+  const auto result = Boron::decodeVarints(truncated, decoded);
+  EXPECT_EQ(result.count, values.size());
+  EXPECT_EQ(result.consumed, truncated.size() - 2);
+}